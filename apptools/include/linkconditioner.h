@@ -0,0 +1,122 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "random.hpp"
+#include "networkpump.h"
+
+// =================================================================================================
+// Simulated network link for testing on loopback. Datagrams submitted to the conditioner are lost,
+// delayed, reordered and rate limited according to a LinkProfile and handed to the socket once their
+// delivery time has come (Release()). NetworkPump puts it into its send path (SetConditioner()).
+// - latency and jitter: each packet is delayed by latency plus a uniformly distributed [0, jitter].
+//   Jitter alone doesn't reorder packets: a packet is never delivered before its predecessor.
+// - reorder: a packet is held back by another reorderDelay, so the following packets overtake it.
+// - bandwidth: packets are serialized onto the link at the given rate; when they arrive faster,
+//   they queue up (and are dropped when all capacity slots are in use, like in a router).
+// Packets are copied into preallocated slots, so submitting and releasing them doesn't allocate.
+// Random decisions come from a seeded RandomStream, so a run can be repeated exactly.
+// The conditioner is used by a single thread; only GetStatistics() may be called by others.
+
+struct LinkProfile {
+    float       latency{ 0.0f };        // ms
+    float       jitter{ 0.0f };         // ms
+    float       loss{ 0.0f };           // probability of a packet getting lost
+    float       reorder{ 0.0f };        // probability of a packet being held back
+    float       reorderDelay{ 5.0f };   // ms
+    float       bandwidth{ 0.0f };      // kbit/s; 0: unlimited
+    uint64_t    seed{ 1 };
+
+    inline bool IsIdeal(void) const noexcept {
+        return (latency <= 0.0f) and (jitter <= 0.0f) and (loss <= 0.0f) and (reorder <= 0.0f) and (bandwidth <= 0.0f);
+    }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class LinkConditioner {
+public:
+    static constexpr uint32_t defaultCapacity = 4096;
+
+    struct Statistics {
+        uint64_t    submitted;
+        uint64_t    lost;           // dropped by the loss probability
+        uint64_t    overflowed;     // dropped because all slots were in use
+        uint64_t    delivered;      // handed to the socket
+        uint64_t    reordered;      // held back to be overtaken
+        uint32_t    queued;         // waiting for their delivery time
+    };
+
+private:
+    struct Delivery {
+        int64_t     time;
+        uint32_t    sequence;       // submission order; breaks ties
+        uint32_t    slot;
+
+        // std heap functions build a max heap, so the earliest delivery must compare greatest
+        inline bool operator<(const Delivery& other) const noexcept {
+            return (time != other.time) ? (time > other.time) : (int32_t(sequence - other.sequence) > 0);
+        }
+    };
+
+    LinkProfile                         m_profile;
+    RandomStream                        m_random;
+    std::unique_ptr<NetworkPacket[]>    m_slots;
+    std::vector<uint32_t>               m_freeSlots;
+    std::vector<Delivery>               m_deliveries;   // heap
+    int64_t                             m_lastDelivery{ 0 }; // of the packets delivered in order
+    int64_t                             m_linkFree{ 0 };    // end of the last packet's serialization
+    uint32_t                            m_sequence{ 0 };
+
+    std::atomic<uint64_t>               m_submitted{ 0 };
+    std::atomic<uint64_t>               m_lost{ 0 };
+    std::atomic<uint64_t>               m_overflowed{ 0 };
+    std::atomic<uint64_t>               m_delivered{ 0 };
+    std::atomic<uint64_t>               m_reordered{ 0 };
+    std::atomic<uint32_t>               m_queued{ 0 };
+
+public:
+    explicit LinkConditioner(const LinkProfile& profile = LinkProfile(), uint32_t capacity = defaultCapacity);
+
+    LinkConditioner(const LinkConditioner&) = delete;
+    LinkConditioner& operator=(const LinkConditioner&) = delete;
+
+    // also restarts the random sequence from the profile's seed; queued packets keep their delivery times
+    void SetProfile(const LinkProfile& profile) noexcept;
+
+    inline const LinkProfile& Profile(void) const noexcept {
+        return m_profile;
+    }
+
+    // Copies the packet and schedules its delivery. now is Clock::Nanos(). Returns false if the
+    // packet was lost or there was no free slot.
+    bool Submit(const UDPData& packet, int64_t now) noexcept;
+
+    // Sends all packets due at now; returns the number of packets the socket accepted. When the
+    // socket's send buffer is full, the packets not sent stay queued for the next call.
+    int Release(int64_t now, UDPSocket& socket) noexcept;
+
+    // drops all queued packets and returns their number
+    uint32_t Discard(void) noexcept;
+
+    // delivery time of the next packet; INT64_MAX if none is queued
+    inline int64_t NextDelivery(void) const noexcept {
+        return m_deliveries.empty() ? INT64_MAX : m_deliveries.front().time;
+    }
+
+    inline uint32_t Queued(void) const noexcept {
+        return uint32_t(m_deliveries.size());
+    }
+
+    Statistics GetStatistics(void) const noexcept;
+
+private:
+    static inline int64_t Nanos(float ms) noexcept {
+        return int64_t(double(ms) * 1e6);
+    }
+};
+
+// =================================================================================================
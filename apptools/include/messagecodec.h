@@ -0,0 +1,329 @@
+#pragma once
+
+#include <stdint.h>
+#include <bit>
+#include <span>
+#include <cstring>
+#include <algorithm>
+#include <string_view>
+
+#include "vector.hpp"
+#include "stringutils.hpp"
+#include "networkendpoint.h"
+#include "udp.h"
+
+// =================================================================================================
+// Binary network messages. Layout, all integers little endian:
+//   uint8   magic (no text message starts with it)
+//   uint8   format version
+//   uint16  keyword id
+//   fields  in the order they were written, without tags or padding: the keyword id determines
+//           the layout
+// Field encodings: fixed width integers and floats, varints (LEB128, signed ones zigzag encoded),
+// strings as varint length + bytes, vectors as three floats or quantized to three int16.
+// MessageWriter writes into a caller supplied buffer, MessageReader reads straight from the received
+// datagram; neither allocates or throws. Both keep a sticky error flag instead of checking every call:
+// a write that doesn't fit or a read past the end (or of a malformed field) sets it, later calls
+// become no-ops (reads return 0), and IsValid() tells whether the message as a whole was good.
+//
+// Migration: MessageReader also accepts the text format ("KEYWORD#value;value;..."), mapping the
+// keyword to its id with MessageKeywords and parsing each Read...() from the next text value. So a
+// message handler written against MessageReader works for both formats while peers are updated.
+
+class MessageFormat {
+public:
+    static constexpr uint8_t magic = 0xB7;
+    static constexpr uint8_t version = 1;
+    static constexpr int headerSize = 4;
+    static constexpr float quantizationScale = 32767.0f;
+
+    static inline bool IsBinary(const uint8_t* data, int length) noexcept {
+        return (length >= headerSize) and (data[0] == magic);
+    }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Keyword ids of the text format's keywords. Register all keywords at startup, before messages are
+// decoded; keywords are not copied and must outlive the registry (i.e. be string literals).
+
+class MessageKeywords {
+public:
+    static bool Register(uint16_t id, std::string_view keyword);
+
+    // id of keyword; -1 if it isn't registered
+    static int32_t Find(std::string_view keyword) noexcept;
+
+    // keyword registered for id; empty if there is none
+    static std::string_view Name(uint16_t id) noexcept;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class MessageWriter {
+private:
+    uint8_t*    m_buffer;
+    int         m_capacity;
+    int         m_length{ 0 };
+    bool        m_overflow{ false };
+
+public:
+    MessageWriter(uint8_t* buffer, int capacity, uint16_t keywordId) noexcept
+        : m_buffer(buffer), m_capacity(capacity)
+    {
+        WriteU8(MessageFormat::magic);
+        WriteU8(MessageFormat::version);
+        WriteU16(keywordId);
+    }
+
+    MessageWriter(std::span<uint8_t> buffer, uint16_t keywordId) noexcept
+        : MessageWriter(buffer.data(), int(buffer.size()), keywordId)
+    { }
+
+    inline bool IsValid(void) const noexcept { return not m_overflow; }
+
+    inline int Length(void) const noexcept { return m_length; }
+
+    inline const uint8_t* Data(void) const noexcept { return m_buffer; }
+
+    // the message as a datagram to receiver, e.g. for UDPSocket::SendBatch(); empty if it overflowed
+    inline UDPData Packet(const NetworkEndpoint& receiver) const noexcept {
+        return m_overflow ? UDPData{ nullptr, 0 } : UDPData{ m_buffer, m_length, receiver.SocketAddress() };
+    }
+
+    inline void WriteU8(uint8_t v) noexcept {
+        if (uint8_t* p = Reserve(1))
+            *p = v;
+    }
+
+    inline void WriteBool(bool v) noexcept { WriteU8(v ? 1 : 0); }
+
+    inline void WriteU16(uint16_t v) noexcept { WriteFixed(v, 2); }
+
+    inline void WriteU32(uint32_t v) noexcept { WriteFixed(v, 4); }
+
+    inline void WriteU64(uint64_t v) noexcept { WriteFixed(v, 8); }
+
+    inline void WriteI32(int32_t v) noexcept { WriteFixed(uint32_t(v), 4); }
+
+    inline void WriteI64(int64_t v) noexcept { WriteFixed(uint64_t(v), 8); }
+
+    inline void WriteFloat(float v) noexcept {
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        WriteU32(bits);
+    }
+
+    inline void WriteVarUInt(uint64_t v) noexcept {
+        for (; v >= 0x80; v >>= 7)
+            WriteU8(uint8_t(v) | 0x80);
+        WriteU8(uint8_t(v));
+    }
+
+    inline void WriteVarInt(int64_t v) noexcept {
+        WriteVarUInt((uint64_t(v) << 1) ^ uint64_t(v >> 63));
+    }
+
+    inline void WriteString(std::string_view s) noexcept {
+        WriteVarUInt(s.size());
+        if (uint8_t* p = Reserve(int(s.size())))
+            std::memcpy(p, s.data(), s.size());
+    }
+
+    inline void WriteVector3f(const Vector3f& v) noexcept {
+        WriteFloat(v.X());
+        WriteFloat(v.Y());
+        WriteFloat(v.Z());
+    }
+
+    // components in [-range, range], 16 bits each (clamped)
+    inline void WriteQuantizedVector3f(const Vector3f& v, float range) noexcept {
+        WriteQuantized(v.X(), range);
+        WriteQuantized(v.Y(), range);
+        WriteQuantized(v.Z(), range);
+    }
+
+    inline void WriteQuantized(float v, float range) noexcept {
+        float q = std::clamp(v / range, -1.0f, 1.0f) * MessageFormat::quantizationScale;
+        WriteU16(uint16_t(int16_t((q < 0.0f) ? q - 0.5f : q + 0.5f)));
+    }
+
+    // host and port in network byte order
+    inline void WriteAddress(const IPaddress& address) noexcept {
+        if (uint8_t* p = Reserve(6)) {
+            std::memcpy(p, &address.host, 4);
+            std::memcpy(p + 4, &address.port, 2);
+        }
+    }
+
+    inline void WriteEndpoint(const NetworkEndpoint& endpoint) noexcept {
+        WriteAddress(endpoint.SocketAddress());
+    }
+
+private:
+    inline uint8_t* Reserve(int size) noexcept {
+        if (m_overflow or (size > m_capacity - m_length)) {
+            m_overflow = true;
+            return nullptr;
+        }
+        uint8_t* p = m_buffer + m_length;
+        m_length += size;
+        return p;
+    }
+
+    inline void WriteFixed(uint64_t v, int size) noexcept {
+        if (uint8_t* p = Reserve(size)) {
+            if constexpr (std::endian::native == std::endian::little)
+                std::memcpy(p, &v, size_t(size));
+            else {
+                for (int i = 0; i < size; ++i, v >>= 8)
+                    p[i] = uint8_t(v);
+            }
+        }
+    }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class MessageReader {
+private:
+    const uint8_t*  m_data;
+    int             m_length;
+    int             m_position{ 0 };
+    int32_t         m_keywordId{ -1 };
+    uint8_t         m_version{ 0 };
+    bool            m_isText{ false };
+    bool            m_error{ false };
+
+public:
+    MessageReader(const uint8_t* data, int length) noexcept;
+
+    explicit MessageReader(const UDPData& packet) noexcept
+        : MessageReader(packet.buffer, packet.length)
+    { }
+
+    // false if the header was invalid or a read failed
+    inline bool IsValid(void) const noexcept { return not m_error; }
+
+    inline bool IsText(void) const noexcept { return m_isText; }
+
+    // -1 for a text message with an unregistered keyword
+    inline int32_t KeywordId(void) const noexcept { return m_keywordId; }
+
+    inline uint8_t Version(void) const noexcept { return m_version; }
+
+    // true if all fields have been read
+    inline bool AtEnd(void) const noexcept { return m_position >= m_length; }
+
+    inline uint8_t ReadU8(void) noexcept {
+        if (m_isText)
+            return ReadNumber<uint8_t>();
+        const uint8_t* p = Consume(1);
+        return p ? *p : 0;
+    }
+
+    inline bool ReadBool(void) noexcept { return ReadU8() != 0; }
+
+    inline uint16_t ReadU16(void) noexcept { return m_isText ? ReadNumber<uint16_t>() : uint16_t(ReadFixed(2)); }
+
+    inline uint32_t ReadU32(void) noexcept { return m_isText ? ReadNumber<uint32_t>() : uint32_t(ReadFixed(4)); }
+
+    inline uint64_t ReadU64(void) noexcept { return m_isText ? ReadNumber<uint64_t>() : ReadFixed(8); }
+
+    inline int32_t ReadI32(void) noexcept { return m_isText ? ReadNumber<int32_t>() : int32_t(uint32_t(ReadFixed(4))); }
+
+    inline int64_t ReadI64(void) noexcept { return m_isText ? ReadNumber<int64_t>() : int64_t(ReadFixed(8)); }
+
+    inline float ReadFloat(void) noexcept {
+        if (m_isText)
+            return ReadNumber<float>();
+        uint32_t bits = uint32_t(ReadFixed(4));
+        float v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    inline uint64_t ReadVarUInt(void) noexcept {
+        if (m_isText)
+            return ReadNumber<uint64_t>();
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t* p = Consume(1);
+            if (not p)
+                return 0;
+            v |= uint64_t(*p & 0x7F) << shift;
+            if (not (*p & 0x80))
+                return v;
+        }
+        return Fail();
+    }
+
+    inline int64_t ReadVarInt(void) noexcept {
+        if (m_isText)
+            return ReadNumber<int64_t>();
+        uint64_t v = ReadVarUInt();
+        return int64_t(v >> 1) ^ -int64_t(v & 1);
+    }
+
+    // view into the message; valid as long as its buffer
+    std::string_view ReadString(void) noexcept;
+
+    Vector3f ReadVector3f(void) noexcept;
+
+    Vector3f ReadQuantizedVector3f(float range) noexcept;
+
+    inline float ReadQuantized(float range) noexcept {
+        if (m_isText)
+            return ReadNumber<float>();
+        return float(int16_t(ReadFixed(2))) * (range / MessageFormat::quantizationScale);
+    }
+
+    // a socket address as written by WriteAddress() / WriteEndpoint(); build a NetworkEndpoint from it
+    // where needed (which formats its address string)
+    IPaddress ReadAddress(void) noexcept;
+
+private:
+    inline uint64_t Fail(void) noexcept {
+        m_error = true;
+        m_position = m_length;
+        return 0;
+    }
+
+    inline const uint8_t* Consume(int size) noexcept {
+        if (size > m_length - m_position) {
+            Fail();
+            return nullptr;
+        }
+        const uint8_t* p = m_data + m_position;
+        m_position += size;
+        return p;
+    }
+
+    inline uint64_t ReadFixed(int size) noexcept {
+        const uint8_t* p = Consume(size);
+        if (not p)
+            return 0;
+        uint64_t v = 0;
+        if constexpr (std::endian::native == std::endian::little)
+            std::memcpy(&v, p, size_t(size));
+        else {
+            for (int i = size - 1; i >= 0; --i)
+                v = (v << 8) | p[i];
+        }
+        return v;
+    }
+
+    // the next value of a text message
+    std::string_view NextValue(void) noexcept;
+
+    // like NetworkMessage, takes an empty value as 0
+    template <typename T>
+    inline T ReadNumber(void) noexcept {
+        std::string_view s = StringUtils::Trim(NextValue());
+        T v{};
+        if (not s.empty() and not StringUtils::ParseNumber(s, v))
+            Fail();
+        return m_error ? T{} : v;
+    }
+};
+
+// =================================================================================================
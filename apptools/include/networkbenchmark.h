@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstdio>
+
+#include "linkconditioner.h"
+#include "networkpump.h"
+
+// =================================================================================================
+// Loopback benchmark of the networking stack. Run() opens peers UDP sockets on 127.0.0.1, each with
+// a NetworkPump whose send path goes through a LinkConditioner with the given link profile, and lets
+// every peer send rate messages per second to the next one for duration seconds. Messages carry a
+// sequence number and their send time, padded to payloadSize bytes; the codec under test encodes
+// them straight into the pump's send queue and decodes them from its receive queue.
+// Reported are the received message rate, encode and decode cost per message, the end-to-end latency
+// (send time to the receiving main thread handling the message) percentiles, messages lost or
+// reordered on the way and the heap allocations of all threads during the run. Allocations are
+// counted by Settings::countAllocations if it is set (e.g. by a counting global operator new, as the
+// networkbench program does), else by the SizeClassAllocator when the global operator new goes
+// through it (SIZE_CLASS_MALLOC 1); otherwise they are reported as -1.
+// To benchmark a new codec or batching change, pass a Codec with its encoder and decoder.
+
+class NetworkBenchmark {
+public:
+    // writes a message into buffer; returns its length, 0 if it doesn't fit
+    using Encoder = int (*)(uint8_t* buffer, int capacity, uint32_t sequence, int64_t sendTime, int payloadSize);
+
+    // parses a message; false if it is invalid
+    using Decoder = bool (*)(const uint8_t* data, int length, uint32_t& sequence, int64_t& sendTime);
+
+    struct Codec {
+        const char* name;
+        Encoder     encode;
+        Decoder     decode;
+    };
+
+    // returns the number of heap allocations made so far
+    using AllocationCounter = int64_t (*)(void);
+
+    struct Settings {
+        int         peers{ 4 };
+        int         rate{ 1000 };           // messages per second and peer
+        float       duration{ 5.0f };       // s
+        int         payloadSize{ 64 };      // padding bytes per message
+        LinkProfile link{};
+        uint32_t    queueSize{ NetworkPump::defaultQueueSize };
+        AllocationCounter countAllocations{ nullptr };
+    };
+
+    struct Result {
+        const char* codec;
+        int         peers;
+        uint64_t    sent;
+        uint64_t    received;
+        uint64_t    invalid;            // received, but rejected by the decoder
+        uint64_t    reordered;          // received after a message sent later
+        uint64_t    linkLost;           // lost or overflowed in the link conditioners
+        uint64_t    queueDropped;       // dropped by full pump queues
+        double      messagesPerSecond;  // received
+        double      encodeNanos;        // per message, including the send queue handoff (but not waking the pump)
+        double      decodeNanos;        // per message, including the receive queue handoff
+        float       latencyMean;        // us
+        float       latencyP50;
+        float       latencyP90;
+        float       latencyP99;
+        float       latencyMax;
+        int64_t     allocations;        // -1 if not counted
+    };
+
+    // NetworkMessage text format ("BENCH#sequence;time;padding"), parsed by NetworkMessage
+    static Codec TextCodec(void) noexcept;
+
+    // MessageWriter / MessageReader binary format
+    static Codec BinaryCodec(void) noexcept;
+
+    // Result::sent is 0 if the sockets or pumps can't be set up
+    static Result Run(const Settings& settings, const Codec& codec);
+
+    static void Print(const Result& result, FILE* stream = stdout);
+};
+
+// =================================================================================================
@@ -1,10 +1,13 @@
 #pragma once 
 
 #include <stdint.h>
+#include <string_view>
 
 #include "string.hpp"
 #include "list.hpp"
 #include "vector.hpp"
+#include "stringutils.hpp"
+#include "smallarray.hpp"
 #include "networkendpoint.h"
 
 // =================================================================================================
@@ -23,7 +26,7 @@ class NetworkMessage {
         port:
             udp port of the sender
         values:
-            List of single values #include "the payload
+            offsets and lengths of the single values in the payload
         numValues:
             Number of values
         result:
@@ -42,7 +45,18 @@ class NetworkMessage {
         int                  m_result{ -1 };
         bool                 m_isBroadcast{ false }; // used for sending this message as a broadcast in a LAN
         bool                 m_valueError{ false };
-        AutoArray<String>    m_values;
+        // values are located in the payload instead of being copied out of it, so splitting a message
+        // doesn't allocate a string per value. They are valid until the payload is changed; after that,
+        // values beyond the end of the new payload read as empty. Messages with up to maxInlineValues
+        // values don't allocate at all.
+        struct ValueRange {
+            uint32_t    offset;
+            uint32_t    length;
+        };
+
+        static constexpr int32_t maxInlineValues = 16;
+
+        SmallArray<ValueRange, maxInlineValues> m_values;
 
         NetworkMessage() 
             : m_numValues (0)
@@ -126,6 +140,17 @@ class NetworkMessage {
             m_isBroadcast = isBroadcast;
         }
 
+        // i-th parameter value as view into the payload; empty if there is no such value
+        inline std::string_view Value(int i) const noexcept {
+            if ((i < 0) or (i >= m_values.Length()))
+                return std::string_view();
+            const ValueRange& r = m_values[i];
+            // the payload may have been replaced through Payload() since IsValid() split it
+            if (size_t(r.offset) + r.length > size_t(m_payload.Length()))
+                return std::string_view();
+            return std::string_view(m_payload.Data() + r.offset, r.length);
+        }
+
         inline String ToStr(int i) {
             /*
             return i-th parameter value as text
@@ -134,122 +159,118 @@ class NetworkMessage {
             -----------
                 i: Index of the requested parameter
             */
-            try {
-                return m_values[i];
-            }
-            catch (...) {
-                return String("");
-            }
+            std::string_view v = Value(i);
+            return String(v.data(), v.size());
         }
 
 
-        inline bool InvalidDataError(const String caller, const String valueName, const String value) {
+        inline bool InvalidDataError(const char* caller, const char* valueName, std::string_view value) {
             m_valueError = true;
-            fprintf(stderr, "%s (%s): value '%s' out of range\n", (const char*) caller, (const char*) valueName, (const char*)value);
+            fprintf(stderr, "%s (%s): value '%.*s' out of range\n", caller, valueName, int(value.size()), value.data());
             return false;
         }
 
 
         template <typename T>
-        inline bool StringToNumber(T& v, String caller, String valueName, String value, T minVal = std::numeric_limits<T>::lowest(), T maxVal = std::numeric_limits<T>::max()) {
+        inline bool StringToNumber(T& v, const char* caller, const char* valueName, std::string_view value, T minVal = std::numeric_limits<T>::lowest(), T maxVal = std::numeric_limits<T>::max()) {
             /*
-            return i-th parameter value as int
-
-            Parameters:
-            -----------
-                i: Index of the requested parameter
+            convert a parameter value to a number in the range [minVal, maxVal]
+            an empty value is taken as 0
             */
             m_valueError = false;
-            try {
-                v = static_cast<T>(value);
-            }
-            catch (...) {
+            if (StringUtils::Trim(value).empty())
+                v = T(0);
+            else if (not StringUtils::ParseNumber(value, v))
                 return InvalidDataError(caller, valueName, value);
-            }
             T i = std::clamp<T>(v, minVal, maxVal);
             return (v == i) ? true : InvalidDataError(caller, valueName, value);
         }
 
-        inline bool IsValidIndex(const String& caller, const String& valueName, int valueIndex) {
-            if (valueIndex < m_values.Length())
+        template <typename T>
+        inline bool StringToNumber(T& v, const char* caller, const char* valueName, const String& value, T minVal = std::numeric_limits<T>::lowest(), T maxVal = std::numeric_limits<T>::max()) {
+            return StringToNumber<T>(v, caller, valueName, value.View(), minVal, maxVal);
+        }
+
+        inline bool IsValidIndex(const char* caller, const char* valueName, int valueIndex) {
+            if ((valueIndex >= 0) and (valueIndex < m_values.Length()))
                 return true;
             m_valueError = true;
-            fprintf(stderr, "%s (%s): invalid field index '%d'\n", (const char*)caller, (const char*)valueName, valueIndex);
+            fprintf(stderr, "%s (%s): invalid field index '%d'\n", caller, valueName, valueIndex);
             return false;
         }
 
 #pragma warning(push)
 #pragma warning(disable:4701) // unreferenced formal parameter
         template <typename T>
-        inline T StringToNumber(String caller, String valueName, String value, T minVal = std::numeric_limits<T>::lowest(), T maxVal = std::numeric_limits<T>::max()) {
+        inline T StringToNumber(const char* caller, const char* valueName, std::string_view value, T minVal = std::numeric_limits<T>::lowest(), T maxVal = std::numeric_limits<T>::max()) {
             T v;
             return StringToNumber(v, caller, valueName, value, minVal, maxVal) ? v : minVal;
         }
 
         template <typename T>
-        inline bool FieldToNumber(T& v, String caller, String valueName, int valueIndex, T minVal = std::numeric_limits<T>::lowest(), T maxVal = std::numeric_limits<T>::max()) {
-            return IsValidIndex(caller, valueName, valueIndex) ? StringToNumber<T>(v, caller, valueName, m_values[valueIndex], minVal, maxVal) : false;
+        inline bool FieldToNumber(T& v, const char* caller, const char* valueName, int valueIndex, T minVal = std::numeric_limits<T>::lowest(), T maxVal = std::numeric_limits<T>::max()) {
+            return IsValidIndex(caller, valueName, valueIndex) ? StringToNumber<T>(v, caller, valueName, Value(valueIndex), minVal, maxVal) : false;
         }
 
-        inline bool ToInt(int& v, String caller, String valueName, int valueIndex, int minVal = std::numeric_limits<int>::lowest(), int maxVal = std::numeric_limits<int>::max()) {
+        inline bool ToInt(int& v, const char* caller, const char* valueName, int valueIndex, int minVal = std::numeric_limits<int>::lowest(), int maxVal = std::numeric_limits<int>::max()) {
             return FieldToNumber<int>(v, caller, valueName, valueIndex, minVal, maxVal);
         }
 
-        inline bool ToUInt8(uint8_t& v, String caller, String valueName, int valueIndex, uint8_t minVal = std::numeric_limits<uint8_t>::lowest(), uint8_t maxVal = std::numeric_limits<uint8_t>::max()) {
+        inline bool ToUInt8(uint8_t& v, const char* caller, const char* valueName, int valueIndex, uint8_t minVal = std::numeric_limits<uint8_t>::lowest(), uint8_t maxVal = std::numeric_limits<uint8_t>::max()) {
             return FieldToNumber<uint8_t>(v, caller, valueName, valueIndex, minVal, maxVal);
         }
 
-        inline bool ToUInt16(uint16_t& v, String caller, String valueName, int valueIndex, uint16_t minVal = std::numeric_limits<uint16_t>::lowest(), uint16_t maxVal = std::numeric_limits<uint16_t>::max()) {
+        inline bool ToUInt16(uint16_t& v, const char* caller, const char* valueName, int valueIndex, uint16_t minVal = std::numeric_limits<uint16_t>::lowest(), uint16_t maxVal = std::numeric_limits<uint16_t>::max()) {
             return FieldToNumber<uint16_t>(v, caller, valueName, valueIndex, minVal, maxVal);
         }
 
-        inline bool ToUInt32(uint32_t& v, String caller, String valueName, int valueIndex, uint32_t minVal = std::numeric_limits<uint32_t> ::lowest(), uint32_t maxVal = std::numeric_limits<uint32_t>::max()) {
+        inline bool ToUInt32(uint32_t& v, const char* caller, const char* valueName, int valueIndex, uint32_t minVal = std::numeric_limits<uint32_t> ::lowest(), uint32_t maxVal = std::numeric_limits<uint32_t>::max()) {
             return FieldToNumber<uint32_t>(v, caller, valueName, valueIndex, minVal, maxVal);
         }
 
-        inline bool ToInt64(int64_t& v, String caller, String valueName, int valueIndex, int64_t minVal = std::numeric_limits<int64_t> ::lowest(), int64_t maxVal = std::numeric_limits<int64_t>::max()) {
+        inline bool ToInt64(int64_t& v, const char* caller, const char* valueName, int valueIndex, int64_t minVal = std::numeric_limits<int64_t> ::lowest(), int64_t maxVal = std::numeric_limits<int64_t>::max()) {
             return FieldToNumber<int64_t>(v, caller, valueName, valueIndex, minVal, maxVal);
         }
 
-        inline bool ToUInt64(uint64_t& v, String caller, String valueName, int valueIndex, uint64_t minVal = std::numeric_limits<uint64_t> ::lowest(), uint64_t maxVal = std::numeric_limits<uint64_t>::max()) {
+        inline bool ToUInt64(uint64_t& v, const char* caller, const char* valueName, int valueIndex, uint64_t minVal = std::numeric_limits<uint64_t> ::lowest(), uint64_t maxVal = std::numeric_limits<uint64_t>::max()) {
             return FieldToNumber<uint64_t>(v, caller, valueName, valueIndex, minVal, maxVal);
         }
 
-        inline bool ToFloat(float& v, String caller, String valueName, int valueIndex, float minVal = std::numeric_limits<float> ::lowest(), float maxVal = std::numeric_limits<float>::max()) {
+        inline bool ToFloat(float& v, const char* caller, const char* valueName, int valueIndex, float minVal = std::numeric_limits<float> ::lowest(), float maxVal = std::numeric_limits<float>::max()) {
             return FieldToNumber<float>(v, caller, valueName, valueIndex, minVal, maxVal);
         }
 
-        inline int ToInt(String caller, String valueName, int valueIndex, int minVal = std::numeric_limits<int>::lowest(), int maxVal = std::numeric_limits<int>::max()) {
+        inline int ToInt(const char* caller, const char* valueName, int valueIndex, int minVal = std::numeric_limits<int>::lowest(), int maxVal = std::numeric_limits<int>::max()) {
             int v;
             return FieldToNumber<int>(v, caller, valueName, valueIndex, minVal, maxVal) ? v : minVal;
         }
 
-        inline uint8_t ToUInt8(String caller, String valueName, int valueIndex, uint8_t minVal = std::numeric_limits<uint8_t>::lowest(), uint8_t maxVal = std::numeric_limits<uint8_t>::max()) {
+        inline uint8_t ToUInt8(const char* caller, const char* valueName, int valueIndex, uint8_t minVal = std::numeric_limits<uint8_t>::lowest(), uint8_t maxVal = std::numeric_limits<uint8_t>::max()) {
             uint8_t v;
             return FieldToNumber<uint8_t>(v, caller, valueName, valueIndex, minVal, maxVal) ? v : minVal;
         }
 
-        inline uint16_t ToUInt16(String caller, String valueName, int valueIndex, uint16_t minVal = std::numeric_limits<uint16_t>::lowest(), uint16_t maxVal = std::numeric_limits<uint16_t>::max()) {
+        inline uint16_t ToUInt16(const char* caller, const char* valueName, int valueIndex, uint16_t minVal = std::numeric_limits<uint16_t>::lowest(), uint16_t maxVal = std::numeric_limits<uint16_t>::max()) {
             uint16_t v;
             return FieldToNumber<uint16_t>(v, caller, valueName, valueIndex, minVal, maxVal) ? v : minVal;
         }
 
-        inline uint32_t ToUInt32(String caller, String valueName, int valueIndex, uint32_t minVal = std::numeric_limits<uint32_t> ::lowest(), uint32_t maxVal = std::numeric_limits<uint32_t>::max()) {
+        inline uint32_t ToUInt32(const char* caller, const char* valueName, int valueIndex, uint32_t minVal = std::numeric_limits<uint32_t> ::lowest(), uint32_t maxVal = std::numeric_limits<uint32_t>::max()) {
             uint32_t v;
             return FieldToNumber<uint32_t>(v, caller, valueName, valueIndex, minVal, maxVal) ? v : minVal;
         }
 
-        inline int64_t ToInt64(String caller, String valueName, int valueIndex, int64_t minVal = std::numeric_limits<int64_t> ::lowest(), int64_t maxVal = std::numeric_limits<int64_t>::max()) {
+        inline int64_t ToInt64(const char* caller, const char* valueName, int valueIndex, int64_t minVal = std::numeric_limits<int64_t> ::lowest(), int64_t maxVal = std::numeric_limits<int64_t>::max()) {
             int64_t v;
             return FieldToNumber<int64_t>(v, caller, valueName, valueIndex, minVal, maxVal) ? v : minVal;
         }
 
-        inline uint64_t ToUInt64(String caller, String valueName, int valueIndex, uint64_t minVal = std::numeric_limits<uint64_t> ::lowest(), uint64_t maxVal = std::numeric_limits<uint64_t>::max()) {
+        inline uint64_t ToUInt64(const char* caller, const char* valueName, int valueIndex, uint64_t minVal = std::numeric_limits<uint64_t> ::lowest(), uint64_t maxVal = std::numeric_limits<uint64_t>::max()) {
             uint64_t v;
             return FieldToNumber<uint64_t>(v, caller, valueName, valueIndex, minVal, maxVal) ? v : minVal;
         }
 
-        inline float ToFloat(String caller, String valueName, int valueIndex, float minVal = std::numeric_limits<float> ::lowest(), float maxVal = std::numeric_limits<float>::max()) {
+        inline float ToFloat(const char* caller, const char* valueName, int valueIndex, float minVal = std::numeric_limits<float> ::lowest(), float maxVal = std::numeric_limits<float>::max()) {
             float v;
             return FieldToNumber<float>(v, caller, valueName, valueIndex, minVal, maxVal) ? v : minVal;
         }
@@ -263,20 +284,20 @@ class NetworkMessage {
             i: Index of the requested parameter
         */
         // format: <x>,<y>,<z> (3 x float)
-        bool ToVector3f(Vector3f& v, String caller, String valueName, int valueIndex) noexcept;
+        bool ToVector3f(Vector3f& v, const char* caller, const char* valueName, int valueIndex) noexcept;
 
 
         // format: <ip v4 address>":"<port>
         // <ip address> = "//.//.//.//" (// = one to three digit subnet id)
-        bool ToNetworkEndpoint(String caller, String valueName, int valueIndex, NetworkEndpoint& address);
+        bool ToNetworkEndpoint(const char* caller, const char* valueName, int valueIndex, NetworkEndpoint& address);
 
         inline bool ValueError(void) noexcept {
             return m_valueError;
         }
 
-        const String& operator[](int32_t i) const noexcept {
-			static String emptyString("");
-            return ((i >= 0) and (i < m_values.Length())) ? m_values[i] : emptyString;
+        inline String operator[](int32_t i) const {
+            std::string_view v = Value(i);
+            return String(v.data(), v.size());
 		}
 };
 
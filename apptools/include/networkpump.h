@@ -0,0 +1,240 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <algorithm>
+
+#include "clock.h"
+#include "udp.h"
+
+// =================================================================================================
+// Network I/O on a dedicated thread, so receiving doesn't wait for the game loop's next poll and a
+// long frame doesn't let the kernel's socket buffer overflow.
+// While running, the pump owns the socket: its thread blocks in poll() until a datagram arrives or
+// packets are queued for sending, stamps received packets with their arrival time and moves them to
+// the receive queue. The main thread takes them from there and puts outgoing packets into the send
+// queue. Both queues are bounded single producer / single consumer rings of preallocated packets, so
+// neither thread ever waits for the other or allocates. When a queue is full, packets are dropped
+// and counted (see Statistics) rather than stalling the producer.
+// When the socket's send buffer is full, the pump leaves the remaining packets in the send queue and
+// waits until the socket is writable again, so kernel back-pressure shows as send queue depth (and,
+// once the queue is full, as sendDropped) instead of as lost packets.
+// Without native sockets (UDP_NATIVE_SOCKETS 0) the thread waits with SDLNet_CheckSockets() and
+// picks up queued packets at least every sdlPollTimeout ms.
+// A LinkConditioner can be put into the send path to simulate a real network link on loopback.
+
+struct NetworkPacket {
+    int64_t     timestamp;  // Clock nanoseconds: arrival time of received packets, queueing time of sent ones
+    IPaddress   address;    // sender of received packets, receiver of packets to send
+    int         length;
+    uint8_t     data[UDPSocket::MaxPacketSize];
+
+    inline UDPData Packet(void) noexcept {
+        return UDPData{ data, length, address };
+    }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Producer: fill the packet returned by Reserve() and publish it with Commit().
+// Consumer: process Peek(0) .. Peek(Available() - 1) and release them with Pop().
+
+class PacketQueue {
+private:
+    std::unique_ptr<NetworkPacket[]>    m_packets;
+    uint32_t                            m_mask{ 0 };
+    alignas(64) std::atomic<uint32_t>   m_head{ 0 };
+    uint32_t                            m_cachedTail{ 0 };  // producer's view of tail
+    alignas(64) std::atomic<uint32_t>   m_tail{ 0 };
+    uint32_t                            m_cachedHead{ 0 };  // consumer's view of head
+
+public:
+    // capacity is rounded up to a power of two; not thread safe
+    bool Create(uint32_t capacity);
+
+    inline uint32_t Capacity(void) const noexcept {
+        return m_packets ? m_mask + 1 : 0;
+    }
+
+    // number of queued packets; only a snapshot when called by a third thread
+    inline uint32_t Size(void) const noexcept {
+        uint32_t tail = m_tail.load(std::memory_order_acquire);
+        return m_head.load(std::memory_order_acquire) - tail;
+    }
+
+    inline bool IsEmpty(void) const noexcept {
+        return Size() == 0;
+    }
+
+    // producer: the next free packet; nullptr if the queue is full
+    inline NetworkPacket* Reserve(void) noexcept {
+        if (not m_packets)
+            return nullptr;
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail > m_mask) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail > m_mask)
+                return nullptr;
+        }
+        return &m_packets[head & m_mask];
+    }
+
+    inline void Commit(void) noexcept {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // consumer: number of packets ready for processing
+    inline uint32_t Available(void) noexcept {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        if (m_cachedHead == tail)
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+        return m_cachedHead - tail;
+    }
+
+    inline NetworkPacket& Peek(uint32_t i) noexcept {
+        return m_packets[(m_tail.load(std::memory_order_relaxed) + i) & m_mask];
+    }
+
+    inline void Pop(uint32_t count = 1) noexcept {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class LinkConditioner;
+
+class NetworkPump {
+public:
+    static constexpr uint32_t defaultQueueSize = 1024;
+    static constexpr int sdlPollTimeout = 1;
+    static constexpr int stopTimeout = 100;     // ms Stop() waits for a full send buffer to drain
+
+    struct Statistics {
+        uint64_t    received;           // packets moved to the receive queue
+        uint64_t    receiveDropped;     // received packets dropped because the receive queue was full
+        uint64_t    sent;               // packets the socket accepted (from the conditioner, if there is one)
+        uint64_t    sendDropped;        // packets not queued because the send queue was full
+        uint64_t    sendFailed;         // packets the socket refused with an error, or still queued after stopTimeout
+        uint32_t    receiveDepth;       // currently queued packets
+        uint32_t    sendDepth;
+        uint32_t    maxReceiveDepth;    // highest queue depth since Start()
+        uint32_t    maxSendDepth;
+    };
+
+private:
+    UDPSocket&              m_socket;
+    PacketQueue             m_receiveQueue;
+    PacketQueue             m_sendQueue;
+    std::thread             m_thread;
+    std::atomic<bool>       m_isRunning{ false };
+    std::atomic<bool>       m_isWaiting{ false };   // pump thread is (about to be) blocked in poll()
+    LinkConditioner*        m_conditioner{ nullptr };
+    bool                    m_isSendBlocked{ false };   // pump thread: the socket's send buffer is full
+#if UDP_NATIVE_SOCKETS
+    int                     m_wakeEvent{ -1 };      // eventfd interrupting poll()
+#else
+    SDLNet_SocketSet        m_socketSet{ nullptr };
+#endif
+
+    std::atomic<uint64_t>   m_received{ 0 };
+    std::atomic<uint64_t>   m_receiveDropped{ 0 };
+    std::atomic<uint64_t>   m_sent{ 0 };
+    std::atomic<uint64_t>   m_sendDropped{ 0 };
+    std::atomic<uint64_t>   m_sendFailed{ 0 };
+    std::atomic<uint32_t>   m_maxReceiveDepth{ 0 };
+    std::atomic<uint32_t>   m_maxSendDepth{ 0 };
+
+public:
+    explicit NetworkPump(UDPSocket& socket) noexcept
+        : m_socket(socket)
+    { }
+
+    NetworkPump(const NetworkPump&) = delete;
+    NetworkPump& operator=(const NetworkPump&) = delete;
+
+    ~NetworkPump() {
+        Stop();
+    }
+
+    // Starts the pump thread. The socket must be open, and nothing but the pump may use it until Stop().
+    bool Start(uint32_t receiveQueueSize = defaultQueueSize, uint32_t sendQueueSize = defaultQueueSize);
+
+    // Sends the packets still queued, including those a conditioner still delays, and ends the pump
+    // thread; received packets stay queued. If the socket's send buffer stays full for stopTimeout
+    // ms, the packets left count as failed.
+    void Stop(void);
+
+    inline bool IsRunning(void) const noexcept {
+        return m_isRunning.load(std::memory_order_relaxed);
+    }
+
+    // Passes sent packets through conditioner (nullptr: none). Only while the pump is stopped; the
+    // pump thread uses the conditioner exclusively while running.
+    inline bool SetConditioner(LinkConditioner* conditioner) noexcept {
+        if (IsRunning())
+            return false;
+        m_conditioner = conditioner;
+        return true;
+    }
+
+    // Main thread: hands the received packets to handler(const NetworkPacket&) in arrival order and
+    // releases them afterwards. Returns their number.
+    template <typename HANDLER_T>
+    inline int Receive(HANDLER_T&& handler, uint32_t maxCount = UINT32_MAX) {
+        uint32_t n = std::min(m_receiveQueue.Available(), maxCount);
+        for (uint32_t i = 0; i < n; ++i)
+            handler(static_cast<const NetworkPacket&>(m_receiveQueue.Peek(i)));
+        if (n)
+            m_receiveQueue.Pop(n);
+        return int(n);
+    }
+
+    // Main thread: a packet to fill with data, length and receiver address and queue with
+    // CommitSend(). nullptr if the send queue is full (the packet counts as dropped).
+    NetworkPacket* ReserveSend(void) noexcept;
+
+    // Queues the reserved packet. Pass wake = false while queueing a burst of packets and call Flush()
+    // after the last one to save waking the pump thread for each of them.
+    void CommitSend(bool wake = true) noexcept;
+
+    // copies the packet into the send queue; false if it is full or the packet too long
+    bool Send(const uint8_t* data, int length, const IPaddress& receiver, bool wake = true) noexcept;
+
+    inline bool Send(const UDPData& packet, bool wake = true) noexcept {
+        return Send(packet.buffer, packet.length, packet.address, wake);
+    }
+
+    // wakes the pump thread if it is waiting, so it sends the queued packets
+    void Flush(void) noexcept;
+
+    Statistics GetStatistics(void) const noexcept;
+
+private:
+    void Run(void);
+
+    // returns the number of packets received; UDPSocket::MaxBatchSize if more may be pending
+    int ReceivePackets(void);
+
+    // Sends queued packets until the queue is empty or the socket's send buffer is full. isFlushing:
+    // release all of the conditioner's packets, whether they are due or not.
+    void SendPackets(bool isFlushing = false);
+
+    // at the end of Run(): sends the packets still queued, waiting up to stopTimeout ms for the socket
+    void Drain(void);
+
+    void WaitForTraffic(void);
+
+    // false if the socket didn't become writable before deadline (Clock nanoseconds)
+    bool WaitWritable(int64_t deadline);
+
+    void Wake(void) noexcept;
+
+    static inline void UpdateMaximum(std::atomic<uint32_t>& maximum, uint32_t value) noexcept {
+        if (value > maximum.load(std::memory_order_relaxed))    // single writer
+            maximum.store(value, std::memory_order_relaxed);
+    }
+};
+
+// =================================================================================================
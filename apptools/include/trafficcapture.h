@@ -0,0 +1,176 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstdio>
+#include <mutex>
+#include <atomic>
+#include <span>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include "clock.h"
+#include "hiressleep.h"
+#include "profiler.h"
+#include "udp.h"
+
+// =================================================================================================
+// Capture and replay of network traffic. A TrafficRecorder attached to a UDPSocket
+// (UDPSocket::SetRecorder()) writes every datagram the socket receives or sends to a capture file;
+// a TrafficReplayer reads the file and hands the datagrams to a message handler again, either at
+// their original timing or as fast as possible. So traffic from a real session can be replayed to
+// benchmark or profile message handling reproducibly, without a live session.
+// Capture file layout, integers little endian:
+//   header: "TCAP", uint32 version, int64 capture start (seconds since the epoch)
+//   record: varint time since the previous record (ns), uint8 flags (bit 0: sent),
+//           uint32 remote host, uint16 remote port (both network byte order, as in IPaddress),
+//           uint16 local port, varint payload length, payload
+
+struct TrafficRecord {
+    int64_t         time;       // ns since the capture started
+    IPaddress       address;    // sender of received datagrams, receiver of sent ones
+    uint16_t        localPort;
+    bool            isSent;
+    const uint8_t*  data;
+    int             length;
+};
+
+// -------------------------------------------------------------------------------------------------
+// Records are collected in a buffer of bufferSize bytes, so usually a socket's thread only takes the
+// recorder's lock and copies the datagram. The Record() call that fills the buffer writes it to the
+// file under the lock, blocking that thread and any other socket recording meanwhile for the duration
+// of the write. Several sockets may share a recorder.
+
+class TrafficRecorder {
+public:
+    static constexpr uint32_t magic = 0x50414354;  // "TCAP"
+    static constexpr uint32_t version = 1;
+    static constexpr size_t headerSize = 16;
+    static constexpr size_t bufferSize = 256 * 1024;
+
+private:
+    std::mutex              m_lock;
+    FILE*                   m_file{ nullptr };
+    std::vector<uint8_t>    m_buffer;
+    int64_t                 m_lastTime{ 0 };
+    std::atomic<uint64_t>   m_records{ 0 };
+    bool                    m_hasFailed{ false };
+
+public:
+    TrafficRecorder() = default;
+
+    TrafficRecorder(const TrafficRecorder&) = delete;
+    TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+    ~TrafficRecorder() {
+        Close();
+    }
+
+    bool Open(const char* filename);
+
+    // writes the buffered records; false if writing failed at any time
+    bool Close(void);
+
+    inline bool IsOpen(void) const noexcept {
+        return m_file != nullptr;
+    }
+
+    inline uint64_t Records(void) const noexcept {
+        return m_records.load(std::memory_order_relaxed);
+    }
+
+    // records the datagrams a socket on localPort has received or sent
+    void Record(std::span<const UDPData> packets, uint16_t localPort, bool isSent);
+
+    inline void Record(const UDPData& packet, uint16_t localPort, bool isSent) {
+        Record(std::span<const UDPData>(&packet, 1), localPort, isSent);
+    }
+
+private:
+    bool Flush(void);
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class TrafficReplayer {
+public:
+    enum class Timing {
+        Original,   // wait for each datagram's original time
+        Fast        // as fast as possible
+    };
+
+    struct Statistics {
+        uint64_t    messages;
+        uint64_t    bytes;
+        int64_t     duration;           // ns
+        double      messagesPerSecond;
+        float       meanHandling;       // us spent in the handler per message
+        float       p99Handling;
+        float       maxHandling;
+        int64_t     slowestTime;        // capture time (ns) of the message that took longest
+    };
+
+private:
+    std::vector<uint8_t>    m_data;
+    int64_t                 m_captureStart{ 0 };
+    uint64_t                m_records{ 0 };
+
+public:
+    // reads the whole capture into memory, so replaying doesn't wait for the disk
+    bool Open(const char* filename);
+
+    inline uint64_t Records(void) const noexcept {
+        return m_records;
+    }
+
+    // seconds since the epoch
+    inline int64_t CaptureStart(void) const noexcept {
+        return m_captureStart;
+    }
+
+    // Hands the received (or sent) datagrams to handler(const TrafficRecord&) in capture order. Each
+    // call is a profiler zone, so handling spikes show up in profiler traces.
+    template <typename HANDLER_T>
+    Statistics Replay(HANDLER_T&& handler, Timing timing = Timing::Fast, bool sent = false) {
+        std::vector<int32_t> handlingTimes;
+        handlingTimes.reserve(size_t(m_records));
+        Statistics stats{};
+        int64_t start = Clock::Nanos();
+        int64_t slowest = -1;
+        TrafficRecord record;
+        for (size_t position = TrafficRecorder::headerSize; Next(position, record); ) {
+            if (record.isSent != sent)
+                continue;
+            if (timing == Timing::Original)
+                hiresSleep.SleepTo((start + record.time) / 1000);
+            int64_t t0 = Clock::Nanos();
+            {
+                ProfileZone zone("ReplayMessage");
+                handler(static_cast<const TrafficRecord&>(record));
+            }
+            int64_t t = Clock::Nanos() - t0;
+            if (t > slowest) {
+                slowest = t;
+                stats.slowestTime = record.time;
+            }
+            handlingTimes.push_back(int32_t(std::min(t, int64_t(INT32_MAX))));
+            stats.bytes += uint64_t(record.length);
+        }
+        stats.duration = Clock::Nanos() - start;
+        Summarize(handlingTimes, stats);
+        return stats;
+    }
+
+    // Replays the received datagrams as NetworkMessages, the way UDPSocket::Receive(NetworkMessage&)
+    // delivers them.
+    Statistics ReplayMessages(const std::function<void(NetworkMessage&)>& dispatch, Timing timing = Timing::Fast);
+
+private:
+    // decodes the record at position and advances it; false at the end of the capture or if the
+    // record is truncated
+    bool Next(size_t& position, TrafficRecord& record) const noexcept;
+
+    static void Summarize(std::vector<int32_t>& handlingTimes, Statistics& stats) noexcept;
+};
+
+// =================================================================================================
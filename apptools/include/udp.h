@@ -1,6 +1,7 @@
 #pragma once 
 
 #include <stdint.h>
+#include <span>
 
 #pragma warning(push)
 #pragma warning(disable:26819)
@@ -11,31 +12,66 @@
 #include "networkmessage.h"
 #include "networkendpoint.h"
 
+// Linux builds talk to the socket directly, which allows batching datagrams with recvmmsg/sendmmsg;
+// other platforms (or UDP_NATIVE_SOCKETS=0) go through SDL_net.
+#if !defined(UDP_NATIVE_SOCKETS)
+#   if defined(__linux__)
+#       define UDP_NATIVE_SOCKETS 1
+#   else
+#       define UDP_NATIVE_SOCKETS 0
+#   endif
+#endif
+
+class TrafficRecorder;
+
 // =================================================================================================
 // UDP based networking
+// Received datagrams are stored in a ring of preallocated packet buffers: the buffer a received
+// UDPData points to stays valid until RingSize more datagrams have been received. So a batch can
+// still be processed while the next one is received, as long as both fit into the ring.
+// With a TrafficRecorder attached, every datagram received or sent is also written to its capture.
 
 struct UDPData {
     uint8_t*    buffer;
     int         length;
+    IPaddress   address{};  // sender when receiving, receiver when sending
 };
 
 class UDPSocket
     : public NetworkEndpoint
 {
 public:
+#if UDP_NATIVE_SOCKETS
+    int         m_socket;
+#else
     UDPsocket   m_socket; // is a pointer type!
     UDPpacket*  m_packet;
+#endif
     IPaddress   m_address;
     int         m_channel;
+    uint8_t*    m_ring;     // RingSize packet buffers of MaxPacketSize bytes
+    int         m_ringHead; // next buffer to receive into
+    TrafficRecorder* m_recorder;
+    bool        m_isSendBlocked; // the last SendBatch() stopped at a full send buffer
 
     static constexpr int MaxPacketSize = 1500;
+    static constexpr int RingSize = 256;
+    static constexpr int MaxBatchSize = 64;     // datagrams per system call
 
 public:
     UDPSocket()
         : NetworkEndpoint()
+#if UDP_NATIVE_SOCKETS
+        , m_socket(-1)
+#else
         , m_socket(nullptr)
         , m_packet(nullptr)
+#endif
         , m_channel(-1)
+        , m_ring(nullptr)
+        , m_ringHead(0)
+        , m_recorder(nullptr)
+        , m_isSendBlocked(false)
     { 
         m_address.host = 0;
         m_address.port = 0;
@@ -45,7 +81,8 @@ public:
         Close(true);
     }
 
-    bool Open(const String& localAddress, uint16_t port);
+    // allowLoopback: accept 127.0.0.1 in debug builds, too (e.g. for local tests)
+    bool Open(const String& localAddress, uint16_t port, bool allowLoopback = false);
 
     bool Bind(void);
 
@@ -67,12 +104,49 @@ public:
 
     bool Receive(NetworkMessage& message);
 
+    // Receives up to packets.size() pending datagrams without waiting and returns their number.
+    // Datagrams shorter than minLength and datagrams sent by this socket itself are skipped.
+    int ReceiveBatch(std::span<UDPData> packets, int minLength = 0);
+
+    // sends each packet to its address; returns the number of packets sent
+    int SendBatch(std::span<const UDPData> packets);
+
+    // true if the last SendBatch() stopped because the socket's send buffer was full (EAGAIN) rather
+    // than because of an error: the remaining packets can be sent once the socket is writable again
+    inline bool IsSendBlocked(void) const noexcept {
+        return m_isSendBlocked;
+    }
+
+    // kernel socket buffer sizes in bytes (0: leave unchanged); false if they can't be set
+    bool SetBufferSizes(int receiveSize, int sendSize);
+
+    // records all traffic of this socket (nullptr: stop recording); the recorder must outlive it
+    inline void SetRecorder(TrafficRecorder* recorder) noexcept {
+        m_recorder = recorder;
+    }
+
+    inline bool IsOpen(void) const noexcept {
+#if UDP_NATIVE_SOCKETS
+        return m_socket >= 0;
+#else
+        return m_socket != nullptr;
+#endif
+    }
+
     bool SendBroadcast(const uint8_t* data, int dataLen, uint16_t destPort, bool subnetOnly);
 
     inline bool SendBroadcast(const String& msg, uint16_t destPort, bool subnetOnly = true) {
         return SendBroadcast(reinterpret_cast<const uint8_t*>(msg.Data()), int(msg.Length()), destPort, subnetOnly);
     }
 
+private:
+    inline uint8_t* RingBuffer(int i) noexcept {
+        return m_ring + size_t(i) * MaxPacketSize;
+    }
+
+    inline bool IsOwnAddress(const IPaddress& address) noexcept {
+        return (SocketAddress().host == address.host) and (SocketAddress().port == address.port);
+    }
 };
 
 // =================================================================================================
@@ -75,24 +75,19 @@ ArgValue& ArgValue::Move (ArgValue& other) {
 
 ArgValue::ArgumentList* ArgValue::Parse(const char* delims) {
     size_t l = strlen(delims);
-    if (l == 0)
-        return nullptr;
-    ArgumentList* subValues = new ArgumentList();
-    ArgValue* argV;
     for (int i = 0; i < l; i++) {
-        AutoArray<String> values = m_value.Split(delims[i]);
-        if (values.Length() > 1) {
-            for (auto& v : values) {
-                argV = new ArgValue(v, delims + i + 1);
-                if (argV->m_value.Length())
-                    subValues->Push(argV);
-                else
-                    delete argV;
-            }
-            return subValues;
+        // fields are only copied once it is known that this delimiter splits the value
+        StringUtils::SplitView values = m_value.SplitView(delims[i]);
+        StringUtils::SplitView::Iterator field = values.begin();
+        if ((field == values.end()) or (++field == values.end()))
+            continue;
+        ArgumentList* subValues = new ArgumentList();
+        for (std::string_view v : values) {
+            if (not v.empty())
+                subValues->Push(new ArgValue(String(v.data(), v.size()), delims + i + 1));
         }
+        return subValues;
     }
-    delete subValues;
     return nullptr;
 }
 
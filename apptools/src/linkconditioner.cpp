@@ -0,0 +1,129 @@
+
+#include <algorithm>
+#include <cstring>
+#include "linkconditioner.h"
+
+// =================================================================================================
+
+LinkConditioner::LinkConditioner(const LinkProfile& profile, uint32_t capacity)
+    : m_profile(profile), m_random(profile.seed)
+{
+    capacity = std::max(capacity, 1u);
+    m_slots = std::make_unique<NetworkPacket[]>(capacity);
+    m_freeSlots.reserve(capacity);
+    for (uint32_t i = capacity; i > 0; )
+        m_freeSlots.push_back(--i);
+    m_deliveries.reserve(capacity);
+}
+
+
+void LinkConditioner::SetProfile(const LinkProfile& profile) noexcept {
+    m_profile = profile;
+    m_random = RandomStream(profile.seed);
+}
+
+
+bool LinkConditioner::Submit(const UDPData& packet, int64_t now) noexcept {
+    m_submitted.fetch_add(1, std::memory_order_relaxed);
+    if ((m_profile.loss > 0.0f) and (m_random.Float() < m_profile.loss)) {
+        m_lost.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (m_freeSlots.empty() or (packet.length > UDPSocket::MaxPacketSize)) {
+        m_overflowed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    int64_t departure = now;
+    if (m_profile.bandwidth > 0.0f) {
+        // bits / (kbit/s) = ms, times 1e6 = ns
+        m_linkFree = std::max(m_linkFree, now) + int64_t(double(packet.length) * 8.0 * 1e6 / double(m_profile.bandwidth));
+        departure = m_linkFree;
+    }
+    int64_t delivery = departure + Nanos(m_profile.latency);
+    if (m_profile.jitter > 0.0f)
+        delivery += Nanos(m_random.Float(m_profile.jitter));
+    if ((m_profile.reorder > 0.0f) and (m_random.Float() < m_profile.reorder)) {
+        delivery += Nanos(m_profile.reorderDelay);
+        m_reordered.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        delivery = std::max(delivery, m_lastDelivery);
+        m_lastDelivery = delivery;
+    }
+
+    uint32_t slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+    NetworkPacket& p = m_slots[slot];
+    p.timestamp = now;
+    p.address = packet.address;
+    p.length = packet.length;
+    std::memcpy(p.data, packet.buffer, size_t(packet.length));
+    m_deliveries.push_back(Delivery{ delivery, m_sequence++, slot });
+    std::push_heap(m_deliveries.begin(), m_deliveries.end());
+    m_queued.store(uint32_t(m_deliveries.size()), std::memory_order_relaxed);
+    return true;
+}
+
+
+int LinkConditioner::Release(int64_t now, UDPSocket& socket) noexcept {
+    UDPData batch[UDPSocket::MaxBatchSize];
+    Delivery released[UDPSocket::MaxBatchSize];
+    int delivered = 0;
+    bool isBlocked = false;
+    while (not isBlocked and not m_deliveries.empty() and (m_deliveries.front().time <= now)) {
+        int n = 0;
+        for (; (n < UDPSocket::MaxBatchSize) and not m_deliveries.empty() and (m_deliveries.front().time <= now); ++n) {
+            std::pop_heap(m_deliveries.begin(), m_deliveries.end());
+            released[n] = m_deliveries.back();
+            m_deliveries.pop_back();
+            batch[n] = m_slots[released[n].slot].Packet();
+        }
+        int done = 0;   // sent or refused
+        while (done < n) {
+            int accepted = socket.SendBatch(std::span<const UDPData>(batch + done, size_t(n - done)));
+            delivered += accepted;
+            done += accepted;
+            if (done == n)
+                break;
+            if (socket.IsSendBlocked()) {
+                isBlocked = true;
+                break;
+            }
+            ++done; // a packet the socket refuses with an error is lost on the link, too
+        }
+        for (int i = 0; i < done; ++i)
+            m_freeSlots.push_back(released[i].slot);
+        // the rest waits for the socket; their delivery times keep them first in line
+        for (int i = done; i < n; ++i) {
+            m_deliveries.push_back(released[i]);
+            std::push_heap(m_deliveries.begin(), m_deliveries.end());
+        }
+    }
+    m_delivered.fetch_add(uint64_t(delivered), std::memory_order_relaxed);
+    m_queued.store(uint32_t(m_deliveries.size()), std::memory_order_relaxed);
+    return delivered;
+}
+
+
+uint32_t LinkConditioner::Discard(void) noexcept {
+    uint32_t n = uint32_t(m_deliveries.size());
+    for (const Delivery& d : m_deliveries)
+        m_freeSlots.push_back(d.slot);
+    m_deliveries.clear();
+    m_queued.store(0, std::memory_order_relaxed);
+    return n;
+}
+
+
+LinkConditioner::Statistics LinkConditioner::GetStatistics(void) const noexcept {
+    return Statistics{
+        m_submitted.load(std::memory_order_relaxed),
+        m_lost.load(std::memory_order_relaxed),
+        m_overflowed.load(std::memory_order_relaxed),
+        m_delivered.load(std::memory_order_relaxed),
+        m_reordered.load(std::memory_order_relaxed),
+        m_queued.load(std::memory_order_relaxed)
+    };
+}
+
+// =================================================================================================
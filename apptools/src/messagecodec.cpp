@@ -0,0 +1,156 @@
+
+#include <vector>
+#include "messagecodec.h"
+
+// =================================================================================================
+
+struct KeywordEntry {
+    std::string_view    keyword;
+    uint16_t            id;
+};
+
+// sorted by keyword
+static std::vector<KeywordEntry>& KeywordTable(void) {
+    static std::vector<KeywordEntry> table;
+    return table;
+}
+
+
+bool MessageKeywords::Register(uint16_t id, std::string_view keyword) {
+    std::vector<KeywordEntry>& table = KeywordTable();
+    auto pos = std::lower_bound(table.begin(), table.end(), keyword, [](const KeywordEntry& e, std::string_view k) { return e.keyword < k; });
+    if ((pos != table.end()) and (pos->keyword == keyword))
+        return pos->id == id;
+    if (not Name(id).empty())
+        return false;
+    table.insert(pos, KeywordEntry{ keyword, id });
+    return true;
+}
+
+
+int32_t MessageKeywords::Find(std::string_view keyword) noexcept {
+    const std::vector<KeywordEntry>& table = KeywordTable();
+    auto pos = std::lower_bound(table.begin(), table.end(), keyword, [](const KeywordEntry& e, std::string_view k) { return e.keyword < k; });
+    return ((pos != table.end()) and (pos->keyword == keyword)) ? int32_t(pos->id) : -1;
+}
+
+
+std::string_view MessageKeywords::Name(uint16_t id) noexcept {
+    for (const KeywordEntry& e : KeywordTable())
+        if (e.id == id)
+            return e.keyword;
+    return std::string_view();
+}
+
+// =================================================================================================
+
+MessageReader::MessageReader(const uint8_t* data, int length) noexcept
+    : m_data(data), m_length(data ? length : 0)
+{
+    if (m_length <= 0) {
+        Fail();
+        return;
+    }
+    if (MessageFormat::IsBinary(m_data, m_length)) {
+        m_version = m_data[1];
+        if ((m_version == 0) or (m_version > MessageFormat::version)) {
+            Fail();
+            return;
+        }
+        m_keywordId = int32_t(m_data[2]) | (int32_t(m_data[3]) << 8);
+        m_position = MessageFormat::headerSize;
+        return;
+    }
+    // text message: "KEYWORD#value;value;..."
+    m_isText = true;
+    std::string_view text(reinterpret_cast<const char*>(m_data), size_t(m_length));
+    size_t separator = text.find('#');
+    m_keywordId = MessageKeywords::Find(text.substr(0, separator));
+    m_position = (separator == std::string_view::npos) ? m_length : int(separator) + 1;
+}
+
+
+std::string_view MessageReader::NextValue(void) noexcept {
+    if (m_position >= m_length) {
+        Fail();
+        return std::string_view();
+    }
+    std::string_view text(reinterpret_cast<const char*>(m_data) + m_position, size_t(m_length - m_position));
+    size_t separator = text.find(';');
+    if (separator == std::string_view::npos) {
+        m_position = m_length;
+        return text;
+    }
+    m_position += int(separator) + 1;
+    return text.substr(0, separator);
+}
+
+
+std::string_view MessageReader::ReadString(void) noexcept {
+    if (m_isText)
+        return NextValue();
+    uint64_t length = ReadVarUInt();
+    if (length > uint64_t(m_length - m_position)) {
+        Fail();
+        return std::string_view();
+    }
+    const uint8_t* p = Consume(int(length));
+    return p ? std::string_view(reinterpret_cast<const char*>(p), size_t(length)) : std::string_view();
+}
+
+
+Vector3f MessageReader::ReadVector3f(void) noexcept {
+    if (not m_isText) {
+        float x = ReadFloat();
+        float y = ReadFloat();
+        float z = ReadFloat();
+        return m_error ? Vector3f::ZERO : Vector3f{ x, y, z };
+    }
+    // "x,y,z"
+    std::string_view value = NextValue();
+    float c[3];
+    int i = 0;
+    for (std::string_view coord : StringUtils::SplitView(value, ',')) {
+        if ((i == 3) or not StringUtils::ParseNumber(coord, c[i])) {
+            i = -1;
+            break;
+        }
+        ++i;
+    }
+    if (m_error or (i != 3)) {
+        Fail();
+        return Vector3f::ZERO;
+    }
+    return Vector3f{ c[0], c[1], c[2] };
+}
+
+
+Vector3f MessageReader::ReadQuantizedVector3f(float range) noexcept {
+    if (m_isText)   // the text format has no quantized values
+        return ReadVector3f();
+    float x = ReadQuantized(range);
+    float y = ReadQuantized(range);
+    float z = ReadQuantized(range);
+    return m_error ? Vector3f::ZERO : Vector3f{ x, y, z };
+}
+
+
+IPaddress MessageReader::ReadAddress(void) noexcept {
+    IPaddress address{};
+    if (m_isText) {
+        // "host:port", both as numbers in network byte order (see NetworkMessage::ToNetworkEndpoint)
+        std::string_view value = NextValue();
+        size_t separator = value.find(':');
+        if (m_error or (separator == std::string_view::npos) or not StringUtils::ParseNumber(value.substr(0, separator), address.host) or not StringUtils::ParseNumber(value.substr(separator + 1), address.port)) {
+            Fail();
+            return IPaddress{};
+        }
+    }
+    else if (const uint8_t* p = Consume(6)) {
+        std::memcpy(&address.host, p, 4);
+        std::memcpy(&address.port, p + 4, 2);
+    }
+    return address;
+}
+
+// =================================================================================================
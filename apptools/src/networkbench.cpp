@@ -0,0 +1,124 @@
+
+#include <new>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include "networkbenchmark.h"
+#include "arghandler.h"
+#include "allocator.h"
+
+// =================================================================================================
+// Loopback network benchmark (make bench): runs NetworkBenchmark with the text and the binary codec.
+// Arguments are key=value pairs:
+//   peers=4 rate=1000 (messages per second and peer) duration=5 (s) payload=64 (bytes)
+//   codec=both|text|binary queue=1024 (packets per pump queue)
+//   link=ideal|lan|wan|mobile, adjusted by latency=ms jitter=ms loss=0..1 reorder=0..1
+//   bandwidth=kbit/s seed=n
+// e.g. networkbench peers=8 rate=2000 link=wan loss=0.05
+
+#if not SIZE_CLASS_MALLOC
+
+// The SizeClassAllocator counts the allocations itself if it replaces the global operator new;
+// otherwise they are counted here.
+static std::atomic<int64_t> allocations{ 0 };
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t a = size_t(alignment);
+    if (void* p = std::aligned_alloc(a, (size + a - 1) & ~(a - 1)))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+
+static int64_t AllocationCount(void) {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+static bool SelectLink(const String& name, LinkProfile& link) {
+    if (name == "ideal")
+        link = LinkProfile();
+    else if (name == "lan")
+        link = LinkProfile{ 0.5f, 0.2f, 0.0f, 0.0f, 5.0f, 0.0f, 1 };
+    else if (name == "wan")
+        link = LinkProfile{ 40.0f, 8.0f, 0.01f, 0.01f, 5.0f, 0.0f, 1 };
+    else if (name == "mobile")
+        link = LinkProfile{ 80.0f, 30.0f, 0.03f, 0.02f, 20.0f, 2000.0f, 1 };
+    else
+        return false;
+    return true;
+}
+
+// =================================================================================================
+
+int main(int argc, char** argv) {
+    argHandler.LoadArgs(argc, argv);
+    NetworkBenchmark::Settings settings;
+    settings.peers = argHandler.IntVal("peers", 0, settings.peers, false);
+    settings.rate = argHandler.IntVal("rate", 0, settings.rate, false);
+    settings.duration = argHandler.FloatVal("duration", 0, settings.duration, false);
+    settings.payloadSize = argHandler.IntVal("payload", 0, settings.payloadSize, false);
+    settings.queueSize = uint32_t(argHandler.IntValChecked("queue", 0, int(settings.queueSize), 2, 1 << 20, false));
+    String linkName = argHandler.StrVal("link", 0, String("ideal"), false);
+    if (not SelectLink(linkName, settings.link)) {
+        fprintf(stderr, "networkbench: unknown link profile '%s' (ideal, lan, wan, mobile)\n", linkName.Data());
+        return EXIT_FAILURE;
+    }
+    LinkProfile& link = settings.link;
+    link.latency = argHandler.FloatVal("latency", 0, link.latency, false);
+    link.jitter = argHandler.FloatVal("jitter", 0, link.jitter, false);
+    link.loss = argHandler.FloatValChecked("loss", 0, link.loss, 0.0f, 1.0f, false);
+    link.reorder = argHandler.FloatValChecked("reorder", 0, link.reorder, 0.0f, 1.0f, false);
+    link.bandwidth = argHandler.FloatVal("bandwidth", 0, link.bandwidth, false);
+    link.seed = uint64_t(argHandler.IntVal("seed", 0, int(link.seed), false));
+#if not SIZE_CLASS_MALLOC
+    settings.countAllocations = AllocationCount;
+#endif
+
+    String codecName = argHandler.StrVal("codec", 0, String("both"), false);
+    NetworkBenchmark::Codec codecs[2] = { NetworkBenchmark::TextCodec(), NetworkBenchmark::BinaryCodec() };
+    int codecCount = 0;
+    for (const NetworkBenchmark::Codec& codec : codecs) {
+        if ((codecName != "both") and (codecName != codec.name))
+            continue;
+        ++codecCount;
+        NetworkBenchmark::Result result = NetworkBenchmark::Run(settings, codec);
+        if (result.sent == 0) {
+            fprintf(stderr, "networkbench: cannot set up %d peers on the loopback interface\n", settings.peers);
+            return EXIT_FAILURE;
+        }
+        NetworkBenchmark::Print(result);
+    }
+    if (codecCount == 0) {
+        fprintf(stderr, "networkbench: unknown codec '%s' (both, text, binary)\n", codecName.Data());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,250 @@
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <cstring>
+#include <algorithm>
+#include "networkbenchmark.h"
+#include "networkmessage.h"
+#include "messagecodec.h"
+#include "allocator.h"
+
+// =================================================================================================
+
+static constexpr uint16_t benchmarkKeywordId = 0xBE00;
+static constexpr int maxHeaderSize = 64;    // room the codecs need besides the padding
+
+static const char* Padding(void) noexcept {
+    static char padding[UDPSocket::MaxPacketSize];
+    static bool isFilled = false;
+    if (not isFilled) {
+        std::memset(padding, 'x', sizeof(padding));
+        isFilled = true;
+    }
+    return padding;
+}
+
+
+static int EncodeText(uint8_t* buffer, int capacity, uint32_t sequence, int64_t sendTime, int payloadSize) {
+    int length = snprintf(reinterpret_cast<char*>(buffer), size_t(capacity), "BENCH#%u;%lld;%.*s", sequence, (long long) sendTime, payloadSize, Padding());
+    return ((length > 0) and (length < capacity)) ? length : 0;
+}
+
+
+// the way received messages are handled today (cf. UDPSocket::Receive(NetworkMessage&))
+static bool DecodeText(const uint8_t* data, int length, uint32_t& sequence, int64_t& sendTime) {
+    static NetworkMessage message;
+    message.Payload() = String(reinterpret_cast<const char*>(data), length);
+    if (not message.IsValid(-2))
+        return false;
+    return message.ToUInt32(sequence, "NetworkBenchmark", "sequence", 0) and message.ToInt64(sendTime, "NetworkBenchmark", "send time", 1);
+}
+
+
+static int EncodeBinary(uint8_t* buffer, int capacity, uint32_t sequence, int64_t sendTime, int payloadSize) {
+    MessageWriter writer(buffer, capacity, benchmarkKeywordId);
+    writer.WriteU32(sequence);
+    writer.WriteI64(sendTime);
+    writer.WriteString(std::string_view(Padding(), size_t(payloadSize)));
+    return writer.IsValid() ? writer.Length() : 0;
+}
+
+
+static bool DecodeBinary(const uint8_t* data, int length, uint32_t& sequence, int64_t& sendTime) {
+    MessageReader reader(data, length);
+    if (reader.IsText() or (reader.KeywordId() != benchmarkKeywordId))
+        return false;
+    sequence = reader.ReadU32();
+    sendTime = reader.ReadI64();
+    reader.ReadString();
+    return reader.IsValid() and reader.AtEnd();
+}
+
+
+NetworkBenchmark::Codec NetworkBenchmark::TextCodec(void) noexcept {
+    return Codec{ "text", EncodeText, DecodeText };
+}
+
+
+NetworkBenchmark::Codec NetworkBenchmark::BinaryCodec(void) noexcept {
+    return Codec{ "binary", EncodeBinary, DecodeBinary };
+}
+
+// =================================================================================================
+
+static int64_t AllocationCount(void) noexcept {
+#if SIZE_CLASS_MALLOC
+    SizeClassAllocator::Stats stats = SizeClassAllocator::GetStats();
+    int64_t count = int64_t(stats.largeAllocations);
+    for (const SizeClassAllocator::ClassStats& c : stats.classes)
+        count += int64_t(c.allocations);
+    return count;
+#else
+    return -1;
+#endif
+}
+
+
+struct BenchmarkPeer {
+    UDPSocket       socket;
+    LinkConditioner conditioner;
+    NetworkPump     pump;
+    uint32_t        nextSequence{ 0 };
+    uint32_t        lastSequence{ 0 };  // highest sequence number received
+    bool            hasReceived{ false };
+
+    explicit BenchmarkPeer(const LinkProfile& link)
+        : conditioner(link), pump(socket)
+    { }
+};
+
+
+NetworkBenchmark::Result NetworkBenchmark::Run(const Settings& settings, const Codec& codec) {
+    Result result{};
+    result.codec = codec.name;
+    result.peers = std::max(settings.peers, 2);
+    int payloadSize = std::clamp(settings.payloadSize, 0, UDPSocket::MaxPacketSize - maxHeaderSize);
+    Padding();
+
+    std::vector<std::unique_ptr<BenchmarkPeer>> peers;
+    for (int i = 0; i < result.peers; ++i) {
+        LinkProfile link = settings.link;
+        link.seed += uint64_t(i);   // independent links
+        peers.push_back(std::make_unique<BenchmarkPeer>(link));
+        BenchmarkPeer& peer = *peers.back();
+        if (not peer.socket.Open("127.0.0.1", 0, true))
+            return result;
+        peer.socket.SetBufferSizes(1 << 22, 1 << 22);
+        if (not link.IsIdeal())
+            peer.pump.SetConditioner(&peer.conditioner);
+        if (not peer.pump.Start(settings.queueSize, settings.queueSize))
+            return result;
+    }
+
+    double rate = double(std::max(settings.rate, 1)) / double(Clock::nanosPerSecond);
+    int64_t duration = int64_t(double(std::max(settings.duration, 0.0f)) * double(Clock::nanosPerSecond));
+    // time for the last messages to arrive
+    const LinkProfile& link = settings.link;
+    int64_t drainTime = int64_t(double(link.latency + link.jitter + link.reorderDelay) * 1e6) + Clock::nanosPerSecond / 4;
+    std::vector<int32_t> latencies;
+    latencies.reserve(size_t(double(duration) * rate + 1.0) * size_t(result.peers));
+
+    NetworkBenchmark::AllocationCounter countAllocations = settings.countAllocations ? settings.countAllocations : AllocationCount;
+    int64_t allocations = countAllocations();
+    int64_t encodeTime = 0;
+    int64_t decodeTime = 0;
+    int64_t start = Clock::Nanos();
+    int64_t lastReceived = start;
+    for (int64_t now = start; ; now = Clock::Nanos()) {
+        bool isSending = now - start < duration;
+        bool isBusy = false;
+        if (isSending) {
+            uint32_t due = uint32_t(double(now - start) * rate) + 1;
+            for (int i = 0; i < result.peers; ++i) {
+                BenchmarkPeer& peer = *peers[i];
+                if (peer.nextSequence == due)
+                    continue;
+                const IPaddress& receiver = peers[(i + 1) % result.peers]->socket.SocketAddress();
+                int64_t t = Clock::Nanos();
+                for (; peer.nextSequence != due; ++peer.nextSequence) {
+                    NetworkPacket* packet = peer.pump.ReserveSend();
+                    if (not packet)
+                        continue;
+                    packet->length = codec.encode(packet->data, UDPSocket::MaxPacketSize, peer.nextSequence, t, payloadSize);
+                    if (packet->length <= 0)
+                        continue;
+                    packet->address = receiver;
+                    packet->timestamp = t;
+                    peer.pump.CommitSend(false);
+                    ++result.sent;
+                }
+                encodeTime += Clock::Nanos() - t;
+                peer.pump.Flush();
+                isBusy = true;
+            }
+        }
+        for (std::unique_ptr<BenchmarkPeer>& p : peers) {
+            BenchmarkPeer& peer = *p;
+            int64_t t = Clock::Nanos();
+            int n = peer.pump.Receive([&](const NetworkPacket& packet) {
+                uint32_t sequence;
+                int64_t sendTime;
+                if (not codec.decode(packet.data, packet.length, sequence, sendTime)) {
+                    ++result.invalid;
+                    return;
+                }
+                ++result.received;
+                if (peer.hasReceived and (int32_t(sequence - peer.lastSequence) < 0))
+                    ++result.reordered;
+                else {
+                    peer.lastSequence = sequence;
+                    peer.hasReceived = true;
+                }
+                if (latencies.size() < latencies.capacity())
+                    latencies.push_back(int32_t(std::min(t - sendTime, int64_t(INT32_MAX))));
+                });
+            if (n) {
+                lastReceived = Clock::Nanos();
+                decodeTime += lastReceived - t;
+                isBusy = true;
+            }
+        }
+        if (not isSending and ((result.received + result.invalid >= result.sent) or (now - start >= duration + drainTime)))
+            break;
+        if (not isBusy)
+            std::this_thread::yield();
+    }
+    if (allocations >= 0)
+        result.allocations = countAllocations() - allocations;
+    else
+        result.allocations = -1;
+
+    for (std::unique_ptr<BenchmarkPeer>& p : peers) {
+        p->pump.Stop();
+        NetworkPump::Statistics pumpStats = p->pump.GetStatistics();
+        LinkConditioner::Statistics linkStats = p->conditioner.GetStatistics();
+        result.queueDropped += pumpStats.receiveDropped + pumpStats.sendDropped;
+        result.linkLost += linkStats.lost + linkStats.overflowed;
+    }
+
+    uint64_t handled = result.received + result.invalid;
+    if (lastReceived > start)
+        result.messagesPerSecond = double(result.received) * double(Clock::nanosPerSecond) / double(lastReceived - start);
+    if (result.sent)
+        result.encodeNanos = double(encodeTime) / double(result.sent);
+    if (handled)
+        result.decodeNanos = double(decodeTime) / double(handled);
+    if (not latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        size_t n = latencies.size();
+        double sum = 0.0;
+        for (int32_t l : latencies)
+            sum += double(l);
+        auto percentile = [&](size_t p) { return float(latencies[std::min((n * p + 99) / 100, n) - 1]) * 0.001f; };
+        result.latencyMean = float(sum / double(n)) * 0.001f;
+        result.latencyP50 = percentile(50);
+        result.latencyP90 = percentile(90);
+        result.latencyP99 = percentile(99);
+        result.latencyMax = float(latencies.back()) * 0.001f;
+    }
+    return result;
+}
+
+
+void NetworkBenchmark::Print(const Result& result, FILE* stream) {
+    fprintf(stream, "%s: %d peers, %llu sent, %llu received, %llu invalid, %llu reordered, %llu lost on the link, %llu dropped by full queues\n",
+            result.codec, result.peers, (unsigned long long) result.sent, (unsigned long long) result.received, (unsigned long long) result.invalid,
+            (unsigned long long) result.reordered, (unsigned long long) result.linkLost, (unsigned long long) result.queueDropped);
+    fprintf(stream, "  %.0f messages/s, encode %.0f ns, decode %.0f ns per message\n", result.messagesPerSecond, result.encodeNanos, result.decodeNanos);
+    fprintf(stream, "  latency (us): mean %.1f, p50 %.1f, p90 %.1f, p99 %.1f, max %.1f\n",
+            result.latencyMean, result.latencyP50, result.latencyP90, result.latencyP99, result.latencyMax);
+    if (result.allocations < 0)
+        fprintf(stream, "  allocations: not counted\n");
+    else {
+        uint64_t messages = result.sent + result.received;
+        fprintf(stream, "  allocations: %lld (%.2f per message sent or received)\n", (long long) result.allocations,
+                messages ? double(result.allocations) / double(messages) : 0.0);
+    }
+}
+
+// =================================================================================================
@@ -21,17 +21,22 @@ bool NetworkMessage::IsValid(int requiredValueCount, int maxValueCount) {
     */
     try {
         m_values.Clear();
-        m_values = m_payload.Split('#');
-        String keyword = m_values[0];
-        if (m_values.Length() < 2)
-            m_numValues = 0;
-        else {
-            m_values = m_values[1].Split(';');
-            if (not m_values[0].IsEmpty())
+        m_numValues = 0;
+        StringUtils::SplitView parts = m_payload.SplitView('#');
+        StringUtils::SplitView::Iterator part = parts.begin();
+        if (part == parts.end()) {
+            m_result = -1;
+            return false;
+        }
+        [[maybe_unused]] std::string_view keyword = *part;  // only reported in debug builds
+        if (++part != parts.end()) {
+            StringUtils::SplitView values(*part, ';');
+            StringUtils::SplitView::Iterator first = values.begin();
+            if ((first != values.end()) and not (*first).empty()) {
+                m_values.Reserve(values.Count());
+                for (std::string_view v : values)
+                    m_values.Append(ValueRange{ uint32_t(v.data() - m_payload.Data()), uint32_t(v.size()) });
                 m_numValues = m_values.Length();
-            else {
-                m_values.Clear();
-                m_numValues = 0;
             }
         }
         if (requiredValueCount == 0) {
@@ -51,7 +56,7 @@ bool NetworkMessage::IsValid(int requiredValueCount, int maxValueCount) {
             }
         }
 #ifdef _DEBUG
-        fprintf(stderr, "message %s has wrong number of values (expected %d, found %d)\n", static_cast<char*>(keyword), abs(requiredValueCount), m_numValues);
+        fprintf(stderr, "message %.*s has wrong number of values (expected %d, found %d)\n", int(keyword.size()), keyword.data(), abs(requiredValueCount), m_numValues);
 #endif
     }
     catch (...) {
@@ -70,12 +75,12 @@ Parameters:
 -----------
     i: Index of the requested parameter
 */
-bool NetworkMessage::ToNetworkEndpoint(String caller, String valueName, int valueIndex, NetworkEndpoint& address) {
+bool NetworkMessage::ToNetworkEndpoint(const char* caller, const char* valueName, int valueIndex, NetworkEndpoint& address) {
     if (not IsValidIndex(caller, valueName, valueIndex))
         return false;
     try {
-        AutoArray<String> ipParts = m_values[valueIndex].Split(':');
-        if (ipParts.Length() != 2)
+        SmallArray<std::string_view, 2> ipParts;
+        if (StringUtils::SplitInto(Value(valueIndex), ':', ipParts) != 2)
             return false;
         address.SocketAddress().host = StringToNumber<uint32_t>(caller, valueName, ipParts[0]);
         if (m_valueError)
@@ -88,34 +93,35 @@ bool NetworkMessage::ToNetworkEndpoint(String caller, String valueName, int valu
     }
     catch (...) {
     }
-    return InvalidDataError(caller, valueName, m_values[valueIndex]);
+    return InvalidDataError(caller, valueName, Value(valueIndex));
 }
 
 
-bool NetworkMessage::ToVector3f(Vector3f& v, String caller, String valueName, int valueIndex) noexcept {
+bool NetworkMessage::ToVector3f(Vector3f& v, const char* caller, const char* valueName, int valueIndex) noexcept {
     v = Vector3f::ZERO;
     if (not IsValidIndex(caller, valueName, valueIndex))
         return false;
+    std::string_view value = Value(valueIndex);
     try {
-        AutoArray<String> coords = m_values[valueIndex].Split(',');
-        if (coords.Length() != 3)
-            return InvalidDataError(caller, valueName, m_values[valueIndex]);
+        SmallArray<std::string_view, 3> coords;
+        if (StringUtils::SplitInto(value, ',', coords) != 3)
+            return InvalidDataError(caller, valueName, value);
         Vector3f w;
         w.X() = StringToNumber<float>(caller, valueName, coords[0]);
         if (ValueError())
-            return InvalidDataError(caller, valueName, m_values[valueIndex]);
+            return InvalidDataError(caller, valueName, value);
         w.Y() = StringToNumber<float>(caller, valueName, coords[1]);
         if (ValueError())
-            return InvalidDataError(caller, valueName, m_values[valueIndex]);
+            return InvalidDataError(caller, valueName, value);
         w.Z() = StringToNumber<float>(caller, valueName, coords[2]);
         if (ValueError())
-            return InvalidDataError(caller, valueName, m_values[valueIndex]);
+            return InvalidDataError(caller, valueName, value);
         v = w;
         return true;
     }
     catch (...) {
     }
-    return InvalidDataError(caller, valueName, m_values[valueIndex]);
+    return InvalidDataError(caller, valueName, value);
 }
 
 
@@ -0,0 +1,268 @@
+
+#include <new>
+#include <bit>
+#include <cstring>
+#include "networkpump.h"
+#include "linkconditioner.h"
+#include "profiler.h"
+
+#if UDP_NATIVE_SOCKETS
+#   include <poll.h>
+#   include <unistd.h>
+#   include <sys/eventfd.h>
+#endif
+
+// =================================================================================================
+
+bool PacketQueue::Create(uint32_t capacity) {
+    capacity = std::bit_ceil(std::max(capacity, 2u));
+    if (Capacity() != capacity) {
+        m_packets.reset(new (std::nothrow) NetworkPacket[capacity]);
+        if (not m_packets)
+            return false;
+        m_mask = capacity - 1;
+    }
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    m_cachedHead = m_cachedTail = 0;
+    return true;
+}
+
+// =================================================================================================
+
+bool NetworkPump::Start(uint32_t receiveQueueSize, uint32_t sendQueueSize) {
+    if (IsRunning() or not m_socket.IsOpen())
+        return false;
+    if (not (m_receiveQueue.Create(receiveQueueSize) and m_sendQueue.Create(sendQueueSize)))
+        return false;
+#if UDP_NATIVE_SOCKETS
+    if (0 > (m_wakeEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)))
+        return false;
+#else
+    if (not (m_socketSet = SDLNet_AllocSocketSet(1)))
+        return false;
+    SDLNet_UDP_AddSocket(m_socketSet, m_socket.m_socket);
+#endif
+    for (std::atomic<uint64_t>* counter : { &m_received, &m_receiveDropped, &m_sent, &m_sendDropped, &m_sendFailed })
+        counter->store(0, std::memory_order_relaxed);
+    m_maxReceiveDepth.store(0, std::memory_order_relaxed);
+    m_maxSendDepth.store(0, std::memory_order_relaxed);
+    m_isWaiting.store(false, std::memory_order_relaxed);
+    m_isRunning.store(true, std::memory_order_release);
+    m_thread = std::thread(&NetworkPump::Run, this);
+    return true;
+}
+
+
+void NetworkPump::Stop(void) {
+    if (not m_isRunning.exchange(false))
+        return;
+    Wake();
+    m_thread.join();
+#if UDP_NATIVE_SOCKETS
+    close(m_wakeEvent);
+    m_wakeEvent = -1;
+#else
+    SDLNet_FreeSocketSet(m_socketSet);
+    m_socketSet = nullptr;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+NetworkPacket* NetworkPump::ReserveSend(void) noexcept {
+    NetworkPacket* packet = m_sendQueue.Reserve();
+    if (not packet)
+        m_sendDropped.fetch_add(1, std::memory_order_relaxed);
+    return packet;
+}
+
+
+void NetworkPump::CommitSend(bool wake) noexcept {
+    m_sendQueue.Commit();
+    UpdateMaximum(m_maxSendDepth, m_sendQueue.Size());
+    if (wake)
+        Flush();
+}
+
+
+bool NetworkPump::Send(const uint8_t* data, int length, const IPaddress& receiver, bool wake) noexcept {
+    if ((length <= 0) or (length > UDPSocket::MaxPacketSize))
+        return false;
+    NetworkPacket* packet = ReserveSend();
+    if (not packet)
+        return false;
+    packet->timestamp = Clock::Nanos();
+    packet->address = receiver;
+    packet->length = length;
+    std::memcpy(packet->data, data, size_t(length));
+    CommitSend(wake);
+    return true;
+}
+
+
+// The pump thread announces that it is going to wait, then checks the send queue once more; the
+// main thread queues a packet, then checks for a waiting pump. The fences order each store before
+// the other side's load, so at least one of them sees the other and no packet is left lying in the
+// queue until the next datagram arrives.
+void NetworkPump::Flush(void) noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_isWaiting.load(std::memory_order_relaxed) and m_isWaiting.exchange(false, std::memory_order_relaxed))
+        Wake();
+}
+
+
+void NetworkPump::Wake(void) noexcept {
+#if UDP_NATIVE_SOCKETS
+    uint64_t one = 1;
+    [[maybe_unused]] ssize_t result = write(m_wakeEvent, &one, sizeof(one));
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void NetworkPump::Run(void) {
+    Profiler::SetThreadName("Network");
+    while (m_isRunning.load(std::memory_order_acquire)) {
+        SendPackets();
+        if (ReceivePackets() < UDPSocket::MaxBatchSize)
+            WaitForTraffic();
+    }
+    Drain();
+}
+
+
+int NetworkPump::ReceivePackets(void) {
+    UDPData batch[UDPSocket::MaxBatchSize];
+    int n = m_socket.ReceiveBatch(std::span<UDPData>(batch), 0);
+    if (n == 0)
+        return 0;
+    int64_t now = Clock::Nanos();
+    int i = 0;
+    for (; i < n; ++i) {
+        NetworkPacket* packet = m_receiveQueue.Reserve();
+        if (not packet)
+            break;
+        packet->timestamp = now;
+        packet->address = batch[i].address;
+        packet->length = batch[i].length;
+        std::memcpy(packet->data, batch[i].buffer, size_t(batch[i].length));
+        m_receiveQueue.Commit();
+    }
+    m_received.fetch_add(uint64_t(i), std::memory_order_relaxed);
+    if (i < n)
+        m_receiveDropped.fetch_add(uint64_t(n - i), std::memory_order_relaxed);
+    UpdateMaximum(m_maxReceiveDepth, m_receiveQueue.Size());
+    return n;
+}
+
+
+void NetworkPump::SendPackets(bool isFlushing) {
+    if (m_conditioner) {
+        int64_t now = Clock::Nanos();
+        uint32_t n = m_sendQueue.Available();
+        for (uint32_t i = 0; i < n; ++i)
+            m_conditioner->Submit(m_sendQueue.Peek(i).Packet(), now);
+        if (n)
+            m_sendQueue.Pop(n);
+        int64_t releaseTime = isFlushing ? INT64_MAX : now;
+        m_sent.fetch_add(uint64_t(m_conditioner->Release(releaseTime, m_socket)), std::memory_order_relaxed);
+        // due packets left behind are waiting for a full send buffer
+        m_isSendBlocked = m_conditioner->Queued() and (m_conditioner->NextDelivery() <= releaseTime) and m_socket.IsSendBlocked();
+        return;
+    }
+    m_isSendBlocked = false;
+    UDPData batch[UDPSocket::MaxBatchSize];
+    for (;;) {
+        int n = int(std::min(m_sendQueue.Available(), uint32_t(UDPSocket::MaxBatchSize)));
+        if (n == 0)
+            return;
+        for (int i = 0; i < n; ++i)
+            batch[i] = m_sendQueue.Peek(uint32_t(i)).Packet();
+        int sent = m_socket.SendBatch(std::span<const UDPData>(batch, size_t(n)));
+        m_sent.fetch_add(uint64_t(sent), std::memory_order_relaxed);
+        if (sent < n) {
+            if (m_socket.IsSendBlocked()) { // keep the rest until the socket is writable again
+                m_sendQueue.Pop(uint32_t(sent));
+                m_isSendBlocked = true;
+                return;
+            }
+            // drop the packet the socket refused, so it doesn't block the queue
+            m_sendFailed.fetch_add(1, std::memory_order_relaxed);
+            ++sent;
+        }
+        m_sendQueue.Pop(uint32_t(sent));
+    }
+}
+
+
+void NetworkPump::Drain(void) {
+    int64_t deadline = Clock::Nanos() + int64_t(stopTimeout) * 1000000;
+    for (SendPackets(true); m_isSendBlocked and WaitWritable(deadline); SendPackets(true))
+        ;
+    uint32_t n = m_sendQueue.Available();
+    if (n)
+        m_sendQueue.Pop(n);
+    if (m_conditioner)
+        n += m_conditioner->Discard();
+    if (n)
+        m_sendFailed.fetch_add(uint64_t(n), std::memory_order_relaxed);
+}
+
+
+void NetworkPump::WaitForTraffic(void) {
+    m_isWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // with a full send buffer, queued packets have to wait for the socket instead
+    if ((m_sendQueue.Available() and not m_isSendBlocked) or not m_isRunning.load(std::memory_order_relaxed)) {
+        m_isWaiting.store(false, std::memory_order_relaxed);
+        return;
+    }
+    // wait for the conditioner's next delivery at most, unless it waits for the socket anyway
+    int64_t timeout = -1;
+    if (m_conditioner and m_conditioner->Queued() and not m_isSendBlocked)
+        timeout = std::max(m_conditioner->NextDelivery() - Clock::Nanos(), int64_t(0));
+#if UDP_NATIVE_SOCKETS
+    pollfd fds[2] = { { m_socket.m_socket, short(m_isSendBlocked ? POLLIN | POLLOUT : POLLIN), 0 }, { m_wakeEvent, POLLIN, 0 } };
+    timespec delay{ time_t(timeout / Clock::nanosPerSecond), long(timeout % Clock::nanosPerSecond) };
+    if ((0 < ppoll(fds, 2, (timeout < 0) ? nullptr : &delay, nullptr)) and (fds[1].revents & POLLIN)) {
+        uint64_t count;
+        [[maybe_unused]] ssize_t result = read(m_wakeEvent, &count, sizeof(count)); // resets the eventfd
+    }
+#else
+    SDLNet_CheckSockets(m_socketSet, ((timeout >= 0) and (timeout < sdlPollTimeout * 1000000)) ? uint32_t(timeout / 1000000) : sdlPollTimeout);
+#endif
+    m_isWaiting.store(false, std::memory_order_relaxed);
+}
+
+
+bool NetworkPump::WaitWritable([[maybe_unused]] int64_t deadline) {
+#if UDP_NATIVE_SOCKETS
+    int64_t timeout = deadline - Clock::Nanos();
+    if (timeout <= 0)
+        return false;
+    pollfd fd{ m_socket.m_socket, POLLOUT, 0 };
+    timespec delay{ time_t(timeout / Clock::nanosPerSecond), long(timeout % Clock::nanosPerSecond) };
+    return (0 < ppoll(&fd, 1, &delay, nullptr)) and (fd.revents & POLLOUT);
+#else
+    return false;   // SDL_net sockets block in send, so their send buffer is never reported full
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+NetworkPump::Statistics NetworkPump::GetStatistics(void) const noexcept {
+    return Statistics{
+        m_received.load(std::memory_order_relaxed),
+        m_receiveDropped.load(std::memory_order_relaxed),
+        m_sent.load(std::memory_order_relaxed),
+        m_sendDropped.load(std::memory_order_relaxed),
+        m_sendFailed.load(std::memory_order_relaxed),
+        m_receiveQueue.Size(),
+        m_sendQueue.Size(),
+        m_maxReceiveDepth.load(std::memory_order_relaxed),
+        m_maxSendDepth.load(std::memory_order_relaxed)
+    };
+}
+
+// =================================================================================================
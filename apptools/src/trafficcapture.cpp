@@ -0,0 +1,194 @@
+
+#include <ctime>
+#include <cstring>
+#include "trafficcapture.h"
+#include "networkmessage.h"
+
+// =================================================================================================
+
+static inline void PutU16(std::vector<uint8_t>& buffer, uint16_t v) {
+    buffer.push_back(uint8_t(v));
+    buffer.push_back(uint8_t(v >> 8));
+}
+
+
+static inline void PutU32(std::vector<uint8_t>& buffer, uint32_t v) {
+    for (int i = 0; i < 4; ++i, v >>= 8)
+        buffer.push_back(uint8_t(v));
+}
+
+
+static inline void PutVarUInt(std::vector<uint8_t>& buffer, uint64_t v) {
+    for (; v >= 0x80; v >>= 7)
+        buffer.push_back(uint8_t(v) | 0x80);
+    buffer.push_back(uint8_t(v));
+}
+
+
+static inline uint64_t GetU(const uint8_t* p, int size) noexcept {
+    uint64_t v = 0;
+    for (int i = size - 1; i >= 0; --i)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+
+static inline bool GetVarUInt(const std::vector<uint8_t>& data, size_t& position, uint64_t& v) noexcept {
+    v = 0;
+    for (int shift = 0; (shift < 64) and (position < data.size()); shift += 7) {
+        uint8_t b = data[position++];
+        v |= uint64_t(b & 0x7F) << shift;
+        if (not (b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+// =================================================================================================
+
+bool TrafficRecorder::Open(const char* filename) {
+    Close();
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (not (m_file = fopen(filename, "wb")))
+        return false;
+    m_buffer.clear();
+    m_buffer.reserve(bufferSize + UDPSocket::MaxPacketSize + 32);
+    PutU32(m_buffer, magic);
+    PutU32(m_buffer, version);
+    uint64_t now = uint64_t(std::time(nullptr));
+    PutU32(m_buffer, uint32_t(now));
+    PutU32(m_buffer, uint32_t(now >> 32));
+    m_lastTime = Clock::Nanos();
+    m_records.store(0, std::memory_order_relaxed);
+    m_hasFailed = false;
+    return true;
+}
+
+
+bool TrafficRecorder::Close(void) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (not m_file)
+        return not m_hasFailed;
+    Flush();
+    if (fclose(m_file))
+        m_hasFailed = true;
+    m_file = nullptr;
+    return not m_hasFailed;
+}
+
+
+void TrafficRecorder::Record(std::span<const UDPData> packets, uint16_t localPort, bool isSent) {
+    if (packets.empty())
+        return;
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (not m_file)
+        return;
+    int64_t now = std::max(Clock::Nanos(), m_lastTime);
+    for (const UDPData& p : packets) {
+        if ((p.length <= 0) or (p.length > UDPSocket::MaxPacketSize))
+            continue;
+        PutVarUInt(m_buffer, uint64_t(now - m_lastTime));
+        m_lastTime = now;
+        m_buffer.push_back(isSent ? 1 : 0);
+        uint8_t address[6];
+        std::memcpy(address, &p.address.host, 4);
+        std::memcpy(address + 4, &p.address.port, 2);
+        m_buffer.insert(m_buffer.end(), address, address + 6);
+        PutU16(m_buffer, localPort);
+        PutVarUInt(m_buffer, uint64_t(p.length));
+        m_buffer.insert(m_buffer.end(), p.buffer, p.buffer + p.length);
+        m_records.fetch_add(1, std::memory_order_relaxed);
+        if (m_buffer.size() >= bufferSize)
+            Flush();
+    }
+}
+
+
+bool TrafficRecorder::Flush(void) {
+    if (not m_buffer.empty() and (fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size()))
+        m_hasFailed = true;
+    m_buffer.clear();
+    return not m_hasFailed;
+}
+
+// =================================================================================================
+
+bool TrafficReplayer::Open(const char* filename) {
+    m_data.clear();
+    m_records = 0;
+    FILE* f = fopen(filename, "rb");
+    if (not f)
+        return false;
+    bool isValid = (fseek(f, 0, SEEK_END) == 0);
+    long size = isValid ? ftell(f) : -1;
+    if ((size < long(TrafficRecorder::headerSize)) or (fseek(f, 0, SEEK_SET) != 0))
+        isValid = false;
+    else {
+        m_data.resize(size_t(size));
+        isValid = (fread(m_data.data(), 1, m_data.size(), f) == m_data.size());
+    }
+    fclose(f);
+    if (not isValid or (GetU(m_data.data(), 4) != TrafficRecorder::magic) or (GetU(m_data.data() + 4, 4) != TrafficRecorder::version)) {
+        m_data.clear();
+        return false;
+    }
+    m_captureStart = int64_t(GetU(m_data.data() + 8, 8));
+    TrafficRecord record;
+    size_t position = TrafficRecorder::headerSize;
+    while (Next(position, record))
+        ++m_records;
+    m_data.resize(position);   // drop a truncated last record, e.g. of a crashed session
+    return true;
+}
+
+
+bool TrafficReplayer::Next(size_t& position, TrafficRecord& record) const noexcept {
+    static constexpr size_t fixedSize = 1 + 6 + 2;
+    size_t p = position;
+    uint64_t delta, length;
+    if (not GetVarUInt(m_data, p, delta) or (m_data.size() - p < fixedSize))
+        return false;
+    const uint8_t* fields = m_data.data() + p;
+    p += fixedSize;
+    if (not GetVarUInt(m_data, p, length) or (length > uint64_t(UDPSocket::MaxPacketSize)) or (m_data.size() - p < length))
+        return false;
+    record.time = ((position == TrafficRecorder::headerSize) ? 0 : record.time) + int64_t(delta);
+    record.isSent = (fields[0] & 1) != 0;
+    std::memcpy(&record.address.host, fields + 1, 4);
+    std::memcpy(&record.address.port, fields + 5, 2);
+    record.localPort = uint16_t(GetU(fields + 7, 2));
+    record.data = m_data.data() + p;
+    record.length = int(length);
+    position = p + size_t(length);
+    return true;
+}
+
+
+TrafficReplayer::Statistics TrafficReplayer::ReplayMessages(const std::function<void(NetworkMessage&)>& dispatch, Timing timing) {
+    NetworkMessage message;
+    return Replay([&](const TrafficRecord& record) {
+        message.Address() = record.address;
+        message.Payload() = String(reinterpret_cast<const char*>(record.data), record.length);
+        dispatch(message);
+        }, timing);
+}
+
+
+void TrafficReplayer::Summarize(std::vector<int32_t>& handlingTimes, Statistics& stats) noexcept {
+    stats.messages = handlingTimes.size();
+    if (stats.duration > 0)
+        stats.messagesPerSecond = double(stats.messages) * double(Clock::nanosPerSecond) / double(stats.duration);
+    if (handlingTimes.empty())
+        return;
+    size_t n = handlingTimes.size();
+    double sum = 0.0;
+    for (int32_t t : handlingTimes)
+        sum += double(t);
+    size_t p99 = (n * 99 + 99) / 100 - 1;
+    std::nth_element(handlingTimes.begin(), handlingTimes.begin() + p99, handlingTimes.end());
+    stats.meanHandling = float(sum / double(n)) * 0.001f;
+    stats.p99Handling = float(handlingTimes[p99]) * 0.001f;
+    stats.maxHandling = float(*std::max_element(handlingTimes.begin() + p99, handlingTimes.end())) * 0.001f;
+}
+
+// =================================================================================================
@@ -1,27 +1,90 @@
 
+#include <new>
+#include <cstring>
+#include <algorithm>
 #include "udp.h"
 #include "networkendpoint.h"
+#include "trafficcapture.h"
+
+#if UDP_NATIVE_SOCKETS
+#   include <cerrno>
+#   include <unistd.h>
+#   include <sys/socket.h>
+#   include <netinet/in.h>
+#endif
 
 // =================================================================================================
 // UDP based networking
 
-bool UDPSocket::Open(const String& localAddress, uint16_t port) {
+#if UDP_NATIVE_SOCKETS
+
+static inline sockaddr_in ToSockAddr(const IPaddress& address) noexcept {
+    sockaddr_in a{};
+    a.sin_family = AF_INET;
+    a.sin_addr.s_addr = address.host;   // both in network byte order
+    a.sin_port = address.port;
+    return a;
+}
+
+#endif
+
+
+bool UDPSocket::Open(const String& localAddress, uint16_t port, [[maybe_unused]] bool allowLoopback) {
 #ifdef _DEBUG
-    if (localAddress == "127.0.0.1") {
+    if (not allowLoopback and (localAddress == "127.0.0.1")) {
         fprintf(stderr, "UDP OpenSocket: Please specify a valid local network or internet address in the command line or ini file\n");
         return false;
     }
 #endif
     UpdateSocketAddress(localAddress, port);
+    if (not m_ring) {
+        m_ring = new (std::nothrow) uint8_t[size_t(RingSize) * MaxPacketSize];
+        if (not m_ring)
+            return false;
+        m_ringHead = 0;
+    }
+#if UDP_NATIVE_SOCKETS
+    if (m_socket >= 0)
+        Close();
+    if (0 > (m_socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)))
+        return false;
+    int enable = 1;
+    setsockopt(m_socket, SOL_SOCKET, SO_BROADCAST, &enable, sizeof(enable));
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(port);
+    if (0 > bind(m_socket, reinterpret_cast<const sockaddr*>(&local), sizeof(local))) {
+        Close();
+        return false;
+    }
+    if (port == 0) { // report the port the system picked
+        socklen_t l = sizeof(local);
+        if (0 == getsockname(m_socket, reinterpret_cast<sockaddr*>(&local), &l))
+            SetPort(ntohs(local.sin_port));
+    }
+    return true;
+#else
     if (not (m_socket = SDLNet_UDP_Open(port)))
         return false;
     if (not m_packet)
         m_packet = SDLNet_AllocPacket(MaxPacketSize);
     return m_packet != nullptr;
+#endif
 }
 
 
 void UDPSocket::Close(bool destroy) {
+    if (destroy and m_ring) {
+        delete[] m_ring;
+        m_ring = nullptr;
+    }
+#if UDP_NATIVE_SOCKETS
+    if (m_socket >= 0) {
+        close(m_socket);
+        m_socket = -1;
+    }
+#else
     if (destroy and m_packet) {
         SDLNet_FreePacket(m_packet);
         m_packet = nullptr;
@@ -30,56 +93,77 @@ void UDPSocket::Close(bool destroy) {
         SDLNet_UDP_Close(m_socket);
         m_socket = nullptr;
     }
+#endif
 }
 
 
 bool UDPSocket::Bind(void) {
     if (SDLNet_ResolveHost(&m_socketAddress, (char*)m_ipAddress, m_port))
         return false;
+#if UDP_NATIVE_SOCKETS
+    // native sockets always send to an explicit address, so there is no channel to bind
+    m_channel = 0;
+    return IsOpen();
+#else
     m_channel = SDLNet_UDP_Bind(m_socket, -1, &m_socketAddress);
     if (0 > m_channel)
         return false;
     return true;
+#endif
 }
 
 
 void UDPSocket::Unbind(void) {
+#if UDP_NATIVE_SOCKETS
+    m_channel = -1;
+#else
     if (m_socket and (m_channel >= 0)) {
         SDLNet_UDP_Unbind(m_socket, m_channel);
         m_channel = -1;
     }
+#endif
 }
 
 
 bool UDPSocket::Send(const uint8_t* data, int dataLen, const NetworkEndpoint& receiver) {
-    if (not m_socket)
+    if (not IsOpen())
         return false;
-#if 1
+#if UDP_NATIVE_SOCKETS
+    sockaddr_in a = ToSockAddr(receiver.SocketAddress());
+    bool sent = sendto(m_socket, data, size_t(dataLen), 0, reinterpret_cast<const sockaddr*>(&a), sizeof(a)) == dataLen;
+#else
     m_packet->channel = -1;
     m_packet->len = dataLen;
     m_packet->maxlen = MaxPacketSize;
     std::memcpy(m_packet->data, data, dataLen);
     m_packet->address = receiver.SocketAddress();
-    return SDLNet_UDP_Send(m_socket, -1, m_packet) > 0;
-#else
-    int l = int(message.Length());
-    UDPpacket packet = { -1, reinterpret_cast<Uint8*>(message.Data()), l, MaxPacketSize, 0, receiver.SocketAddress() };
-    return SDLNet_UDP_Send(m_socket, -1, &packet) > 0;
+    bool sent = SDLNet_UDP_Send(m_socket, -1, m_packet) > 0;
 #endif
+    if (sent and m_recorder)
+        m_recorder->Record(UDPData{ const_cast<uint8_t*>(data), dataLen, receiver.SocketAddress() }, GetPort(), true);
+    return sent;
 }
 
 
 UDPData UDPSocket::Receive(int minLength) { // return sender address in message.Address()
+#if UDP_NATIVE_SOCKETS
+    UDPData data{ nullptr, 0 };
+    return ReceiveBatch(std::span<UDPData>(&data, 1), minLength) ? data : UDPData{ nullptr, 0 };
+#else
     if (not (m_socket and m_packet))
         return { nullptr, 0 };
     int n = SDLNet_UDP_Recv(m_socket, m_packet);
     if ((n <= 0) or (m_packet->len > MaxPacketSize))
         return { nullptr, 0 };
-    if ((SocketAddress().host == m_packet->address.host) and (SocketAddress().port == m_packet->address.port))
+    if (IsOwnAddress(m_packet->address))
         return { nullptr, 0 };
     if ((minLength > 0) and (m_packet->len < minLength))
         return { nullptr, 0 };
-    return { m_packet->data, m_packet->len };
+    UDPData data{ m_packet->data, m_packet->len, m_packet->address };
+    if (m_recorder)
+        m_recorder->Record(data, GetPort(), false);
+    return data;
+#endif
 }
 
 
@@ -87,12 +171,133 @@ bool UDPSocket::Receive(NetworkMessage& message) { // return sender address in m
     UDPData data = Receive();
     if (not data.length)
         return false;
-    message.Address() = m_packet->address;
-    message.Payload() = String((const char*)m_packet->data, m_packet->len);
+    message.Address() = data.address;
+    message.Payload() = String((const char*)data.buffer, data.length);
     return true;
 }
 
 
+int UDPSocket::ReceiveBatch(std::span<UDPData> packets, int minLength) {
+    if (not (IsOpen() and m_ring))
+        return 0;
+    // one batch never wraps around the ring, so its buffers don't overwrite each other
+    int limit = int(std::min(packets.size(), size_t(RingSize)));
+    int count = 0;
+#if UDP_NATIVE_SOCKETS
+    mmsghdr messages[MaxBatchSize];
+    iovec buffers[MaxBatchSize];
+    sockaddr_in senders[MaxBatchSize];
+    for (int used = 0; count < limit; ) { // skipped datagrams use up ring buffers, too
+        int n = std::min({ limit - count, RingSize - used, MaxBatchSize });
+        if (n <= 0)
+            break;
+        for (int i = 0; i < n; ++i) {
+            buffers[i] = iovec{ RingBuffer((m_ringHead + i) % RingSize), size_t(MaxPacketSize) };
+            messages[i] = mmsghdr{};
+            messages[i].msg_hdr.msg_name = &senders[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(senders[i]);
+            messages[i].msg_hdr.msg_iov = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        int received = recvmmsg(m_socket, messages, unsigned(n), MSG_DONTWAIT, nullptr);
+        if (received <= 0)
+            break;
+        for (int i = 0; i < received; ++i) {
+            int length = int(messages[i].msg_len);
+            if (messages[i].msg_hdr.msg_flags & MSG_TRUNC)
+                continue;
+            IPaddress sender{ senders[i].sin_addr.s_addr, senders[i].sin_port };
+            if (IsOwnAddress(sender) or ((minLength > 0) and (length < minLength)))
+                continue;
+            packets[count++] = UDPData{ static_cast<uint8_t*>(buffers[i].iov_base), length, sender };
+        }
+        m_ringHead = (m_ringHead + received) % RingSize;
+        used += received;
+        if (received < n)
+            break;
+    }
+#else
+    while ((count < limit) and (SDLNet_UDP_Recv(m_socket, m_packet) > 0)) {
+        if ((m_packet->len > MaxPacketSize) or IsOwnAddress(m_packet->address) or ((minLength > 0) and (m_packet->len < minLength)))
+            continue;
+        uint8_t* buffer = RingBuffer(m_ringHead);
+        m_ringHead = (m_ringHead + 1) % RingSize;
+        std::memcpy(buffer, m_packet->data, m_packet->len);
+        packets[count++] = UDPData{ buffer, m_packet->len, m_packet->address };
+    }
+#endif
+    if (m_recorder and count)
+        m_recorder->Record(packets.first(size_t(count)), GetPort(), false);
+    return count;
+}
+
+
+int UDPSocket::SendBatch(std::span<const UDPData> packets) {
+    if (not IsOpen())
+        return 0;
+    int count = 0;
+    m_isSendBlocked = false;
+#if UDP_NATIVE_SOCKETS
+    mmsghdr messages[MaxBatchSize];
+    iovec buffers[MaxBatchSize];
+    sockaddr_in receivers[MaxBatchSize];
+    while (count < int(packets.size())) {
+        int n = std::min(int(packets.size()) - count, MaxBatchSize);
+        for (int i = 0; i < n; ++i) {
+            const UDPData& p = packets[count + i];
+            buffers[i] = iovec{ p.buffer, size_t(p.length) };
+            receivers[i] = ToSockAddr(p.address);
+            messages[i] = mmsghdr{};
+            messages[i].msg_hdr.msg_name = &receivers[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(receivers[i]);
+            messages[i].msg_hdr.msg_iov = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        // after a partial send, the next call fails at the refused packet and tells why
+        int sent = sendmmsg(m_socket, messages, unsigned(n), MSG_DONTWAIT);
+        if (sent <= 0) {
+            m_isSendBlocked = (sent < 0) and ((errno == EAGAIN) or (errno == EWOULDBLOCK));
+            break;
+        }
+        count += sent;
+    }
+#else
+    for (const UDPData& p : packets) {
+        if (p.length > MaxPacketSize)
+            break;
+        m_packet->channel = -1;
+        m_packet->len = p.length;
+        m_packet->maxlen = MaxPacketSize;
+        std::memcpy(m_packet->data, p.buffer, p.length);
+        m_packet->address = p.address;
+        if (SDLNet_UDP_Send(m_socket, -1, m_packet) <= 0)
+            break;
+        ++count;
+    }
+#endif
+    if (m_recorder and count)
+        m_recorder->Record(packets.first(size_t(count)), GetPort(), true);
+    return count;
+}
+
+
+bool UDPSocket::SetBufferSizes(int receiveSize, int sendSize) {
+#if UDP_NATIVE_SOCKETS
+    if (m_socket < 0)
+        return false;
+    bool result = true;
+    if ((receiveSize > 0) and (0 > setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &receiveSize, sizeof(receiveSize))))
+        result = false;
+    if ((sendSize > 0) and (0 > setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF, &sendSize, sizeof(sendSize))))
+        result = false;
+    return result;
+#else
+    // SDL_net doesn't expose the socket
+    return (receiveSize <= 0) and (sendSize <= 0);
+#endif
+}
+
+
 bool UDPSocket::SendBroadcast(const uint8_t* data, int dataLen, uint16_t destPort, bool subnetOnly) {
     // Empfnger bestimmen
     NetworkEndpoint destination = subnetOnly ? DirectedBroadcast(destPort) : NetworkEndpoint::LimitedBroadcast(destPort);
@@ -1,17 +1,22 @@
 #pragma once
 
-#include <algorithm>
+#include <cstddef>
 #include "std_defines.h"
 
-#include "memorymanager.h"
+#include "sizeclassallocator.h"
 
-#define DEBUG_MALLOC 0
+// SIZE_CLASS_MALLOC 1 routes the allocations of classes derived from Allocator and of the global
+// operator new/delete through the SizeClassAllocator; 0 leaves them to the system allocator.
+// Switch it to compare both allocators on the same workload (SizeClassAllocator::PrintStats()).
+#ifndef SIZE_CLASS_MALLOC
+#	define SIZE_CLASS_MALLOC 0
+#endif
 
 // =================================================================================================
 
 class Allocator {
 public:
-#if DEBUG_MALLOC
+#if SIZE_CLASS_MALLOC
 	static void* operator new(std::size_t size);
 
 	static void operator delete(void* ptr) noexcept;
@@ -11,17 +11,10 @@ public:
     AVLNode*    right;
     char        balance;
     int         visited;
-#if DEBUG_MALLOC
-    int         poolIndex;
-#endif
 
     AVLNode() noexcept
         : left(nullptr), right(nullptr), balance(0), visited(0)
-#if DEBUG_MALLOC
-        , poolIndex(-1)
-#endif
     {
-#if !DEBUG_MALLOC
         if constexpr (std::is_trivially_constructible<DATA_T>::value)
             memset(&data, 0, sizeof(DATA_T));
         else
@@ -30,22 +23,15 @@ public:
             memset(&key, 0, sizeof(KEY_T));
         else
             key = KEY_T{};
-#endif
     }
 
     AVLNode(const KEY_T& k, const DATA_T& d) noexcept(std::is_nothrow_copy_constructible<KEY_T>::value&& std::is_nothrow_copy_constructible<DATA_T>::value)
         : key(k), data(d), left(nullptr), right(nullptr), balance(0), visited(0)
-#if DEBUG_MALLOC
-        , poolIndex(-1)
-#endif
     {
     }
 
     AVLNode(KEY_T&& k, DATA_T&& d) noexcept(std::is_nothrow_move_constructible<KEY_T>::value&& std::is_nothrow_move_constructible<DATA_T>::value)
         : key(std::move(k)), data(std::move(d)), left(nullptr), right(nullptr), balance(0), visited(0)
-#if DEBUG_MALLOC
-        , poolIndex(-1)
-#endif
     {
     }
 
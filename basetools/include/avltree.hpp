@@ -14,14 +14,18 @@
 
 #pragma once
 
+#include <span>
 #include <utility>
 #include <memory>
+#include <cstddef>
+#include <iterator>
 #include <stdexcept>
 #include <functional>
 #include <type_traits>
 #include <cstring>
 #include "avltreetraits.h"
 #include "type_helper.hpp"
+#include "nodepool.hpp"
 
 // =================================================================================================
 
@@ -31,6 +35,11 @@
 
 #define RELINK_DELETED_NODE 0
 
+// allocate nodes from slabs owned by the tree instead of allocating each node on the heap
+#ifndef AVL_NODE_POOL
+#   define AVL_NODE_POOL 1
+#endif
+
 // =================================================================================================
 
 template <typename KEY_T, typename DATA_T>
@@ -44,6 +53,138 @@ public:
 
 #include "avlnode.hpp"
 
+    //-----------------------------------------------------------------------------
+    // In-order iterator. Nodes have no parent links, so the iterator keeps the path from the root to
+    // the current node on a fixed size stack; iterating neither allocates nor recurses. Iterators are
+    // invalidated by inserting or removing nodes.
+
+    template <bool IS_CONST>
+    class NodeIterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = AVLNode;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IS_CONST, const AVLNode*, AVLNode*>;
+        using reference = std::conditional_t<IS_CONST, const AVLNode&, AVLNode&>;
+
+        // an AVL tree with less than 2^32 nodes is at most 46 levels high
+        static constexpr int maxDepth = 48;
+
+    private:
+        AVLNode*    m_root{ nullptr };
+        AVLNode*    m_path[maxDepth];
+        int         m_depth{ 0 };   // 0: end()
+
+    public:
+        NodeIterator() noexcept = default;
+
+        explicit NodeIterator(AVLNode* root) noexcept
+            : m_root(root)
+        { }
+
+        template <bool OTHER_CONST>
+            requires (IS_CONST and not OTHER_CONST)
+        NodeIterator(const NodeIterator<OTHER_CONST>& other) noexcept
+            : m_root(other.m_root), m_depth(other.m_depth)
+        {
+            std::copy(other.m_path, other.m_path + other.m_depth, m_path);
+        }
+
+        inline reference operator*() const noexcept {
+            return *m_path[m_depth - 1];
+        }
+
+        inline pointer operator->() const noexcept {
+            return m_path[m_depth - 1];
+        }
+
+        NodeIterator& operator++() noexcept {
+            AVLNode* node = m_path[m_depth - 1];
+            if (node->right)
+                DescendLeft(node->right);
+            else { // go up until coming from a left subtree
+                AVLNode* child;
+                do
+                    child = m_path[--m_depth];
+                while (m_depth and (m_path[m_depth - 1]->right == child));
+            }
+            return *this;
+        }
+
+        NodeIterator& operator--() noexcept {
+            if (not m_depth)
+                DescendRight(m_root);
+            else if (m_path[m_depth - 1]->left)
+                DescendRight(m_path[m_depth - 1]->left);
+            else { // go up until coming from a right subtree
+                AVLNode* child;
+                do
+                    child = m_path[--m_depth];
+                while (m_depth and (m_path[m_depth - 1]->left == child));
+            }
+            return *this;
+        }
+
+        inline NodeIterator operator++(int) noexcept {
+            NodeIterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        inline NodeIterator operator--(int) noexcept {
+            NodeIterator it = *this;
+            --*this;
+            return it;
+        }
+
+        template <bool OTHER_CONST>
+        inline bool operator==(const NodeIterator<OTHER_CONST>& other) const noexcept {
+            return Node() == other.Node();
+        }
+
+        inline AVLNode* Node(void) const noexcept {
+            return m_depth ? m_path[m_depth - 1] : nullptr;
+        }
+
+    private:
+        inline void DescendLeft(AVLNode* node) noexcept {
+            for (; node; node = node->left)
+                m_path[m_depth++] = node;
+        }
+
+        inline void DescendRight(AVLNode* node) noexcept {
+            for (; node; node = node->right)
+                m_path[m_depth++] = node;
+        }
+
+        template <bool>
+        friend class NodeIterator;
+
+        friend class AVLTree;
+    };
+
+    using Iterator = NodeIterator<false>;
+    using ConstIterator = NodeIterator<true>;
+
+    // iterator pair for range based for loops over a part of the tree
+    template <typename ITERATOR_T>
+    class NodeRange {
+    private:
+        ITERATOR_T  m_first;
+        ITERATOR_T  m_last;
+
+    public:
+        NodeRange(ITERATOR_T first, ITERATOR_T last) noexcept
+            : m_first(first), m_last(last)
+        { }
+
+        inline ITERATOR_T begin(void) const noexcept { return m_first; }
+
+        inline ITERATOR_T end(void) const noexcept { return m_last; }
+
+        inline bool IsEmpty(void) const noexcept { return m_first == m_last; }
+    };
+
 //-----------------------------------------------------------------------------
 
 private:
@@ -55,7 +196,6 @@ private:
         KEY_T       workingKey;
         DATA_T      workingData;
         Comparator  compareNodes;
-        std::function<bool(const KEY_T&, DATA_T*)>  processNode;
         void*       context;
         int         visited;
         bool        isDuplicate;
@@ -73,7 +213,6 @@ private:
             , workingParent(nullptr)
             , nodeCount(0)
             , compareNodes(nullptr)
-            , processNode(nullptr)
             , context(nullptr)
             , visited(0)
             , isDuplicate(false)
@@ -94,14 +233,25 @@ private:
 
 private:
     tAVLTreeInfo            m_info;
+#if AVL_NODE_POOL
+    NodePool<AVLNode>       m_nodePool;
+#endif
 
     //-----------------------------------------------------------------------------
 
 public:
 #pragma warning(push)
 #pragma warning(disable:4100)
-    AVLTree(int capacity = 0) noexcept
+    // capacity: expected node count. With the node pool enabled, it is preallocated as a single slab
+    // and determines the size of further slabs.
+    AVLTree(int capacity = 0)
     {
+#if AVL_NODE_POOL
+        if (capacity > 0) {
+            m_nodePool.SetSlabSize(capacity);
+            m_nodePool.Reserve(capacity);
+        }
+#endif
     }
 #pragma warning(pop)
 
@@ -109,6 +259,18 @@ public:
         Clear();
     }
 
+    // make room for nodeCount nodes without further allocations
+#pragma warning(push)
+#pragma warning(disable:4100)
+    inline bool Reserve(int nodeCount) {
+#if AVL_NODE_POOL
+        return m_nodePool.Reserve(nodeCount);
+#else
+        return true;
+#endif
+    }
+#pragma warning(pop)
+
     inline void SetComparator(Comparator compareNodes, void* context = nullptr) noexcept {
         m_info.compareNodes = compareNodes;
         m_info.context = context;
@@ -190,18 +352,38 @@ public:
     //-----------------------------------------------------------------------------
 
 private:
+    template <typename... ARGS>
+    AVLNode* NewNode(ARGS&&... args)
+    {
+#if AVL_NODE_POOL
+        AVLNode* node = m_nodePool.New(std::forward<ARGS>(args)...);
+        if (not node)
+            return nullptr;
+#else
+        AVLNode* node = new AVLNode(std::forward<ARGS>(args)...);
+#endif
+        ++m_info.nodeCount;
+        return node;
+    }
+
+    //-----------------------------------------------------------------------------
+
     AVLNode* AllocNode(void)
     {
-        m_info.workingNode = new AVLNode();
+        if (not (m_info.workingNode = NewNode()))
+            return nullptr;
         m_info.workingNode->key = std::move(m_info.workingKey);
-        ++m_info.nodeCount;
         return m_info.workingNode;
     }
 
     //-----------------------------------------------------------------------------
 
     void DeleteNode(AVLNode*& node) noexcept {
+#if AVL_NODE_POOL
+        m_nodePool.Delete(node);
+#else
         delete node;
+#endif
         node = nullptr;
         --m_info.nodeCount;
     }
@@ -598,39 +780,161 @@ private:
     //-----------------------------------------------------------------------------
 
 public:
+    // remove all nodes. Node memory is kept for reuse.
     void Clear(void) noexcept
     {
         DestroyNodes(m_info.root);
+#if AVL_NODE_POOL
+        m_nodePool.Recycle();
+#endif
+    }
+
+    // remove all nodes and return their memory
+    void Destroy(void) noexcept
+    {
+        Clear();
+#if AVL_NODE_POOL
+        m_nodePool.Destroy();
+#endif
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    inline Iterator begin(void) noexcept {
+        Iterator it(m_info.root);
+        it.DescendLeft(m_info.root);
+        return it;
+    }
+
+    inline Iterator end(void) noexcept {
+        return Iterator(m_info.root);
+    }
+
+    inline ConstIterator begin(void) const noexcept {
+        ConstIterator it(m_info.root);
+        it.DescendLeft(m_info.root);
+        return it;
+    }
+
+    inline ConstIterator end(void) const noexcept {
+        return ConstIterator(m_info.root);
     }
 
     //-----------------------------------------------------------------------------
 
 private:
-    bool WalkNodes(AVLNode* root)
+    // first node with a key >= key (upper: > key)
+    template <typename ITERATOR_T>
+    ITERATOR_T Bound(const KEY_T& key, bool upper) const
     {
-        if (root) {
-            if (root->visited == m_info.visited)
-                return false;
-            root->visited = m_info.visited;
-            if (not WalkNodes(root->left))
-                return false;
-            if (not m_info.processNode(root->key, std::addressof(root->data)))
-                return false;
-            if (not WalkNodes(root->right))
+        ITERATOR_T it(m_info.root);
+        int depth = 0;
+        for (AVLNode* node = m_info.root; node; ) {
+            it.m_path[it.m_depth++] = node;
+            int rel = m_info.compareNodes(m_info.context, key, node->key);
+            if (upper ? (rel < 0) : (rel <= 0)) { // candidate; a closer one can only be in the left subtree
+                depth = it.m_depth;
+                node = node->left;
+            }
+            else
+                node = node->right;
+        }
+        it.m_depth = depth;
+        return it;
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    // first node with a key not less than key
+    inline Iterator LowerBound(const KEY_T& key) {
+        return Bound<Iterator>(key, false);
+    }
+
+    inline ConstIterator LowerBound(const KEY_T& key) const {
+        return Bound<ConstIterator>(key, false);
+    }
+
+    // first node with a key greater than key
+    inline Iterator UpperBound(const KEY_T& key) {
+        return Bound<Iterator>(key, true);
+    }
+
+    inline ConstIterator UpperBound(const KEY_T& key) const {
+        return Bound<ConstIterator>(key, true);
+    }
+
+    // all nodes with lo <= key <= hi, in key order
+    NodeRange<Iterator> Range(const KEY_T& lo, const KEY_T& hi) {
+        if (not m_info.root or (m_info.compareNodes(m_info.context, lo, hi) > 0))
+            return NodeRange<Iterator>(end(), end());
+        return NodeRange<Iterator>(LowerBound(lo), UpperBound(hi));
+    }
+
+    NodeRange<ConstIterator> Range(const KEY_T& lo, const KEY_T& hi) const {
+        if (not m_info.root or (m_info.compareNodes(m_info.context, lo, hi) > 0))
+            return NodeRange<ConstIterator>(end(), end());
+        return NodeRange<ConstIterator>(LowerBound(lo), UpperBound(hi));
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    // Call processor(key, data) for all nodes in key order until it returns false.
+    // Returns false if the walk was stopped by the processor.
+    template <typename FUNC_T>
+    bool Walk(FUNC_T&& processor)
+    {
+        for (AVLNode& node : *this) {
+            if (not processor(static_cast<const KEY_T&>(node.key), std::addressof(node.data)))
                 return false;
         }
         return true;
     }
 
+    template <class Context>
+    inline bool Walk(bool (Context::* processor)(const KEY_T&, DATA_T*), Context* context)
+    {
+        return Walk([processor, context](const KEY_T& key, DATA_T* data) { return (context->*processor)(key, data); });
+    }
+
+    //-----------------------------------------------------------------------------
+
+private:
+    AVLNode* BuildNodes(const std::pair<KEY_T, DATA_T>* items, int count, int& height)
+    {
+        if (count == 0) {
+            height = 0;
+            return nullptr;
+        }
+        int m = count / 2;
+        AVLNode* node = NewNode(items[m].first, items[m].second);
+        if (not node)
+            return nullptr;
+        int leftHeight, rightHeight;
+        node->left = BuildNodes(items, m, leftHeight);
+        node->right = BuildNodes(items + m + 1, count - m - 1, rightHeight);
+        node->balance = char(rightHeight - leftHeight);
+        height = std::max(leftHeight, rightHeight) + 1;
+        return node;
+    }
+
     //-----------------------------------------------------------------------------
 
 public:
-    template <class Context>
-    bool Walk(bool (Context::* processor)(const KEY_T&, DATA_T*), Context* context)
+    // Replace the tree's content by items, which must be sorted by ascending key (according to the
+    // tree's comparator) without duplicates. Builds a perfectly balanced tree in O(n) without any
+    // comparisons or rebalancing.
+    bool BuildFromSorted(std::span<const std::pair<KEY_T, DATA_T>> items)
     {
-        m_info.processNode = [processor, context](const KEY_T& key, DATA_T* data) { return (context->*processor)(key, data); };
-        m_info.visited++;
-        return WalkNodes(m_info.root);
+        Clear();
+        int count = int(items.size());
+        if (not Reserve(count))
+            return false;
+        int height;
+        m_info.root = BuildNodes(items.data(), count, height);
+        return true;
     }
 
     //-----------------------------------------------------------------------------
@@ -767,13 +1071,6 @@ public:
 
     //-----------------------------------------------------------------------------
 
-private:
-    bool CopyData(const KEY_T& key, DATA_T* data) {
-        return Insert(key, *data);
-    }
-
-    //-----------------------------------------------------------------------------
-
 public:
     AVLTree(AVLTree& other) {
         Copy(other);
@@ -790,9 +1087,10 @@ public:
         return *this;
     }
 
-    inline AVLTree& Copy(AVLTree& other)
+    AVLTree& Copy(const AVLTree& other)
     {
-        other.Walk(&AVLTree::CopyData, this);
+        for (const AVLNode& node : other)
+            Insert(node.key, node.data);
         return *this;
     }
 };
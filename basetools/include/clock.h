@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER) and (defined(_M_X64) or defined(_M_IX86))
+#   include <intrin.h>
+#endif
+
+#if defined(__x86_64__) or defined(_M_X64) or defined(__i386__) or defined(_M_IX86)
+#   define CLOCK_HAS_TSC 1
+#else
+#   define CLOCK_HAS_TSC 0
+#endif
+
+// =================================================================================================
+// Monotonic time stamps in nanoseconds for timers, frame pacing and profiling.
+// If the CPU has an invariant TSC (and, on Linux, the kernel uses it as its clocksource, i.e. it
+// found the TSCs of all cores synchronized and stable), the TSC is calibrated against the monotonic
+// OS clock on first use (which takes about 10 ms), and a time stamp costs one rdtsc and a fixed
+// point multiplication. Otherwise Clock reads the OS clock: CLOCK_MONOTONIC_RAW on Linux, the
+// performance counter (with the same fixed point conversion) on Windows.
+// Times start near the monotonic OS clock (CLOCK_MONOTONIC on Linux), but may drift from it by the
+// calibration error (a few ppm): only differences of Clock times are meaningful, and deadlines for
+// OS waits must be converted to relative durations (see HiresSleep).
+
+class Clock {
+public:
+    enum class Source : int32_t {
+        TSC,
+        OS
+    };
+
+    static constexpr int64_t nanosPerSecond = 1000000000;
+    static constexpr uint32_t fractionBits = 32;   // of the tick to nanosecond multiplier
+
+    struct Calibration {
+        Source      source;
+        uint64_t    baseTicks;
+        int64_t     baseNanos;
+        uint64_t    multiplier;     // nanoseconds per tick, fixed point with fractionBits
+        double      ticksPerSecond;
+    };
+
+private:
+    static Calibration Calibrate(void) noexcept;
+
+    static inline int64_t Scale(int64_t ticks, uint64_t multiplier) noexcept {
+#if defined(_MSC_VER) and defined(_M_X64)
+        int64_t hi;
+        uint64_t lo = uint64_t(_mul128(ticks, int64_t(multiplier), &hi));
+        return int64_t((uint64_t(hi) << (64 - fractionBits)) | (lo >> fractionBits));
+#elif defined(__SIZEOF_INT128__)
+        return int64_t((__int128(ticks) * __int128(multiplier)) >> fractionBits);
+#else
+        return int64_t(double(ticks) * double(multiplier) * (1.0 / double(uint64_t(1) << fractionBits)));
+#endif
+    }
+
+public:
+    static inline uint64_t ReadTSC(void) noexcept {
+#if defined(_MSC_VER) and CLOCK_HAS_TSC
+        return __rdtsc();
+#elif CLOCK_HAS_TSC
+        return __builtin_ia32_rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    // the OS clock's ticks: nanoseconds on Linux, performance counter ticks on Windows
+    static uint64_t ReadOSTicks(void) noexcept;
+
+    // current time in nanoseconds
+    static inline int64_t Nanos(void) noexcept {
+        const Calibration& c = Calibrated();
+#if CLOCK_HAS_TSC
+        if (c.source == Source::TSC)
+            return c.baseNanos + Scale(int64_t(ReadTSC() - c.baseTicks), c.multiplier);
+#endif
+#ifdef _WIN32
+        return c.baseNanos + Scale(int64_t(ReadOSTicks() - c.baseTicks), c.multiplier);
+#else
+        return int64_t(ReadOSTicks());
+#endif
+    }
+
+    static inline int64_t Micros(void) noexcept {
+        return Nanos() / 1000;
+    }
+
+    static inline Source ActiveSource(void) noexcept {
+        return Calibrated().source;
+    }
+
+    // calibrates on first use
+    static inline const Calibration& Calibrated(void) noexcept {
+        static const Calibration calibration = Calibrate();
+        return calibration;
+    }
+
+    static const char* SourceName(Source source) noexcept;
+};
+
+// =================================================================================================
@@ -8,6 +8,7 @@
 
 #include "sharedpointer.hpp"
 #include "quicksort.hpp"
+#include "allocator.h"
 
 #define sizeofa(_a)	((sizeof(_a) / sizeof(*(_a))))
 
@@ -100,7 +101,7 @@ template < typename DATA_T, typename POINTER_T = DATA_T* >
 class AutoArray
 	: public ArrayBuffer<DATA_T, POINTER_T>
 	, public QuickSort < DATA_T >
-#if DEBUG_MALLOC 
+#if SIZE_CLASS_MALLOC
 	, public Allocator
 #endif
 {
@@ -711,7 +712,7 @@ public:
 
 	inline void SortAscending(int32_t left = 0, int32_t right = 0) {
 		if (Data())
-			QuickSort<DATA_T>::SortAscending(Data(), left, (right = 0) ? right : m_info.capacity - 1);
+			QuickSort<DATA_T>::SortAscending(Data(), left, (right > 0) ? right : m_info.capacity - 1);
 	}
 
 	// ----------------------------------------
@@ -737,6 +738,15 @@ public:
 
 	// ----------------------------------------
 
+	// less(a, b) returns a < b; it is inlined by the sorter
+	template <typename LESS_T>
+	inline void Sort(LESS_T less, int32_t left = 0, int32_t right = 0) {
+		if (Data())
+			Sorter::Introsort(Data() + left, ((right > 0) ? right : m_info.capacity - 1) - left + 1, less);
+	}
+
+	// ----------------------------------------
+
 	template<typename KEY_T>
 	inline int32_t Find(KEY_T const& key, int(__cdecl* compare) (DATA_T const&, KEY_T const&), int32_t left = 0, int32_t right = 0) {
 		return Data() ? this->BinSearch(Data(), key, compare, left, (right > 0) ? right : m_info.capacity - 1) : -1;
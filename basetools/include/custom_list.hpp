@@ -422,11 +422,6 @@ protected:
 	ListNodePtr	m_tailPtr;
 	ItemType*	m_none;
 
-	// holds a copy of the median data for sorting; one global variable should work 
-	// as it is only used during the sorting part and not during the recursive descent
-	ItemType	m_median;
-	tComparator	m_compare;
-
 	int32_t		m_length;
 	bool		m_result;
 	bool		m_isValid;
@@ -885,74 +880,108 @@ public:
 	}
 
 	//-----------------------------------------------------------------------------
+	// Stable bottom up merge sort. Nodes are relinked; items are neither copied nor moved and no memory
+	// is allocated. Runs of 2^i nodes are kept in a fixed set of bins, like carrying in a binary counter,
+	// so there is no recursion and no random access. less(a, b) returns a < b.
 
-	inline void Swap(ItemType* left, ItemType* right)
-	{
-		ItemType h;
-		memcpy(&h, left, sizeof(ItemType));
-		memcpy(left, right, sizeof(ItemType));
-		memcpy(right, &h, sizeof(ItemType));
-		memset(&h, 0, sizeof(ItemType));
+public:
+	template <typename LESS_T = std::less<ItemType>>
+	void Sort(LESS_T less = LESS_T()) {
+		if (m_length < 2)
+			return;
+		ListNode* bins[64] = {};
+		int32_t binCount = 0;
+		for (ListNode* node = DetachChain(); node; ) {
+			ListNode* carry = node;
+			node = node->m_succ.m_nodePtr;
+			carry->m_succ = nullptr;
+			int32_t i = 0;
+			for (; bins[i]; ++i) { // bins[i] holds earlier items than carry
+				carry = MergeChains(bins[i], carry, less);
+				bins[i] = nullptr;
+			}
+			bins[i] = carry;
+			if (i == binCount)
+				++binCount;
+		}
+		ListNode* chain = nullptr;
+		for (int32_t i = 0; i < binCount; ++i) {
+			if (bins[i])
+				chain = chain ? MergeChains(bins[i], chain, less) : bins[i];
+		}
+		AttachChain(chain);
 	}
 
-	//-----------------------------------------------------------------------------
 
-	ItemType& GetMedian(ListNodePtr p, int i) {
-		for (; i; i--)
-			p++;
-		return p->DataValue();
+	void SortAscending(tComparator compare) {
+		Sort([compare](const ItemType& a, const ItemType& b) { return compare(&a, &b) < 0; });
 	}
 
-	//-----------------------------------------------------------------------------
 
-	void Sort(ListNodePtr leftNode, ListNodePtr rightNode, int32_t left, int32_t right, int direction)
-	{
-		int32_t		l = left,
-					r = right;
-		ListNodePtr	ln = leftNode,
-					rn = rightNode;
-
-		MemCpy(&m_median, GetMedian(left, (l + r) / 2), sizeof(ItemType));
-		do {
-			while (direction * m_compare(ln->DataPointer(), &m_median) < 0) {
-				++l;
-				++ln;
-			}
-			while (direction * m_compare(rn->DataPointer(), &m_median) > 0) {
-				--r;
-				--rn;
-			}
-			if (l <= r) {
-				if (l < r)
-					Swap(l->DataValue(), r->DataValue());
-				l++;
-				r--;
-			}
-		} while (l <= r);
-		memset(&m_median, 0, sizeof(ItemType));
-
-		if (l < right)
-			Sort(ln, rightNode, l, right, direction);
-		if (left < r)
-			Sort(leftNode, rn, left, r, direction);
+	void SortDescending(tComparator compare) {
+		Sort([compare](const ItemType& a, const ItemType& b) { return compare(&a, &b) > 0; });
 	}
 
 	//-----------------------------------------------------------------------------
+	// Merge other, which must be sorted by the same comparator, into this sorted list by relinking its
+	// nodes. Of equal items, those of this list come first. other is left empty.
 
-	void SortDescending(tComparator compare)
-	{
-		m_compare = compare;
-		Sort(First(), Last(), m_length - 1, -1);
+public:
+	template <typename LESS_T = std::less<ItemType>>
+	List<ItemType>& Merge(List<ItemType>&& other, LESS_T less = LESS_T()) {
+		if ((this == &other) or not IsAvailable() or not other.IsAvailable() or other.IsEmpty())
+			return *this;
+		AttachChain(MergeChains(DetachChain(), other.DetachChain(), less));
+		return *this;
 	}
 
 	//-----------------------------------------------------------------------------
 
-	void SortAscending(tComparator compare)
-	{
-		if (m_length > 1) {
-			m_compare = compare;
-			Sort(m_headPtr->Succ(), m_tailPtr->Pred(), m_length, -1);
+private:
+	// Take the nodes out of the list as a nullptr terminated chain linked by m_succ only.
+	ListNode* DetachChain(void) {
+		if (not m_length)
+			return nullptr;
+		ListNode* chain = m_head->m_succ.m_nodePtr;
+		m_tail->m_pred.m_nodePtr->m_succ = nullptr;
+		m_head->m_succ = m_tail;
+		m_tail->m_pred = m_head;
+		m_length = 0;
+		return chain;
+	}
+
+	// Link a chain created by DetachChain() between head and tail, restoring the m_pred links
+	void AttachChain(ListNode* chain) {
+		ListNode* pred = m_head;
+		int32_t length = 0;
+		for (ListNode* node = chain; node; node = node->m_succ.m_nodePtr, ++length) {
+			pred->m_succ = node;
+			node->m_pred = pred;
+			pred = node;
+		}
+		pred->m_succ = m_tail;
+		m_tail->m_pred = pred;
+		m_length = length;
+	}
+
+	// Merge two sorted chains; of equal items, those of a come first
+	template <typename LESS_T>
+	static ListNode* MergeChains(ListNode* a, ListNode* b, LESS_T& less) {
+		ListNode* chain = nullptr;
+		ListNode** link = &chain;
+		while (a and b) {
+			if (less(b->DataItem(), a->DataItem())) {
+				*link = b;
+				b = b->m_succ.m_nodePtr;
+			}
+			else {
+				*link = a;
+				a = a->m_succ.m_nodePtr;
+			}
+			link = &(*link)->m_succ.m_nodePtr;
 		}
+		*link = a ? a : b;
+		return chain;
 	}
 
 	//-----------------------------------------------------------------------------
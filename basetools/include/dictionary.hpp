@@ -1,6 +1,13 @@
 #pragma once
 
-#if (USE_STD || USE_STD_MAP)
+#if USE_FLAT_MAP
+
+#	include "flatmap.hpp"
+
+template <typename KEY_T, typename DATA_T>
+using Dictionary = FlatMap<KEY_T, DATA_T>;
+
+#elif (USE_STD || USE_STD_MAP)
 
 #	include "std_map.hpp"
 
@@ -9,7 +16,7 @@ using Dictionary = StdMap<KEY_T, DATA_T>;
 
 #else
 
-#	include "dictionary.hpp"
+#	include "avltree.hpp"
 
 template <typename KEY_T, typename DATA_T>
 using Dictionary = AVLTree<KEY_T, DATA_T>;
@@ -0,0 +1,512 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <new>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <type_traits>
+#include <initializer_list>
+
+#include "avltreetraits.h"
+
+// =================================================================================================
+// Open addressing hash map (Robin Hood hashing with backward shift deletion).
+// Entries are stored in one contiguous array; a parallel byte array holds each slot's probe
+// distance (0: empty slot). Lookups stop as soon as they meet an entry that is closer to its
+// home slot than the key being searched would be.
+// Interface follows AVLTree/StdMap so FlatMap can serve as Dictionary backend. Unlike the tree
+// backends, pointers to entries are only valid until the next Insert/Remove.
+// If a comparator is set, it is used to test keys for equality; otherwise keys are compared
+// with operator== (or operator< if that is all a key provides).
+
+inline uint64_t HashMix64(uint64_t h) noexcept {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+
+inline uint64_t HashBytes(const void* data, size_t length, uint64_t seed = 0x9e3779b97f4a7c15ULL) noexcept {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    uint64_t h = seed ^ (uint64_t(length) * 0xff51afd7ed558ccdULL);
+    for (; length >= 8; p += 8, length -= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (h ^ HashMix64(w)) * 0xc4ceb9fe1a85ec53ULL;
+    }
+    if (length) {
+        uint64_t w = 0;
+        memcpy(&w, p, length);
+        h = (h ^ HashMix64(w)) * 0xc4ceb9fe1a85ec53ULL;
+    }
+    return HashMix64(h);
+}
+
+// =================================================================================================
+// Default hash function: integral and pointer keys are mixed directly, string keys (providing
+// Data() and Length()) and float vectors (providing X()) are hashed by content, other keys have
+// to be plain data and are hashed by their object representation. Specialize FlatMapHash for
+// keys that don't fit these categories.
+
+template <typename KEY_T>
+struct FlatMapHash {
+    uint64_t operator()(const KEY_T& key) const noexcept {
+        if constexpr (std::is_integral_v<KEY_T> or std::is_enum_v<KEY_T>)
+            return HashMix64(static_cast<uint64_t>(key));
+        else if constexpr (std::is_pointer_v<KEY_T>)
+            return HashMix64(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key)));
+        else if constexpr (requires { key.Data(); key.Length(); })
+            return HashBytes(key.Data(), size_t(key.Length()));
+        else if constexpr (requires { { key.X() } -> std::convertible_to<float>; } and std::is_trivially_copyable_v<KEY_T> and (sizeof(KEY_T) % sizeof(float) == 0)) {
+            // +0.0f maps -0.0f to 0.0f, which compare equal
+            float v[sizeof(KEY_T) / sizeof(float)];
+            memcpy(v, &key, sizeof(KEY_T));
+            for (float& f : v)
+                f += 0.0f;
+            return HashBytes(v, sizeof(v));
+        }
+        else {
+            static_assert(std::is_trivially_copyable_v<KEY_T>, "FlatMapHash: specialize for this key type");
+            return HashBytes(&key, sizeof(KEY_T));
+        }
+    }
+};
+
+// =================================================================================================
+
+template <typename KEY_T, typename DATA_T, typename HASH_T = FlatMapHash<KEY_T>>
+class FlatMap
+{
+public:
+    using Comparator = typename AVLTreeTraits<KEY_T, DATA_T>::Comparator;
+    using Entry = std::pair<KEY_T, DATA_T>;
+
+private:
+    Entry*      m_slots;
+    uint8_t*    m_dist;         // probe distance + 1 of each slot's entry, 0 for empty slots
+    int32_t     m_capacity;     // power of two
+    int32_t     m_size;
+    Comparator  m_compareNodes;
+    void*       m_context;
+    HASH_T      m_hash;
+
+    static constexpr uint8_t maxDist = 255;
+
+public:
+    FlatMap(int capacity = 0)
+        : m_slots(nullptr), m_dist(nullptr), m_capacity(0), m_size(0), m_compareNodes(nullptr), m_context(nullptr)
+    {
+        if (capacity > 0)
+            Reserve(capacity);
+    }
+
+    ~FlatMap() {
+        Destroy();
+    }
+
+    inline void SetComparator(Comparator compareNodes, void* context = nullptr) noexcept {
+        m_compareNodes = compareNodes;
+        m_context = context;
+    }
+
+    inline int Size(void) const noexcept {
+        return m_size;
+    }
+
+    inline int Capacity(void) const noexcept {
+        return m_capacity;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    template <bool IS_CONST>
+    class Iterator {
+    public:
+        using MapType = std::conditional_t<IS_CONST, const FlatMap, FlatMap>;
+        using EntryType = std::conditional_t<IS_CONST, const Entry, Entry>;
+
+    private:
+        MapType*    m_map;
+        int32_t     m_index;
+
+    public:
+        Iterator(MapType* map, int32_t index) noexcept
+            : m_map(map), m_index(index)
+        {
+            Skip();
+        }
+
+        inline EntryType& operator*() const noexcept { return m_map->m_slots[m_index]; }
+
+        inline EntryType* operator->() const noexcept { return m_map->m_slots + m_index; }
+
+        inline Iterator& operator++() noexcept {
+            ++m_index;
+            Skip();
+            return *this;
+        }
+
+        inline bool operator==(const Iterator& other) const noexcept { return m_index == other.m_index; }
+
+        inline bool operator!=(const Iterator& other) const noexcept { return m_index != other.m_index; }
+
+    private:
+        inline void Skip(void) noexcept {
+            while ((m_index < m_map->m_capacity) and not m_map->m_dist[m_index])
+                ++m_index;
+        }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, m_capacity); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, m_capacity); }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    DATA_T* Find(const KEY_T& key) {
+        int32_t i = FindSlot(key);
+        return (i < 0) ? nullptr : std::addressof(m_slots[i].second);
+    }
+
+    const DATA_T* Find(const KEY_T& key) const {
+        int32_t i = FindSlot(key);
+        return (i < 0) ? nullptr : std::addressof(m_slots[i].second);
+    }
+
+    inline DATA_T* Find(KEY_T&& key) {
+        return Find(static_cast<const KEY_T&>(key));
+    }
+
+    bool Find(const KEY_T& key, DATA_T& value) {
+        DATA_T* p = Find(key);
+        if (not p)
+            return false;
+        value = *p;
+        return true;
+    }
+
+    template <typename Predicate>
+    DATA_T* FindIf(Predicate pred) {
+        for (auto& [k, v] : *this) {
+            if (pred(k))
+                return std::addressof(v);
+        }
+        return nullptr;
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    template<typename K = KEY_T, typename D = DATA_T>
+        requires std::constructible_from<KEY_T, K&&>&& std::constructible_from<DATA_T, D&&>
+    bool Insert(K&& key, D&& data, bool updateData = false)
+    {
+        Entry entry(std::forward<K>(key), std::forward<D>(data));
+        int32_t i = FindSlot(entry.first);
+        if (i >= 0) {
+            if (not updateData)
+                return false;
+            m_slots[i].second = std::move(entry.second);
+            return true;
+        }
+        return InsertEntry(std::move(entry)) != nullptr;
+    }
+
+    template<typename K = KEY_T>
+    bool Remove(K&& key) {
+        int32_t i = FindSlot(static_cast<const KEY_T&>(key));
+        if (i < 0)
+            return false;
+        RemoveSlot(i);
+        return true;
+    }
+
+    bool Extract(const KEY_T& key, DATA_T& data) {
+        int32_t i = FindSlot(key);
+        if (i < 0)
+            return false;
+        data = std::move(m_slots[i].second);
+        RemoveSlot(i);
+        return true;
+    }
+
+    inline bool Extract(KEY_T&& key, DATA_T& data) {
+        return Extract(static_cast<const KEY_T&>(key), data);
+    }
+
+    template<typename Predicate>
+    int EraseIf(Predicate pred) {
+        int count = 0;
+        for (int32_t i = 0; i < m_capacity; ) {
+            // backward shift moves the next entry into slot i, so only advance if nothing was removed
+            if (m_dist[i] and pred(m_slots[i].second)) {
+                RemoveSlot(i);
+                ++count;
+            }
+            else
+                ++i;
+        }
+        return count;
+    }
+
+    bool Update(const KEY_T& key, const DATA_T& data) {
+        return Insert(key, data, true);
+    }
+
+    // returns a reference to the data stored for key; inserts a default constructed entry if key is not present
+    template<typename K = KEY_T>
+    inline DATA_T& operator[] (K&& key) {
+        int32_t i = FindSlot(static_cast<const KEY_T&>(key));
+        if (i >= 0)
+            return m_slots[i].second;
+        return InsertEntry(Entry(std::forward<K>(key), DATA_T{}))->second;
+    }
+
+    inline FlatMap& operator= (std::initializer_list<std::pair<KEY_T, DATA_T>> data) {
+        for (auto& d : data)
+            Insert(d.first, d.second, true);
+        return *this;
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    template <class Context>
+    bool Walk(bool (Context::* processor)(const KEY_T&, DATA_T*), Context* context) {
+        for (int32_t i = 0; i < m_capacity; ++i) {
+            if (m_dist[i] and not (context->*processor)(m_slots[i].first, std::addressof(m_slots[i].second)))
+                return false;
+        }
+        return true;
+    }
+
+    template<typename Func>
+    bool Walk(Func processNode) {
+        for (int32_t i = 0; i < m_capacity; ++i) {
+            if (m_dist[i] and not processNode(m_slots[i].first, m_slots[i].second))
+                return false;
+        }
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    // make room for capacity entries without rehashing
+    bool Reserve(int capacity) {
+        int32_t slotCount = 16;
+        while (slotCount - slotCount / 8 < capacity)
+            slotCount *= 2;
+        return (slotCount <= m_capacity) or Rehash(slotCount);
+    }
+
+    // remove all entries, keep the slot arrays
+    void Clear(void) noexcept {
+        for (int32_t i = 0; i < m_capacity; ++i) {
+            if (m_dist[i]) {
+                std::destroy_at(m_slots + i);
+                m_dist[i] = 0;
+            }
+        }
+        m_size = 0;
+    }
+
+    void Destroy(void) noexcept {
+        Clear();
+        if (m_slots) {
+            ::operator delete(m_slots, std::align_val_t(alignof(Entry)));
+            m_slots = nullptr;
+        }
+        if (m_dist) {
+            free(m_dist);
+            m_dist = nullptr;
+        }
+        m_capacity = 0;
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    FlatMap(const FlatMap& other)
+        : FlatMap()
+    {
+        Copy(other);
+    }
+
+    FlatMap(FlatMap&& other) noexcept
+        : FlatMap()
+    {
+        Swap(other);
+    }
+
+    FlatMap& operator=(const FlatMap& other) {
+        if (this != &other) {
+            Clear();
+            Copy(other);
+        }
+        return *this;
+    }
+
+    FlatMap& operator=(FlatMap&& other) noexcept {
+        if (this != &other) {
+            Destroy();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    FlatMap& operator+=(const FlatMap& other) {
+        for (auto& [k, v] : other)
+            Insert(k, v);
+        return *this;
+    }
+
+    FlatMap& Copy(const FlatMap& other) {
+        m_compareNodes = other.m_compareNodes;
+        m_context = other.m_context;
+        Reserve(m_size + other.m_size);
+        for (auto& [k, v] : other)
+            Insert(k, v);
+        return *this;
+    }
+
+    void Swap(FlatMap& other) noexcept {
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_dist, other.m_dist);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_compareNodes, other.m_compareNodes);
+        std::swap(m_context, other.m_context);
+    }
+
+    //-----------------------------------------------------------------------------
+
+private:
+    inline bool KeysEqual(const KEY_T& k1, const KEY_T& k2) const {
+        if (m_compareNodes)
+            return m_compareNodes(m_context, k1, k2) == 0;
+        if constexpr (requires { { k1 == k2 } -> std::convertible_to<bool>; })
+            return k1 == k2;
+        else
+            return not (k1 < k2) and not (k2 < k1);
+    }
+
+
+    int32_t FindSlot(const KEY_T& key) const {
+        if (not m_size)
+            return -1;
+        int32_t mask = m_capacity - 1;
+        int32_t i = int32_t(m_hash(key)) & mask;
+        for (uint8_t d = 1; d <= m_dist[i]; ++d, i = (i + 1) & mask) {
+            if (KeysEqual(key, m_slots[i].first))
+                return i;
+        }
+        return -1;
+    }
+
+
+    // insert an entry whose key is not yet present; returns its slot
+    Entry* InsertEntry(Entry&& entry) {
+        if ((m_size + 1 > m_capacity - m_capacity / 8) and not Rehash(m_capacity ? m_capacity * 2 : 16))
+            return nullptr;
+        int32_t mask = m_capacity - 1;
+        int32_t i = int32_t(m_hash(entry.first)) & mask;
+        Entry* inserted = nullptr;
+        for (uint8_t d = 1; ; ++d, i = (i + 1) & mask) {
+            if (not m_dist[i]) {
+                std::construct_at(m_slots + i, std::move(entry));
+                m_dist[i] = d;
+                ++m_size;
+                return inserted ? inserted : m_slots + i;
+            }
+            if (m_dist[i] < d) { // slot holds an entry closer to its home slot: take it and carry that one on
+                std::swap(entry, m_slots[i]);
+                std::swap(d, m_dist[i]);
+                if (not inserted)
+                    inserted = m_slots + i;
+            }
+            if (d == maxDist)
+                return GrowAndInsert(std::move(entry), inserted);
+        }
+    }
+
+
+    // probe distance limit reached: carry is the entry still to be placed, inserted the new entry's slot
+    // (nullptr if carry is the new entry)
+    Entry* GrowAndInsert(Entry&& carry, Entry* inserted) {
+        if (not inserted) {
+            if (not Rehash(m_capacity * 2))
+                return nullptr;
+            return InsertEntry(std::move(carry));
+        }
+        Entry newEntry(std::move(*inserted));
+        int32_t i = int32_t(inserted - m_slots);
+        std::destroy_at(inserted);
+        m_dist[i] = 0; // the table is rebuilt right away, so the gap doesn't matter
+        --m_size;
+        if (not Rehash(m_capacity * 2))
+            return nullptr;
+        InsertEntry(std::move(carry));
+        return InsertEntry(std::move(newEntry));
+    }
+
+
+    void RemoveSlot(int32_t i) noexcept {
+        int32_t mask = m_capacity - 1;
+        std::destroy_at(m_slots + i);
+        for (int32_t j = (i + 1) & mask; m_dist[j] > 1; i = j, j = (j + 1) & mask) {
+            std::construct_at(m_slots + i, std::move(m_slots[j]));
+            std::destroy_at(m_slots + j);
+            m_dist[i] = m_dist[j] - 1;
+        }
+        m_dist[i] = 0;
+        --m_size;
+    }
+
+
+    bool Rehash(int32_t capacity) {
+        Entry* slots = static_cast<Entry*>(::operator new(sizeof(Entry) * size_t(capacity), std::align_val_t(alignof(Entry)), std::nothrow));
+        uint8_t* dist = static_cast<uint8_t*>(calloc(size_t(capacity), 1));
+        if (not (slots and dist)) {
+            ::operator delete(slots, std::align_val_t(alignof(Entry)));
+            free(dist);
+            return false;
+        }
+        Entry* oldSlots = m_slots;
+        uint8_t* oldDist = m_dist;
+        int32_t oldCapacity = m_capacity;
+        m_slots = slots;
+        m_dist = dist;
+        m_capacity = capacity;
+        m_size = 0;
+        for (int32_t i = 0; i < oldCapacity; ++i) {
+            if (oldDist[i]) {
+                InsertEntry(std::move(oldSlots[i]));
+                std::destroy_at(oldSlots + i);
+            }
+        }
+        if (oldSlots)
+            ::operator delete(oldSlots, std::align_val_t(alignof(Entry)));
+        free(oldDist);
+        return true;
+    }
+};
+
+// =================================================================================================
@@ -0,0 +1,281 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <new>
+#include <span>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include "basesingleton.hpp"
+
+// =================================================================================================
+// Bump pointer allocator over a list of memory blocks. Individual allocations cannot be freed; Reset()
+// releases everything at once. If a frame needed more than one block, Reset() replaces them with a
+// single block of the combined size, so a stable workload settles on one block.
+
+class LinearArena {
+private:
+    struct Block {
+        char*   data;
+        size_t  size;
+    };
+
+    std::vector<Block>  m_blocks;
+    size_t              m_blockSize;
+    size_t              m_offset{ 0 };  // fill level of the current block
+    size_t              m_used{ 0 };    // bytes handed out since the last Reset(), including alignment padding
+    int32_t             m_block{ 0 };   // current block
+
+public:
+    static constexpr size_t defaultBlockSize = 256 * 1024;
+
+    LinearArena(size_t blockSize = defaultBlockSize) noexcept
+        : m_blockSize(blockSize ? blockSize : defaultBlockSize)
+    { }
+
+    ~LinearArena() {
+        Destroy();
+    }
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    // alignment must be a power of two. Returns nullptr if no memory is available.
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+
+    void Reset(void);
+
+    void Destroy(void) noexcept;
+
+    inline void SetBlockSize(size_t blockSize) noexcept {
+        m_blockSize = blockSize ? blockSize : defaultBlockSize;
+    }
+
+    inline size_t Used(void) const noexcept {
+        return m_used;
+    }
+
+    size_t Capacity(void) const noexcept;
+
+    inline int32_t BlockCount(void) const noexcept {
+        return int32_t(m_blocks.size());
+    }
+
+private:
+    bool AllocBlock(size_t size) noexcept;
+};
+
+// =================================================================================================
+// Allocator for transient per-frame data. Every thread allocates from its own LinearArena, so
+// allocation needs no locking. There is one arena per thread and frame slot; memory allocated in a
+// frame stays valid for FRAME_COUNT frames (matching the renderers' frames in flight), then the slot
+// is reset by BeginFrame(). BeginFrame() must be called once per frame by the main thread while no
+// other thread allocates from the frame arena (i.e. outside of running jobs).
+// FrameStats() reports the memory used by the last completed frame and the high water mark over all
+// frames, to size the block size (SetBlockSize()).
+
+class FrameArena
+    : public BaseSingleton<FrameArena>
+{
+public:
+    static constexpr int32_t FRAME_COUNT = 2;
+
+    struct Stats {
+        size_t      used{ 0 };          // bytes allocated by all threads during the frame
+        size_t      highWaterMark{ 0 }; // highest used value of all frames so far
+        size_t      capacity{ 0 };      // memory held by the frame's arenas
+        int32_t     threadCount{ 0 };   // threads which have allocated from the frame arena
+    };
+
+    struct ThreadArenas {
+        LinearArena     arenas[FRAME_COUNT];
+        uint64_t        retireFrame{ 0 };
+    };
+
+private:
+    std::mutex                                  m_lock;
+    std::vector<std::unique_ptr<ThreadArenas>>  m_threadArenas;
+    std::vector<std::unique_ptr<ThreadArenas>>  m_retiredArenas;   // arenas of terminated threads which may still be referenced
+    std::atomic<int32_t>                        m_slot{ 0 };
+    uint64_t                                    m_frame{ 0 };
+    size_t                                      m_blockSize{ LinearArena::defaultBlockSize };
+    Stats                                       m_stats;
+
+public:
+    // Start a new frame: reset the arenas of the frame slot that was used FRAME_COUNT frames ago
+    void BeginFrame(void);
+
+    inline void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept {
+        ThreadArenas* t = ThreadLocalArenas();
+        return t ? t->arenas[m_slot.load(std::memory_order_relaxed)].Allocate(size, alignment) : nullptr;
+    }
+
+    // uninitialized memory for count items of type DATA_T
+    template <typename DATA_T>
+    inline DATA_T* Allocate(int32_t count) noexcept {
+        return static_cast<DATA_T*>(Allocate(sizeof(DATA_T) * size_t(count), alignof(DATA_T)));
+    }
+
+    // block size for arenas created from now on
+    void SetBlockSize(size_t blockSize);
+
+    inline const Stats& FrameStats(void) const noexcept {
+        return m_stats;
+    }
+
+    inline uint64_t Frame(void) const noexcept {
+        return m_frame;
+    }
+
+    void Destroy(void);
+
+    FrameArena();
+
+    ~FrameArena();
+
+private:
+    ThreadArenas* ThreadLocalArenas(void) noexcept;
+
+    ThreadArenas* RegisterThread(void) noexcept;
+
+    void UnregisterThread(ThreadArenas* arenas) noexcept;
+
+    friend struct FrameArenaThreadLink;
+};
+
+#define frameArena FrameArena::Instance()
+
+// =================================================================================================
+// std allocator drawing from the frame arena, e.g. for std::vector<T, ArenaAllocator<T>> temporaries.
+// deallocate() is a no-op; the memory is reclaimed when the frame slot is reset.
+
+template <typename DATA_T>
+class ArenaAllocator {
+public:
+    using value_type = DATA_T;
+
+    ArenaAllocator() noexcept = default;
+
+    template <typename OTHER_T>
+    ArenaAllocator(const ArenaAllocator<OTHER_T>&) noexcept { }
+
+    DATA_T* allocate(size_t n) {
+        DATA_T* p = frameArena.Allocate<DATA_T>(int32_t(n));
+        if (not p)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    void deallocate(DATA_T*, size_t) noexcept { }
+
+    template <typename OTHER_T>
+    bool operator==(const ArenaAllocator<OTHER_T>&) const noexcept { return true; }
+
+    template <typename OTHER_T>
+    bool operator!=(const ArenaAllocator<OTHER_T>&) const noexcept { return false; }
+};
+
+// =================================================================================================
+// Growable array in frame arena memory with the AutoArray interface subset used by transient data.
+// Items must be trivially destructible since the arena never runs destructors. Growing copies the
+// items to a new arena allocation; reserve the expected size up front where it is known.
+// An ArenaArray must not be used after FrameArena::FRAME_COUNT frames have passed.
+
+template <typename DATA_T>
+class ArenaArray {
+    static_assert(std::is_trivially_destructible_v<DATA_T>, "ArenaArray items must be trivially destructible");
+
+private:
+    DATA_T*     m_data{ nullptr };
+    int32_t     m_length{ 0 };
+    int32_t     m_capacity{ 0 };
+
+public:
+    using value_type = DATA_T;
+
+    ArenaArray(int32_t capacity = 0) noexcept {
+        Reserve(capacity);
+    }
+
+    ArenaArray(const ArenaArray&) = delete;
+    ArenaArray& operator=(const ArenaArray&) = delete;
+
+    ArenaArray(ArenaArray&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_length(std::exchange(other.m_length, 0)), m_capacity(std::exchange(other.m_capacity, 0))
+    { }
+
+    bool Reserve(int32_t capacity) noexcept {
+        if (capacity <= m_capacity)
+            return true;
+        DATA_T* data = frameArena.Allocate<DATA_T>(capacity);
+        if (not data)
+            return false;
+        if (m_length) {
+            if constexpr (std::is_trivially_copyable_v<DATA_T>)
+                memcpy(data, m_data, sizeof(DATA_T) * size_t(m_length));
+            else
+                std::uninitialized_move(m_data, m_data + m_length, data);
+        }
+        m_data = data;
+        m_capacity = capacity;
+        return true;
+    }
+
+    // new items are value initialized
+    DATA_T* Resize(int32_t length) noexcept {
+        if ((length > m_capacity) and not Reserve(length))
+            return nullptr;
+        if (length > m_length)
+            std::uninitialized_value_construct(m_data + m_length, m_data + length);
+        m_length = length;
+        return m_data;
+    }
+
+    template <typename... ARGS>
+    DATA_T* Append(ARGS&&... args) noexcept {
+        if ((m_length == m_capacity) and not Reserve(m_capacity ? m_capacity * 2 : 16))
+            return nullptr;
+        return std::construct_at(m_data + m_length++, std::forward<ARGS>(args)...);
+    }
+
+    inline void Clear(void) noexcept {
+        m_length = 0;
+    }
+
+    inline int32_t Length(void) const noexcept { return m_length; }
+
+    inline int32_t Capacity(void) const noexcept { return m_capacity; }
+
+    inline bool IsEmpty(void) const noexcept { return m_length == 0; }
+
+    inline DATA_T* DataPtr(int32_t i = 0) noexcept { return m_data + i; }
+
+    inline const DATA_T* DataPtr(int32_t i = 0) const noexcept { return m_data + i; }
+
+    inline DATA_T& operator[](int32_t i) noexcept { return m_data[i]; }
+
+    inline const DATA_T& operator[](int32_t i) const noexcept { return m_data[i]; }
+
+    inline std::span<DATA_T> Span(void) noexcept { return std::span<DATA_T>(m_data, size_t(m_length)); }
+
+    inline std::span<const DATA_T> Span(void) const noexcept { return std::span<const DATA_T>(m_data, size_t(m_length)); }
+
+    inline DATA_T* begin(void) noexcept { return m_data; }
+
+    inline DATA_T* end(void) noexcept { return m_data + m_length; }
+
+    inline const DATA_T* begin(void) const noexcept { return m_data; }
+
+    inline const DATA_T* end(void) const noexcept { return m_data + m_length; }
+};
+
+// =================================================================================================
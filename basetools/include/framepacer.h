@@ -0,0 +1,83 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "clock.h"
+
+// =================================================================================================
+// Fixed rate loop pacing. OS sleeps wake up late (50 - 100 us on Linux, up to a millisecond on
+// Windows), so Wait() only sleeps (HiresSleep) until a margin before the frame deadline and spins
+// through the rest, yielding while far from it and pausing the core during the last stretch.
+// The margin tunes itself to the observed oversleep: it jumps up when a sleep overshoots it and
+// slowly decays towards a few deviations above the mean oversleep, so the spin phase stays short.
+// Deadlines are fixed to the pacing grid (start + n * interval), so wake errors don't accumulate.
+// A frame which reaches Wait() after its deadline counts as missed; if it is late by more than a
+// whole interval, the grid is restarted from now rather than rushing through the lost frames.
+// Times are Clock nanoseconds.
+
+class FramePacer {
+public:
+    static constexpr size_t windowSize = 256;       // frames the wake error statistics cover
+
+    static constexpr int64_t initialMargin = 1000000;
+    static constexpr int64_t minMargin = 20000;
+    static constexpr int64_t maxMargin = 4000000;
+    static constexpr int64_t yieldThreshold = 100000; // spin by yielding while at least this far from the deadline
+
+    struct Statistics {
+        int64_t     frames;         // since Start()
+        int64_t     missed;         // since Start()
+        float       meanError;      // wake time - deadline in us, over the window
+        float       p99Error;
+        float       maxError;
+        float       margin;         // current sleep margin in us
+    };
+
+private:
+    int64_t     m_interval{ 0 };
+    int64_t     m_deadline{ 0 };
+    int64_t     m_margin{ initialMargin };
+    double      m_oversleepMean{ 0.0 };
+    double      m_oversleepDeviation{ 0.0 };
+    int64_t     m_frames{ 0 };
+    int64_t     m_missed{ 0 };
+    int32_t     m_wakeErrors[windowSize]{};  // ns, ring buffer
+    size_t      m_errorCount{ 0 };
+
+public:
+    explicit FramePacer(float fps = 0.0f) noexcept {
+        SetRate(fps);
+    }
+
+    // frames per second; 0 disables pacing
+    inline void SetRate(float fps) noexcept {
+        m_interval = (fps > 0.0f) ? int64_t(double(Clock::nanosPerSecond) / double(fps) + 0.5) : 0;
+    }
+
+    inline void SetInterval(int64_t interval) noexcept {
+        m_interval = (interval > 0) ? interval : 0;
+    }
+
+    inline int64_t Interval(void) const noexcept {
+        return m_interval;
+    }
+
+    // starts the pacing grid at the current time and resets the statistics
+    void Start(void) noexcept;
+
+    // Waits for the current frame's deadline and advances it to the next frame. Returns the wake time.
+    int64_t Wait(void);
+
+    Statistics GetStatistics(void) const noexcept;
+
+private:
+    void RecordWake(int64_t error) noexcept;
+
+    void TuneMargin(int64_t oversleep) noexcept;
+};
+
+// =================================================================================================
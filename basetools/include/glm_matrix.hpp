@@ -6,10 +6,12 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #pragma warning(pop)
+#include <span>
 #include <initializer_list>
 #include <algorithm>
 #include "conversions.hpp"
 #include "glm_vector.hpp"
+#include "matrixkernels.h"
 
 // =================================================================================================
 
@@ -149,8 +151,7 @@ public:
     Matrix4f& Translate(float x, float y, float z)
  noexcept(noexcept(Translation(std::declval<float>(), std::declval<float>(), std::declval<float>())))
     {
-        m *= Translation(x, y, z).m;
-        return *this;
+        return *this *= Translation(x, y, z);
     }
 
     Matrix4f& Translate(const Vector3f& v)
@@ -190,8 +191,7 @@ public:
     template<typename T>
         requires std::same_as<std::decay_t<T>, Matrix4f>
     Matrix4f& Rotate(T&& r) noexcept {
-        m *= std::forward<T>(r).m;
-        return *this;
+        return *this *= std::forward<T>(r);
     }
 
     static inline Vector3f Rotate(const Matrix4f& mm, const Vector3f& v);
@@ -199,22 +199,25 @@ public:
     Vector3f Unrotate(const Vector3f v);
 
     // ===== LinAlg =====
-    Matrix4f Transpose() const
- noexcept(noexcept(glm::transpose(std::declval<glm::mat4>())))
+    // Products, inverses and transposes go through the SIMD kernels (see matrixkernels.h).
+    Matrix4f Transpose() const noexcept
     {
-        return Matrix4f(glm::transpose(m));
+        glm::mat4 r;
+        MatrixKernels::Transpose(glm::value_ptr(r), glm::value_ptr(m));
+        return Matrix4f(r);
     }
 
-    Matrix4f Transpose(Matrix4f& _m, int /*dimensions*/ = 4) const
- noexcept(noexcept(glm::transpose(std::declval<glm::mat4>())))
+    Matrix4f Transpose(Matrix4f& _m, int /*dimensions*/ = 4) const noexcept
     {
-        return _m = _m.Transpose();
+        MatrixKernels::Transpose(glm::value_ptr(_m.m), glm::value_ptr(_m.m));
+        return _m;
     }
 
-    Matrix4f Inverse() const
- noexcept(noexcept(glm::inverse(std::declval<glm::mat4>())))
+    Matrix4f Inverse() const noexcept
     {
-        return Matrix4f(glm::inverse(m));
+        glm::mat4 r;
+        MatrixKernels::Inverse(glm::value_ptr(r), glm::value_ptr(m));
+        return Matrix4f(r);
     }
 
     Matrix4f AffineInverse(void)
@@ -239,29 +242,26 @@ public:
     }
 
     // ===== Operators =====
-    Matrix4f operator*(const Matrix4f& other) const
- noexcept(noexcept(std::declval<glm::mat4>()* other.m))
+    Matrix4f operator*(const Matrix4f& other) const noexcept
     {
-        return Matrix4f(m * other.m);
+        return *this * other.m;
     }
 
-    Matrix4f operator*(const glm::mat4& other) const
- noexcept(noexcept(std::declval<glm::mat4>()* other))
+    Matrix4f operator*(const glm::mat4& other) const noexcept
     {
-        return Matrix4f(m * other);
+        glm::mat4 r;
+        MatrixKernels::Multiply(glm::value_ptr(r), glm::value_ptr(m), glm::value_ptr(other));
+        return Matrix4f(r);
     }
 
-    Matrix4f& operator*=(const Matrix4f& other)
- noexcept(noexcept(std::declval<glm::mat4&>() *= other.m))
+    Matrix4f& operator*=(const Matrix4f& other) noexcept
     {
-        m *= other.m;
-        return *this;
+        return *this *= other.m;
     }
 
-    Matrix4f& operator*=(const glm::mat4& other)
- noexcept(noexcept(std::declval<glm::mat4&>() *= other))
+    Matrix4f& operator*=(const glm::mat4& other) noexcept
     {
-        m *= other;
+        MatrixKernels::Multiply(glm::value_ptr(m), glm::value_ptr(m), glm::value_ptr(other));
         return *this;
     }
 
@@ -317,3 +317,24 @@ noexcept(noexcept(mm* v))
 }
 
 // =================================================================================================
+// Batch transforms of packed Vector3f arrays (vertex positions, normals, morph target deltas).
+// They process min(src.size(), dst.size()) items; src and dst may be the same array.
+
+static_assert(sizeof(Vector3f) == 3 * sizeof(float), "Vector3f must be a packed x, y, z triple");
+
+// dst[i] = (m * vec4(src[i], 1)).xyz
+inline void TransformPoints(const Matrix4f& m, std::span<const Vector3f> src, std::span<Vector3f> dst) noexcept {
+    MatrixKernels::TransformPoints(m.AsArray(), reinterpret_cast<const float*>(src.data()), reinterpret_cast<float*>(dst.data()), std::min(src.size(), dst.size()));
+}
+
+// dst[i] = (m * vec4(src[i], 0)).xyz; for directions and position deltas
+inline void TransformVectors(const Matrix4f& m, std::span<const Vector3f> src, std::span<Vector3f> dst) noexcept {
+    MatrixKernels::TransformVectors(m.AsArray(), reinterpret_cast<const float*>(src.data()), reinterpret_cast<float*>(dst.data()), std::min(src.size(), dst.size()));
+}
+
+// transforms with the inverse transpose of m's upper 3x3 part; normalizes unless told not to (normal deltas)
+inline void TransformNormals(const Matrix4f& m, std::span<const Vector3f> src, std::span<Vector3f> dst, bool normalize = true) noexcept {
+    MatrixKernels::TransformNormals(m.AsArray(), reinterpret_cast<const float*>(src.data()), reinterpret_cast<float*>(dst.data()), std::min(src.size(), dst.size()), normalize);
+}
+
+// =================================================================================================
@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include "basesingleton.hpp"
+#include "clock.h"
 
 #ifdef _WIN32
 #   include <windows.h>
@@ -30,19 +31,11 @@ public:
     }
 
     // Monotone Zeit in Mikrosekunden
-    static int64_t GetTime(void) {
-#ifdef _WIN32
-        LARGE_INTEGER c, f;
-        QueryPerformanceCounter(&c);
-        QueryPerformanceFrequency(&f);
-        return (int64_t)((c.QuadPart * 1000000LL + f.QuadPart / 2) / f.QuadPart); // rundend
-#else
-        timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
-        return (int64_t)ts.tv_sec * 1000000LL + (ts.tv_nsec + 500) / 1000LL;       // rundend
-#endif
+    static inline int64_t GetTime(void) noexcept {
+        return Clock::Micros();
     }
 
-    // Schlafe bis absolute Deadline (s, CLOCK_MONOTONIC-Basis)
+    // Schlafe bis absolute Deadline (s, Clock-Basis)
     void SleepTo(int64_t deadline) const {
 #ifdef _WIN32
         int64_t diff = deadline - GetTime();
@@ -57,14 +50,17 @@ public:
         }
         Sleep((DWORD)((diff + 999) / 1000));                 // Fallback
 #else
+        int64_t diff = deadline - GetTime();
+        if (diff <= 0) return;
 #ifdef TIMER_ABSTIME
+        // Clock may drift from CLOCK_MONOTONIC, so the deadline is rebased onto it
         timespec ts;
-        ts.tv_sec = deadline / 1000000LL;
-        ts.tv_nsec = (deadline % 1000000LL) * 1000LL;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        int64_t t = (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec + diff * 1000LL;
+        ts.tv_sec = t / 1000000000LL;
+        ts.tv_nsec = t % 1000000000LL;
         while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
 #else
-        int64_t diff = deadline - GetTime();
-        if (diff <= 0) return;
         timespec rq{ diff / 1000000LL, (diff % 1000000LL) * 1000LL };
         while (nanosleep(&rq, &rq) == -1 and errno == EINTR) {}
 #endif
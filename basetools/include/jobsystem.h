@@ -0,0 +1,220 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include "basesingleton.hpp"
+#include "array.hpp"
+
+// USE_JOBS 0 compiles the job system as a deterministic single thread implementation which executes
+// every job immediately on the submitting thread, in submission order.
+#ifndef USE_JOBS
+#   define USE_JOBS 1
+#endif
+
+class JobSystem;
+class JobCounter;
+
+// =================================================================================================
+
+struct JobEntry {
+    std::function<void()>   task;
+    JobCounter*             counter;
+};
+
+// =================================================================================================
+// Completion counter of a group of jobs. Submitting a job with a counter increments it, finishing the
+// job decrements it. Jobs can be made dependent on a counter; they are only started when it has
+// dropped to zero. A counter must outlive all jobs referring to it: wait for every counter (or check
+// IsDone()) before destroying it, since a job depending on it can finish before its Done() returns.
+
+class JobCounter {
+    friend class JobSystem;
+
+private:
+    std::atomic<int32_t>    m_pending{ 0 };
+#if USE_JOBS
+    std::atomic<int32_t>    m_finishing{ 0 };   // Done() calls in progress; the counter must not be destroyed before they have left
+    std::mutex              m_lock;
+    std::vector<JobEntry*>  m_waitingJobs;  // jobs depending on this counter
+#endif
+
+public:
+    JobCounter() = default;
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    inline bool IsDone(void) const noexcept {
+#if USE_JOBS
+        return (m_pending.load(std::memory_order_acquire) == 0) and (m_finishing.load(std::memory_order_acquire) == 0);
+#else
+        return m_pending.load(std::memory_order_acquire) == 0;
+#endif
+    }
+
+    inline int32_t Pending(void) const noexcept {
+        return m_pending.load(std::memory_order_acquire);
+    }
+
+private:
+    inline void Add(int32_t count = 1) noexcept {
+        m_pending.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void Done(void);
+};
+
+// =================================================================================================
+// Job system with one work stealing queue per thread. Thread 0 is the thread calling Init() (usually
+// the main thread); it takes part in job processing whenever it waits for jobs (Wait(), ParallelFor()).
+// Worker threads pop jobs from their own queue in LIFO order and steal from other threads' queues in
+// FIFO order when theirs is empty. Threads outside of the job system submit to a shared queue.
+// Until Init() has been called (and with USE_JOBS 0) all jobs are executed immediately by the
+// submitting thread.
+
+class JobSystem
+    : public BaseSingleton<JobSystem>
+{
+public:
+    using JobFunction = std::function<void()>;
+    using Job = JobEntry;
+
+private:
+    // Chase-Lev work stealing deque of fixed capacity. Push() and Pop() may only be called by the
+    // owning thread, Steal() by any thread.
+    class WorkQueue {
+    public:
+        static constexpr int64_t capacity = 4096;
+
+    private:
+        static constexpr int64_t mask = capacity - 1;
+
+        alignas(64) std::atomic<int64_t>    m_top{ 0 };
+        alignas(64) std::atomic<int64_t>    m_bottom{ 0 };
+        std::atomic<Job*>                   m_jobs[capacity];
+
+    public:
+        bool Push(Job* job) noexcept;
+
+        Job* Pop(void) noexcept;
+
+        Job* Steal(void) noexcept;
+
+        inline bool IsEmpty(void) const noexcept {
+            return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+        }
+    };
+
+#if USE_JOBS
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;           // one per thread, [0] belongs to the Init() thread
+    std::vector<std::thread>                m_workers;
+    std::mutex                              m_sharedLock;
+    std::deque<Job*>                        m_sharedQueue;      // jobs submitted by threads outside the job system
+    std::mutex                              m_sleepLock;
+    std::condition_variable                 m_wakeUp;
+    std::atomic<int32_t>                    m_queuedJobs{ 0 };
+    std::atomic<int32_t>                    m_sleepers{ 0 };
+    std::atomic<bool>                       m_isRunning{ false };
+#endif
+
+public:
+    ~JobSystem() {
+        Shutdown();
+    }
+
+    // Start threadCount worker threads; a negative value uses one worker per hardware thread except
+    // for the calling thread. Zero workers keeps the job system in immediate (single thread) mode.
+    bool Init(int32_t threadCount = -1);
+
+    void Shutdown(void);
+
+    inline int32_t WorkerCount(void) const noexcept {
+#if USE_JOBS
+        return int32_t(m_workers.size());
+#else
+        return 0;
+#endif
+    }
+
+    // number of threads processing jobs, including the Init() thread
+    inline int32_t ThreadCount(void) const noexcept {
+        return WorkerCount() + 1;
+    }
+
+    inline bool IsParallel(void) const noexcept {
+        return WorkerCount() > 0;
+    }
+
+    // index of the calling thread in the job system (0: Init() thread), -1 for other threads
+    static int32_t ThreadIndex(void) noexcept;
+
+    // Queue task for execution. counter (optional) is incremented now and decremented when the task
+    // has been executed. The task is held back until dependency (optional) is done.
+    void Submit(JobFunction task, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+    // Process jobs until counter is done, so the waiting thread doesn't idle.
+    void Wait(JobCounter& counter);
+
+    // Execute one pending job if there is any. Returns false if no job was available.
+    bool Help(void);
+
+    // Call fn(i) for every i in [begin, end). The range is split into chunks of grain indices (grain < 1:
+    // automatic), which are processed in parallel. Returns when all indices have been processed.
+    template <typename FUNC_T>
+    void ParallelFor(int32_t begin, int32_t end, int32_t grain, FUNC_T&& fn) {
+        if (begin >= end)
+            return;
+        int32_t l = end - begin;
+        if (grain < 1)
+            grain = std::max(1, l / (ThreadCount() * 4));
+        if (not IsParallel() or (l <= grain)) {
+            for (int32_t i = begin; i < end; ++i)
+                fn(i);
+            return;
+        }
+        JobCounter counter;
+        int32_t i = begin;
+        for (; end - i > grain; i += grain)
+            Submit([&fn, i, grain]() {
+                for (int32_t j = i, e = i + grain; j < e; ++j)
+                    fn(j);
+                }, &counter);
+        for (; i < end; ++i) // last chunk is processed by the calling thread
+            fn(i);
+        Wait(counter);
+    }
+
+    // Call fn(item) for every item of data
+    template <typename DATA_T, typename FUNC_T>
+    inline void ParallelFor(AutoArray<DATA_T>& data, int32_t grain, FUNC_T&& fn) {
+        DATA_T* items = data.DataPtr();
+        ParallelFor(0, data.Length(), grain, [items, &fn](int32_t i) { fn(items[i]); });
+    }
+
+private:
+    void Enqueue(Job* job);
+
+    Job* FindJob(int32_t threadIndex);
+
+    void Execute(Job* job);
+
+    void WorkerLoop(int32_t threadIndex);
+
+    friend class JobCounter;
+};
+
+#define jobSystem JobSystem::Instance()
+
+// =================================================================================================
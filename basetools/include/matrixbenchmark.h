@@ -0,0 +1,40 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <cstdio>
+#include <cstddef>
+#include <vector>
+#include "matrixkernels.h"
+
+// =================================================================================================
+// Check and benchmark of the MatrixKernels levels.
+// Check() runs the kernels of every level the CPU supports against a double precision reference:
+// multiply, inverse, point transforms and normal transforms (the inverse transpose) with rotations,
+// non-uniform scales, random affine matrices and a singular matrix, in place and with element counts
+// that leave a remainder for the SIMD loops.
+// Run() measures the batch point and normal transform throughput of every supported level, so the
+// SIMD kernels can be compared with the scalar ones. Both restore the active level when done.
+
+class MatrixBenchmark {
+public:
+    struct Result {
+        MatrixKernels::Level    level;
+        double                  pointsPerSecond;
+        double                  normalsPerSecond;
+        double                  multipliesPerSecond;
+    };
+
+    // Returns the number of failed checks; each failure is reported to stream (nullptr: silent).
+    static int Check(FILE* stream = stderr);
+
+    // count points and normals per batch (4096 fit in the L1/L2 caches); each kernel runs for about
+    // duration seconds per level
+    static std::vector<Result> Run(size_t count = 4096, float duration = 0.25f);
+
+    static void Print(const std::vector<Result>& results, FILE* stream = stdout);
+};
+
+// =================================================================================================
@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "simd.h"
+
+// =================================================================================================
+// SIMD kernels for 4x4 float matrices and batch vertex transforms. Matrices are 16 floats in column
+// major order (glm layout); vectors are packed x, y, z triples (Vector3f layout).
+// Every kernel has a scalar, an SSE4.1 and an AVX2/FMA implementation. The best one supported by the
+// CPU is selected at runtime on first use; SetLevel() can force a lower level (e.g. to compare them).
+// Non x86 builds only have the scalar kernels.
+// Source and destination may be the same array; other overlaps are not supported.
+
+class MatrixKernels {
+public:
+    using Level = Simd::Level;
+
+    struct KernelTable {
+        void (*multiply)(float* r, const float* a, const float* b) noexcept;
+        bool (*inverse)(float* r, const float* m) noexcept;
+        void (*transpose)(float* r, const float* m) noexcept;
+        // m: the 3 columns of a 3x3 matrix followed by a translation (12 floats)
+        void (*transform)(const float* m, const float* src, float* dst, size_t count, bool normalize) noexcept;
+        void (*normalize)(const float* src, float* dst, float* lengths, size_t count, float tolerance) noexcept;
+        Level level;
+    };
+
+private:
+    static std::atomic<const KernelTable*> m_kernels;
+
+public:
+    // r = a * b
+    static inline void Multiply(float* r, const float* a, const float* b) noexcept {
+        Kernels().multiply(r, a, b);
+    }
+
+    // Returns false if m is singular; r then contains non-finite values (like glm::inverse).
+    static inline bool Inverse(float* r, const float* m) noexcept {
+        return Kernels().inverse(r, m);
+    }
+
+    static inline void Transpose(float* r, const float* m) noexcept {
+        Kernels().transpose(r, m);
+    }
+
+    // dst[i] = (m * vec4(src[i], 1)).xyz; no perspective division
+    static void TransformPoints(const float* m, const float* src, float* dst, size_t count) noexcept;
+
+    // dst[i] = (m * vec4(src[i], 0)).xyz
+    static void TransformVectors(const float* m, const float* src, float* dst, size_t count) noexcept;
+
+    // transforms with the inverse transpose of the upper 3x3 part of m; normalized results unless
+    // normalize is false (e.g. for normal deltas). Zero length normals stay zero. If the 3x3 part is
+    // singular, its cofactor matrix (the inverse transpose times the determinant) is used instead.
+    static void TransformNormals(const float* m, const float* src, float* dst, size_t count, bool normalize = true) noexcept;
+
+    // lengths[i] = |src[i]|; dst[i] = src[i] / lengths[i], or zero if lengths[i] <= tolerance
+    static void Normalize(const float* src, float* dst, float* lengths, size_t count, float tolerance) noexcept;
+
+    static inline Level SupportedLevel(void) noexcept {
+        return Simd::SupportedLevel();
+    }
+
+    // Select the kernels of the given level, or of the best supported level below it.
+    // Returns the level actually selected.
+    static Level SetLevel(Level level) noexcept;
+
+    static inline Level ActiveLevel(void) noexcept {
+        return Kernels().level;
+    }
+
+    static inline const char* LevelName(Level level) noexcept {
+        return Simd::LevelName(level);
+    }
+
+private:
+    static inline const KernelTable& Kernels(void) noexcept {
+        const KernelTable* kernels = m_kernels.load(std::memory_order_acquire);
+        return kernels ? *kernels : SelectKernels();
+    }
+
+    static const KernelTable& SelectKernels(void) noexcept;
+};
+
+// =================================================================================================
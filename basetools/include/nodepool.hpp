@@ -0,0 +1,190 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+
+// =================================================================================================
+// Slab allocator for fixed size nodes of linked containers (AVLTree, List).
+// Nodes are carved from contiguous slabs; released nodes are kept in a free list which links
+// through the node memory itself. Slabs are only returned to the OS by Destroy(); Recycle()
+// makes all slabs available again without freeing them (the owner has to destroy the nodes
+// it still holds before calling Recycle()).
+
+template <typename NODE_T>
+class NodePool {
+private:
+    struct FreeNode {
+        FreeNode*   next;
+    };
+
+    struct Slab {
+        Slab*       next;
+        int32_t     capacity;
+        int32_t     used;
+
+        inline NODE_T* Nodes(void) noexcept {
+            return reinterpret_cast<NODE_T*>(reinterpret_cast<char*>(this) + HeaderSize());
+        }
+    };
+
+    static constexpr size_t NodeSize(void) noexcept {
+        return std::max(sizeof(NODE_T), sizeof(FreeNode));
+    }
+
+    static constexpr size_t HeaderSize(void) noexcept {
+        constexpr size_t align = std::max(alignof(NODE_T), alignof(Slab));
+        return (sizeof(Slab) + align - 1) / align * align;
+    }
+
+    static_assert(sizeof(NODE_T) >= sizeof(FreeNode), "NodePool requires nodes of at least pointer size");
+
+    Slab*       m_slabs;        // slab list, the slab currently carved from is the head
+    FreeNode*   m_freeNodes;
+    int32_t     m_slabSize;     // node count of the next slab to allocate
+    int32_t     m_capacity;     // total node count of all slabs
+    int32_t     m_slabCount;
+
+public:
+    static constexpr int32_t defaultSlabSize = 64;
+
+    NodePool(int32_t slabSize = defaultSlabSize) noexcept
+        : m_slabs(nullptr), m_freeNodes(nullptr), m_slabSize(std::max(slabSize, 1)), m_capacity(0), m_slabCount(0)
+    { }
+
+    ~NodePool() {
+        Destroy();
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    inline void SetSlabSize(int32_t slabSize) noexcept {
+        m_slabSize = std::max(slabSize, 1);
+    }
+
+    inline int32_t Capacity(void) const noexcept {
+        return m_capacity;
+    }
+
+    inline int32_t SlabCount(void) const noexcept {
+        return m_slabCount;
+    }
+
+    // make sure at least nodeCount nodes can be claimed without further allocations.
+    // The extra space is allocated as a single slab to keep the nodes close together.
+    bool Reserve(int32_t nodeCount) {
+        int32_t available = Available();
+        if (nodeCount <= available)
+            return true;
+        return AllocSlab(nodeCount - available) != nullptr;
+    }
+
+    // returns uninitialized memory for a node; construct it with placement new
+    void* Claim(void) {
+        if (m_freeNodes) {
+            FreeNode* node = m_freeNodes;
+            m_freeNodes = node->next;
+            return node;
+        }
+        Slab* slab = m_slabs;
+        if (not slab or (slab->used == slab->capacity)) {
+            slab = FindSlab();
+            if (not slab and not (slab = AllocSlab(m_slabSize)))
+                return nullptr;
+        }
+        return reinterpret_cast<char*>(slab->Nodes()) + NodeSize() * slab->used++;
+    }
+
+    // the node must already have been destroyed by the caller
+    inline void Release(void* node) noexcept {
+        if (node) {
+            FreeNode* f = reinterpret_cast<FreeNode*>(node);
+            f->next = m_freeNodes;
+            m_freeNodes = f;
+        }
+    }
+
+    template <typename... ARGS>
+    inline NODE_T* New(ARGS&&... args) {
+        void* p = Claim();
+        return p ? new (p) NODE_T(std::forward<ARGS>(args)...) : nullptr;
+    }
+
+    inline void Delete(NODE_T* node) noexcept {
+        if (node) {
+            node->~NODE_T();
+            Release(node);
+        }
+    }
+
+    // all nodes have been destroyed by the owner: restart carving from the first slab
+    void Recycle(void) noexcept {
+        m_freeNodes = nullptr;
+        for (Slab* slab = m_slabs; slab; slab = slab->next)
+            slab->used = 0;
+    }
+
+    void Destroy(void) noexcept {
+        while (m_slabs) {
+            Slab* slab = m_slabs;
+            m_slabs = slab->next;
+            free(slab);
+        }
+        m_freeNodes = nullptr;
+        m_capacity = 0;
+        m_slabCount = 0;
+    }
+
+private:
+    int32_t Available(void) const noexcept {
+        int32_t available = 0;
+        for (FreeNode* f = m_freeNodes; f; f = f->next)
+            ++available;
+        for (Slab* slab = m_slabs; slab; slab = slab->next)
+            available += slab->capacity - slab->used;
+        return available;
+    }
+
+    // find a slab with unused space behind the list head and move it to the head
+    Slab* FindSlab(void) noexcept {
+        if (not m_slabs)
+            return nullptr;
+        for (Slab* prev = m_slabs, *slab = prev->next; slab; prev = slab, slab = slab->next) {
+            if (slab->used < slab->capacity) {
+                prev->next = slab->next;
+                slab->next = m_slabs;
+                return m_slabs = slab;
+            }
+        }
+        return nullptr;
+    }
+
+    Slab* AllocSlab(int32_t nodeCount) {
+        void* buffer = malloc(HeaderSize() + NodeSize() * size_t(nodeCount));
+        if (not buffer)
+            return nullptr;
+        Slab* slab = reinterpret_cast<Slab*>(buffer);
+        slab->capacity = nodeCount;
+        slab->used = 0;
+        // keep a partially used head slab in front so its remaining nodes get used first
+        if (m_slabs and (m_slabs->used < m_slabs->capacity)) {
+            slab->next = m_slabs->next;
+            m_slabs->next = slab;
+        }
+        else {
+            slab->next = m_slabs;
+            m_slabs = slab;
+        }
+        m_capacity += nodeCount;
+        ++m_slabCount;
+        return slab;
+    }
+};
+
+// =================================================================================================
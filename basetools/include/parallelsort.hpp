@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include "array.hpp"
+#include "sort.hpp"
+#include "jobsystem.h"
+
+// =================================================================================================
+// Introsort distributed over the job system. Ranges are partitioned like in Sorter::Introsort(); of
+// each partition of more than parallelSortThreshold items, the smaller part is submitted as a job
+// while the calling thread continues with the larger one. Short arrays, or a job system without
+// worker threads, are sorted sequentially. The comparator is called concurrently from several
+// threads and must not modify any state.
+
+class ParallelSorter {
+public:
+    static constexpr int32_t parallelSortThreshold = 32768;
+
+    template <typename DATA_T, typename LESS_T = std::less<DATA_T>>
+    static void Sort(DATA_T* data, int32_t count, LESS_T less = LESS_T()) {
+        if (count < 2)
+            return;
+        if ((count <= parallelSortThreshold) or not jobSystem.IsParallel()) {
+            Sorter::Introsort(data, count, less);
+            return;
+        }
+        JobCounter counter;
+        SortRange(data, data + count, Sorter::DepthLimit(count), less, counter);
+        jobSystem.Wait(counter);
+    }
+
+    template <typename DATA_T, typename LESS_T = std::less<DATA_T>>
+    static inline void Sort(AutoArray<DATA_T>& data, LESS_T less = LESS_T()) {
+        Sort(data.DataPtr(), data.Length(), less);
+    }
+
+private:
+    template <typename DATA_T, typename LESS_T>
+    static void SortRange(DATA_T* first, DATA_T* last, int32_t depth, LESS_T less, JobCounter& counter) {
+        while (last - first > parallelSortThreshold) {
+            if (depth-- == 0) {
+                Sorter::HeapSort(first, last, less);
+                return;
+            }
+            DATA_T* cut = Sorter::Partition(first, last, less);
+            DATA_T* jobFirst;
+            DATA_T* jobLast;
+            if (cut - first < last - cut) {
+                jobFirst = first;
+                jobLast = cut;
+                first = cut;
+            }
+            else {
+                jobFirst = cut;
+                jobLast = last;
+                last = cut;
+            }
+            jobSystem.Submit([jobFirst, jobLast, depth, less, &counter]() {
+                SortRange(jobFirst, jobLast, depth, less, counter);
+                }, &counter);
+        }
+        Sorter::IntrosortLoop(first, last, depth, less);
+    }
+};
+
+// =================================================================================================
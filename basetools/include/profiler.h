@@ -0,0 +1,124 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_MSC_VER) and (defined(_M_X64) or defined(_M_IX86))
+#   include <intrin.h>
+#endif
+
+// =================================================================================================
+// In-process CPU profiler behind the Tracy macros (see tracy_wrapper.h) for builds without Tracy.
+// Each thread records into its own fixed size ring buffer (single producer, no locks); Collect() moves
+// the recorded events into the capture, and WriteTrace() saves the capture as Chrome trace JSON,
+// which chrome://tracing and ui.perfetto.dev open.
+// Recording is off until Enable(true), so profiled code costs one relaxed atomic load per zone when
+// idle; when recording, a zone costs two time stamp reads and one ring buffer write. Time stamps are
+// raw TSC ticks on x86 (steady_clock nanoseconds elsewhere) and are converted when writing.
+// Setting the environment variable PROFILER_TRACE to a file name enables recording at startup and
+// writes the trace there when the process exits.
+// Events which do not fit into a full ring buffer are dropped and counted (see DroppedEvents());
+// FrameMark collects all threads' events, so rings only need to hold one frame's worth.
+// Names must be string literals or otherwise outlive the capture; only their addresses are stored.
+
+class Profiler {
+public:
+    enum class EventType : uint32_t {
+        Zone,       // start .. end
+        Frame,      // frame marker at start
+        Plot,       // counter value at start
+        Message     // instant event at start
+    };
+
+    struct Event {
+        uint64_t        start;
+        uint64_t        end;    // zones: end time; plots: bit pattern of the value
+        const char*     name;
+        EventType       type;
+    };
+
+    static constexpr size_t ringCapacity = size_t(1) << 15;    // events per thread, power of two
+    static constexpr size_t captureCapacity = size_t(1) << 22; // events per capture
+
+private:
+    inline static std::atomic<bool> m_isEnabled{ false };
+
+public:
+    static inline bool IsEnabled(void) noexcept {
+        return m_isEnabled.load(std::memory_order_relaxed);
+    }
+
+    // Starts (discarding the previous capture) or stops recording.
+    static void Enable(bool enable);
+
+    static inline uint64_t Now(void) noexcept {
+#if defined(_MSC_VER) and (defined(_M_X64) or defined(_M_IX86))
+        return __rdtsc();
+#elif (defined(__GNUC__) or defined(__clang__)) and (defined(__x86_64__) or defined(__i386__))
+        return __builtin_ia32_rdtsc();
+#else
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static void Record(EventType type, const char* name, uint64_t start, uint64_t end) noexcept;
+
+    static inline void Zone(const char* name, uint64_t start, uint64_t end) noexcept {
+        Record(EventType::Zone, name, start, end);
+    }
+
+    static void Plot(const char* name, double value) noexcept;
+
+    static inline void Message(const char* text) noexcept {
+        if (IsEnabled())
+            Record(EventType::Message, text, Now(), 0);
+    }
+
+    // frame marker; also collects the events of all threads
+    static void Frame(const char* name = nullptr) noexcept;
+
+    // names the calling thread in traces
+    static void SetThreadName(const char* name);
+
+    // moves the events recorded so far into the capture
+    static void Collect(void);
+
+    // collects and writes the capture as Chrome trace JSON; returns false if the file can't be written
+    static bool WriteTrace(const char* filename);
+
+    // the file WriteTrace() is called with at process exit; nullptr for none
+    static void SetExitTrace(const char* filename);
+
+    // events lost to full ring buffers or a full capture since recording was enabled
+    static uint64_t DroppedEvents(void) noexcept;
+};
+
+// =================================================================================================
+// Times the enclosing scope. Whether the zone is recorded is decided when it opens.
+
+class ProfileZone {
+private:
+    const char* m_name;
+    uint64_t    m_start;
+
+public:
+    explicit ProfileZone(const char* name) noexcept
+        : m_name(name), m_start(Profiler::IsEnabled() ? Profiler::Now() : 0)
+    { }
+
+    ~ProfileZone() {
+        if (m_start)
+            Profiler::Zone(m_name, m_start, Profiler::Now());
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+// =================================================================================================
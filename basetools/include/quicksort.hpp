@@ -8,10 +8,15 @@
 #	define __cdecl
 #endif
 
+#include <cstdint>
 #include <stdexcept>
+#include "sort.hpp"
 
 //-----------------------------------------------------------------------------
 
+// Sorting interface of the custom containers, kept for source compatibility. The sorting itself is
+// done by Sorter (introsort, or radix sort for long arrays of numbers); all bounds are inclusive.
+
 template < typename DATA_T > 
 class QuickSort {
 	public:
@@ -20,126 +25,36 @@ class QuickSort {
 		template<typename KEY_T>
 		using tSearchComparator = int(__cdecl*)(const DATA_T&, const KEY_T&);
 
-		// holds a copy of the median data for sorting; one global variable should work 
-		// as it is only used during the sorting part and not during the recursive descent
-		tComparator	m_compare;
-		DATA_T		m_median;
-
-//-----------------------------------------------------------------------------
-
-inline void Swap(DATA_T* left, DATA_T* right)
-{
-	DATA_T h;
-	memcpy (&h, left, sizeof (DATA_T));
-	memcpy(left, right, sizeof(DATA_T));
-	memcpy(right, &h, sizeof(DATA_T));
-	memset(&h, 0, sizeof(DATA_T));
-}
-
-//-----------------------------------------------------------------------------
-
-void SortAscending(DATA_T* data, int32_t left, int32_t right)
-{
-	int32_t	l = left,
-			r = right;
-	DATA_T*	m = new DATA_T(data [(l + r) / 2]);
-
-	do {
-		while (data[l] < *m)
-			l++;
-		while (data[r] > *m)
-			r--;
-		if (l <= r) {
-			if (l < r)
-				Swap(data + l, data + r);
-			l++;
-			r--;
-		}
-	} while (l <= r);
-	memset(&m_median, 0, sizeof(DATA_T));
-
-	if (l < right)
-		SortAscending(data, l, right);
-	if (left < r)
-		SortAscending(data, left, r);
-}
-
 //-----------------------------------------------------------------------------
 
-void SortDescending(DATA_T* data, int32_t left, int32_t right)
+static void SortAscending(DATA_T* data, int32_t left, int32_t right)
 {
-	int32_t	l = left,
-			r = right;
-
-	memcpy(&m_median, data + (l + r) / 2, sizeof(DATA_T));
-	do {
-		while (data[l] > m_median)
-			l++;
-		while (data[r] < m_median)
-			r--;
-		if (l <= r) {
-			if (l < r)
-				Swap(data + l, data + r);
-			l++;
-			r--;
-		}
-	} while (l <= r);
-	memset(&m_median, 0, sizeof(DATA_T));
-
-	if (l < right)
-		SortDescending(data, l, right);
-	if (left < r)
-		SortDescending(data, left, r);
+	if (right > left)
+		Sorter::SortAscending(data + left, right - left + 1);
 }
 
 //-----------------------------------------------------------------------------
 
-void Sort(DATA_T* data, int32_t left, int32_t right, int direction)
+static void SortDescending(DATA_T* data, int32_t left, int32_t right)
 {
-	int32_t	l = left,
-			r = right;
-	
-	// flat copy to avoid any complicated copy operations; data only needed to have a fixed median value
-	memcpy(&m_median, data + (l + r) / 2, sizeof(DATA_T)); 
-	do {
-		while (direction * m_compare(data + l, &m_median) > 0)
-			l++;
-		while (direction * m_compare(data + r, &m_median) < 0)
-			r--;
-		if (l <= r) {
-			if (l < r)
-				Swap(data + l, data + r);
-			l++;
-			r--;
-		}
-	} while (l <= r);
-	// make sure m_median doesn't contain any d'tors
-	memset(&m_median, 0, sizeof(DATA_T)); 
-
-	if (l < right)
-		Sort(data, l, right, direction);
-	if (left < r)
-		Sort(data, left, r, direction);
+	if (right > left)
+		Sorter::SortDescending(data + left, right - left + 1);
 }
 
 //-----------------------------------------------------------------------------
 
-void SortDescending(DATA_T* data, int32_t left, int32_t right, tComparator compare)
+static void SortDescending(DATA_T* data, int32_t left, int32_t right, tComparator compare)
 {
-	if (right - left > 1) {
-		m_compare = compare;
-		Sort(data, left, right, 1);
-	}
+	if (right > left)
+		Sorter::Introsort(data + left, right - left + 1, [compare](const DATA_T& a, const DATA_T& b) { return compare(&a, &b) > 0; });
 }
 
 //-----------------------------------------------------------------------------
 
-void SortAscending(DATA_T* data, int32_t left, int32_t right, tComparator compare)
+static void SortAscending(DATA_T* data, int32_t left, int32_t right, tComparator compare)
 {
-	if (right - left > 1) {
-		m_compare = compare;
-		Sort(data, left, right, -1);
-	}
+	if (right > left)
+		Sorter::Introsort(data + left, right - left + 1, [compare](const DATA_T& a, const DATA_T& b) { return compare(&a, &b) < 0; });
 }
 
 // ----------------------------------------------------------------------------
@@ -1,32 +1,201 @@
 #pragma once
 
+#include <span>
+#include <atomic>
 #include <random>
+#include <cstdint>
+#include <cstddef>
 #include "basesingleton.hpp"
 
 // =================================================================================================
+// Counter based random number generator (Philox4x32-10, Salmon et al., "Parallel Random Numbers: As
+// Easy as 1, 2, 3"). Output block n of a stream is a pure function of (seed, stream, n): the 128 bit
+// counter holds the block index and the stream id, the 64 bit key is the seed. So
+// - streams with different ids are independent, and Split() creates one without any communication,
+//   e.g. one per job or work item, all derived from a single seed;
+// - blocks can be computed in any order and in parallel, which the SIMD batch paths of Fill() do.
+// The sequence is the same whichever SIMD level Fill() runs at, and the same whether values are
+// drawn one at a time or in batches: each block yields 4 consecutive 32 bit values.
 
-class Random 
-    : public BaseSingleton<Random> 
+class RandomStream {
+public:
+    static constexpr size_t blockSize = 4;
+
+private:
+    uint32_t    m_key[2];
+    uint64_t    m_stream;
+    uint64_t    m_block{ 0 };        // index of the next block to generate
+    uint32_t    m_buffer[blockSize];
+    uint32_t    m_buffered{ 0 };     // values left in m_buffer (taken from its end)
+
+public:
+    explicit RandomStream(uint64_t seed = 0, uint64_t stream = 0) noexcept
+        : m_key{ uint32_t(seed), uint32_t(seed >> 32) }, m_stream(stream)
+    { }
+
+    // a new stream with the same seed: independent of this one and reproducible from (seed, stream)
+    inline RandomStream Split(uint64_t stream) const noexcept {
+        return RandomStream(Seed(), stream);
+    }
+
+    inline uint64_t Seed(void) const noexcept { return uint64_t(m_key[0]) | (uint64_t(m_key[1]) << 32); }
+
+    inline uint64_t StreamId(void) const noexcept { return m_stream; }
+
+    inline uint32_t Next32(void) noexcept {
+        if (not m_buffered) {
+            Block(m_key, m_block++, m_stream, m_buffer);
+            m_buffered = blockSize;
+        }
+        return m_buffer[blockSize - m_buffered--];
+    }
+
+    inline uint64_t Next64(void) noexcept {
+        uint64_t lo = Next32();
+        return lo | (uint64_t(Next32()) << 32);
+    }
+
+    // [0, 1) with 24 bit resolution
+    inline float Float(void) noexcept {
+        return ToFloat(Next32());
+    }
+
+    inline float Float(float scale) noexcept {
+        return Float() * scale;
+    }
+
+    // [0, range) without bias (Lemire, "Fast Random Integer Generation in an Interval"); 0 if range is 0
+    uint32_t Bounded(uint32_t range) noexcept {
+        uint64_t m = uint64_t(Next32()) * range;
+        if (uint32_t(m) < range) {
+            uint32_t threshold = uint32_t(-range) % range;
+            while (uint32_t(m) < threshold)
+                m = uint64_t(Next32()) * range;
+        }
+        return uint32_t(m >> 32);
+    }
+
+    // [0, maxValue - 1]; 0 if maxValue <= 0
+    inline int32_t Int(int32_t maxValue) noexcept {
+        return (maxValue > 0) ? int32_t(Bounded(uint32_t(maxValue))) : 0;
+    }
+
+    // [minValue, maxValue]
+    inline int32_t Int(int32_t minValue, int32_t maxValue) noexcept {
+        // the range of Int(INT32_MIN, INT32_MAX) wraps to 0: any 32 bit value will do then
+        uint32_t range = uint32_t(maxValue) - uint32_t(minValue) + 1;
+        return int32_t(uint32_t(minValue) + (range ? Bounded(range) : Next32()));
+    }
+
+    // the next values.Length() values of the stream
+    void Fill(std::span<uint32_t> values) noexcept;
+
+    // uniform floats in [0, 1) * scale
+    void Fill(std::span<float> values, float scale = 1.0f) noexcept;
+
+    static inline float ToFloat(uint32_t u) noexcept {
+        return float(u >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Philox4x32-10 block for counter (block, stream)
+    static inline void Block(const uint32_t key[2], uint64_t block, uint64_t stream, uint32_t out[blockSize]) noexcept {
+        uint32_t c0 = uint32_t(block), c1 = uint32_t(block >> 32), c2 = uint32_t(stream), c3 = uint32_t(stream >> 32);
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int r = 0; r < 10; ++r) {
+            if (r) {
+                k0 += weyl0;
+                k1 += weyl1;
+            }
+            uint64_t p0 = uint64_t(multiplier0) * c0;
+            uint64_t p1 = uint64_t(multiplier1) * c2;
+            uint32_t n0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+            uint32_t n2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+            c1 = uint32_t(p1);
+            c3 = uint32_t(p0);
+            c0 = n0;
+            c2 = n2;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+
+    static constexpr uint32_t multiplier0 = 0xD2511F53u;
+    static constexpr uint32_t multiplier1 = 0xCD9E8D57u;
+    static constexpr uint32_t weyl0 = 0x9E3779B9u;
+    static constexpr uint32_t weyl1 = 0xBB67AE85u;
+
+private:
+    // generates blockCount whole blocks into values
+    static void Blocks(const uint32_t key[2], uint64_t block, uint64_t stream, uint32_t* values, size_t blockCount) noexcept;
+};
+
+// =================================================================================================
+// Per thread random numbers for casual use (jitter, effects). Every thread draws from its own
+// RandomStream; all of them derive from one process wide seed, which is random unless set by
+// Seed(). Job system threads use their thread index as stream id, so after Seed() each worker's
+// sequence is reproducible. Which job runs on which worker is not, though: work which must come out
+// identical on any thread count (e.g. noise bakes) should instead use RandomStream(seed, itemIndex)
+// per work item.
+
+class Random
+    : public BaseSingleton<Random>
 {
 private:
-    inline static thread_local std::mt19937 rng{ std::random_device{}() };
-    inline static thread_local std::uniform_real_distribution<float> floatDist{ 0.0f, 1.0f };
+    // threads outside the job system get stream ids above this
+    static constexpr uint64_t foreignStreams = uint64_t(1) << 32;
+
+    inline static std::atomic<uint64_t> seed{ (uint64_t(std::random_device{}()) << 32) | std::random_device{}() };
+    inline static std::atomic<uint32_t> generation{ 0 };
+    inline static std::atomic<uint64_t> foreignStreamCount{ 0 };
+
+    struct ThreadStream {
+        RandomStream    stream;
+        uint32_t        generation;
+
+        ThreadStream() noexcept
+            : generation(~0u)   // differs from any current generation, so the first use seeds the stream
+        { }
+    };
+
+    inline static thread_local ThreadStream threadStream;
 
 public:
-    static float Float(float scale = 1.0f)
+    // Reseeds the streams of all threads; they restart from the beginning of their sequence when
+    // they draw their next number.
+    static void Seed(uint64_t value) noexcept {
+        seed.store(value, std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // the calling thread's stream, e.g. for batch generation with Fill()
+    static RandomStream& Stream(void) noexcept {
+        uint32_t g = generation.load(std::memory_order_acquire);
+        if (threadStream.generation != g) {
+            threadStream.stream = RandomStream(seed.load(std::memory_order_relaxed), ThreadStreamId());
+            threadStream.generation = g;
+        }
+        return threadStream.stream;
+    }
+
+    static float Float(float scale = 1.0f) // [0,1)
     {
-        return floatDist(rng) * scale; // [0,1)
+        return Stream().Float(scale);
     }
 
     static int Int(int maxValue) // [0, maxValue-1]
     {
-        return static_cast<int>(Float() * maxValue);
+        return Stream().Int(maxValue);
     }
 
     static int Int(int minValue, int maxValue) // [minValue, maxValue]
     {
-        return Int(maxValue - minValue + 1) + minValue;
+        return Stream().Int(minValue, maxValue);
     }
+
+private:
+    static uint64_t ThreadStreamId(void) noexcept;
 };
 
 #define random Random::Instance()
@@ -1,7 +1,399 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
 #pragma once
 
-#include "list.hpp"
+#include <new>
+#include <memory>
+#include <vector>
+#include <span>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+
+// =================================================================================================
+// Unrolled list: items are stored in fixed size contiguous segments which are only allocated when
+// the preceding segments are full. Appending is O(1) and doesn't move existing items, so pointers
+// to items stay valid. Indexed access is O(1). Cleared segments are kept for reuse until Destroy().
+// Items can only be appended or removed at the end; use List if random insertion is required.
+// Segment-wise access (Segment(), CopyTo()) allows block copies of the data, e.g. into gfx buffers.
 
 template <typename ITEM_T>
-using SegmentedList = List<ITEM_T>;
+class SegmentedList
+{
+public:
+    using ItemType = ITEM_T;
+
+    static constexpr int32_t defaultSegmentSize = 64;
+
+private:
+    std::vector<ItemType*>  m_segments;     // all allocated segments, including unused ones
+    int32_t                 m_segmentSize;
+    int32_t                 m_length;
+
+    //-----------------------------------------------------------------------------
+
+public:
+    template <bool IS_CONST>
+    class Iterator {
+    public:
+        using ListType = std::conditional_t<IS_CONST, const SegmentedList, SegmentedList>;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ItemType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IS_CONST, const ItemType*, ItemType*>;
+        using reference = std::conditional_t<IS_CONST, const ItemType&, ItemType&>;
+
+    private:
+        ListType*   m_list;
+        pointer     m_item;         // nullptr at end of list
+        pointer     m_segmentEnd;
+        int32_t     m_segment;
+
+    public:
+        Iterator() noexcept
+            : m_list(nullptr), m_item(nullptr), m_segmentEnd(nullptr), m_segment(0)
+        { }
+
+        Iterator(ListType* list, int32_t segment) noexcept
+            : m_list(list), m_item(nullptr), m_segmentEnd(nullptr), m_segment(segment)
+        {
+            EnterSegment();
+        }
+
+        inline reference operator*() const noexcept { return *m_item; }
+
+        inline pointer operator->() const noexcept { return m_item; }
+
+        inline Iterator& operator++() noexcept {
+            if (++m_item == m_segmentEnd) {
+                ++m_segment;
+                EnterSegment();
+            }
+            return *this;
+        }
+
+        inline Iterator operator++(int) noexcept {
+            Iterator i = *this;
+            ++(*this);
+            return i;
+        }
+
+        inline bool operator==(const Iterator& other) const noexcept { return m_item == other.m_item; }
+
+        inline bool operator!=(const Iterator& other) const noexcept { return m_item != other.m_item; }
+
+    private:
+        inline void EnterSegment(void) noexcept {
+            if (not m_list or (m_segment >= m_list->SegmentCount()))
+                m_item = m_segmentEnd = nullptr;
+            else {
+                std::span<std::remove_pointer_t<pointer>> s = m_list->Segment(m_segment);
+                m_item = s.data();
+                m_segmentEnd = s.data() + s.size();
+            }
+        }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    //-----------------------------------------------------------------------------
+
+public:
+    SegmentedList(int32_t segmentSize = defaultSegmentSize) noexcept
+        : m_segmentSize((segmentSize > 1) ? segmentSize : defaultSegmentSize), m_length(0)
+    { }
+
+    SegmentedList(std::initializer_list<ItemType> itemList)
+        : SegmentedList()
+    {
+        *this = itemList;
+    }
+
+    SegmentedList(const SegmentedList& other)
+        : SegmentedList(other.m_segmentSize)
+    {
+        Copy(other);
+    }
+
+    SegmentedList(SegmentedList&& other) noexcept
+        : SegmentedList(other.m_segmentSize)
+    {
+        Swap(other);
+    }
+
+    ~SegmentedList() {
+        Destroy();
+    }
+
+    // the segment size can only be changed as long as no segments have been allocated
+    inline bool SetSegmentSize(int32_t segmentSize) noexcept {
+        if (not m_segments.empty())
+            return false;
+        m_segmentSize = (segmentSize > 1) ? segmentSize : defaultSegmentSize;
+        return true;
+    }
+
+    inline int32_t SegmentSize(void) const noexcept {
+        return m_segmentSize;
+    }
+
+    // number of segments holding items
+    inline int32_t SegmentCount(void) const noexcept {
+        return (m_length + m_segmentSize - 1) / m_segmentSize;
+    }
+
+    // contiguous items of segment i
+    inline std::span<ItemType> Segment(int32_t i) noexcept {
+        return std::span<ItemType>(m_segments[i], size_t(SegmentLength(i)));
+    }
+
+    inline std::span<const ItemType> Segment(int32_t i) const noexcept {
+        return std::span<const ItemType>(m_segments[i], size_t(SegmentLength(i)));
+    }
+
+    inline int32_t Capacity(void) const noexcept {
+        return int32_t(m_segments.size()) * m_segmentSize;
+    }
+
+    bool Reserve(int32_t capacity) noexcept {
+        while (Capacity() < capacity) {
+            if (not AllocSegment())
+                return false;
+        }
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    inline ItemType& operator[](int32_t i) {
+        if (i < 0)
+            i += m_length;
+        if ((i < 0) or (i >= m_length))
+            throw std::out_of_range("SegmentedList index out of range.");
+        return *Item(i);
+    }
+
+    inline const ItemType& operator[](int32_t i) const {
+        return const_cast<SegmentedList&>(*this)[i];
+    }
+
+    template <typename... ARGS>
+        requires std::constructible_from<ItemType, ARGS&&...>
+    ItemType* Append(ARGS&&... args) noexcept {
+        if ((m_length == Capacity()) and not AllocSegment())
+            return nullptr;
+        ItemType* item = Item(m_length);
+        try {
+            std::construct_at(item, std::forward<ARGS>(args)...);
+        }
+        catch (...) {
+            return nullptr;
+        }
+        ++m_length;
+        return item;
+    }
+
+    template <typename T>
+    inline void Push(T&& value) {
+        Append(std::forward<T>(value));
+    }
+
+    ItemType Pop(void) {
+        if (not m_length)
+            return ItemType();
+        ItemType* item = Item(m_length - 1);
+        ItemType value = std::move(*item);
+        DiscardLast();
+        return value;
+    }
+
+    bool Pop(ItemType& value) {
+        if (not m_length)
+            return false;
+        value = std::move(*Item(m_length - 1));
+        DiscardLast();
+        return true;
+    }
+
+    inline void DiscardLast(void) noexcept {
+        if (m_length)
+            std::destroy_at(Item(--m_length));
+    }
+
+    template<typename T>
+    int Find(T&& data) const {
+        const ItemType& pattern = data;
+        int i = 0;
+        for (const auto& value : *this) {
+            if (value == pattern)
+                return i;
+            ++i;
+        }
+        return -1;
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    // copy all items to a buffer of at least Length() items. Trivially copyable items are copied one segment at a time.
+    ItemType* CopyTo(ItemType* dest) const {
+        for (int32_t i = 0, l = SegmentCount(); i < l; ++i) {
+            std::span<const ItemType> s = Segment(i);
+            if constexpr (std::is_trivially_copyable_v<ItemType>)
+                memcpy(dest, s.data(), s.size_bytes());
+            else
+                std::uninitialized_copy(s.begin(), s.end(), dest);
+            dest += s.size();
+        }
+        return dest;
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    // remove all items; the segments are kept for reuse
+    void Clear(void) noexcept {
+        if constexpr (not std::is_trivially_destructible_v<ItemType>) {
+            for (ItemType& item : *this)
+                std::destroy_at(&item);
+        }
+        m_length = 0;
+    }
+
+    inline void Reset(void) noexcept {
+        Clear();
+    }
+
+    void Destroy(void) noexcept {
+        Clear();
+        for (ItemType* segment : m_segments)
+            ::operator delete(segment, std::align_val_t(alignof(ItemType)));
+        m_segments.clear();
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    SegmentedList& operator=(std::initializer_list<ItemType> itemList) {
+        Clear();
+        Reserve(int32_t(itemList.size()));
+        for (const auto& item : itemList)
+            Append(item);
+        return *this;
+    }
+
+    SegmentedList& operator=(const SegmentedList& other) {
+        if (this != &other) {
+            Clear();
+            Copy(other);
+        }
+        return *this;
+    }
+
+    SegmentedList& operator=(SegmentedList&& other) noexcept {
+        if (this != &other) {
+            Destroy();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    // copy-append
+    SegmentedList& Copy(const SegmentedList& other) {
+        Reserve(m_length + other.m_length);
+        for (int32_t i = 0, l = other.m_length; i < l; ++i) // other may be this list
+            Append(*other.Item(i));
+        return *this;
+    }
+
+    // move-append
+    SegmentedList& Move(SegmentedList& other) {
+        if (not m_length)
+            Swap(other);
+        else {
+            Reserve(m_length + other.m_length);
+            for (auto& item : other)
+                Append(std::move(item));
+        }
+        other.Clear();
+        return *this;
+    }
+
+    inline SegmentedList& operator+=(const SegmentedList& other) {
+        return Copy(other);
+    }
+
+    inline SegmentedList& operator+=(SegmentedList&& other) {
+        return Move(other);
+    }
+
+    inline SegmentedList& AppendList(const SegmentedList& other) {
+        return Copy(other);
+    }
+
+    void Swap(SegmentedList& other) noexcept {
+        std::swap(m_segments, other.m_segments);
+        std::swap(m_segmentSize, other.m_segmentSize);
+        std::swap(m_length, other.m_length);
+    }
+
+    //-----------------------------------------------------------------------------
+
+public:
+    inline int32_t Length(void) const noexcept { return m_length; }
+
+    inline size_t size(void) const noexcept { return size_t(m_length); }
+
+    inline bool IsEmpty(void) const noexcept { return m_length == 0; }
+
+    inline ItemType& First(void) noexcept { return *Item(0); }
+
+    inline const ItemType& First(void) const noexcept { return *Item(0); }
+
+    inline ItemType& Last(void) noexcept { return *Item(m_length - 1); }
+
+    inline const ItemType& Last(void) const noexcept { return *Item(m_length - 1); }
+
+    inline iterator begin() noexcept { return iterator(this, 0); }
+
+    inline iterator end() noexcept { return iterator(); }
+
+    inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    inline const_iterator end() const noexcept { return const_iterator(); }
+
+    //-----------------------------------------------------------------------------
+
+private:
+    inline ItemType* Item(int32_t i) const noexcept {
+        return m_segments[i / m_segmentSize] + i % m_segmentSize;
+    }
+
+    inline int32_t SegmentLength(int32_t i) const noexcept {
+        int32_t l = m_length - i * m_segmentSize;
+        return (l < m_segmentSize) ? l : m_segmentSize;
+    }
+
+    bool AllocSegment(void) noexcept {
+        void* segment = ::operator new(sizeof(ItemType) * size_t(m_segmentSize), std::align_val_t(alignof(ItemType)), std::nothrow);
+        if (not segment)
+            return false;
+        try {
+            m_segments.push_back(static_cast<ItemType*>(segment));
+        }
+        catch (...) {
+            ::operator delete(segment, std::align_val_t(alignof(ItemType)));
+            return false;
+        }
+        return true;
+    }
+};
 
+// =================================================================================================
@@ -0,0 +1,42 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <cstdint>
+
+// =================================================================================================
+// Instruction set levels for kernels with runtime dispatch (MatrixKernels, RandomStream batches).
+// Kernel sources include <immintrin.h> themselves when SIMD_X86 is set and mark every function using
+// SSE4.1 or AVX2 intrinsics with SIMD_TARGET_SSE4 / SIMD_TARGET_AVX2, so the rest of the program
+// does not need to be compiled for these instruction sets. MSVC needs no such markers.
+
+#if defined(__x86_64__) or defined(_M_X64) or defined(__i386__) or defined(_M_IX86)
+#   define SIMD_X86 1
+#   if defined(_MSC_VER) and not defined(__clang__)
+#       define SIMD_TARGET_SSE4
+#       define SIMD_TARGET_AVX2
+#   else
+#       define SIMD_TARGET_SSE4 __attribute__((target("sse4.1")))
+#       define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#   endif
+#else
+#   define SIMD_X86 0
+#endif
+
+class Simd {
+public:
+    enum class Level : int32_t {
+        Scalar,
+        SSE4,   // SSE4.1
+        AVX2    // AVX2 + FMA
+    };
+
+    // best level supported by the CPU and the OS; detected once
+    static Level SupportedLevel(void) noexcept;
+
+    static const char* LevelName(Level level) noexcept;
+};
+
+// =================================================================================================
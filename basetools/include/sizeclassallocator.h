@@ -0,0 +1,90 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+
+// SIZE_CLASS_DEBUG 1 surrounds every block with guard bytes which are checked when the block is freed,
+// and keeps a list of all live blocks for leak reports. It costs memory and a global lock per call.
+#ifndef SIZE_CLASS_DEBUG
+#   ifdef _DEBUG
+#       define SIZE_CLASS_DEBUG 1
+#   else
+#       define SIZE_CLASS_DEBUG 0
+#   endif
+#endif
+
+// =================================================================================================
+// General purpose allocator for small blocks. Requests up to maxClassSize bytes are rounded up to one
+// of classCount size classes (16 byte steps up to 128 bytes, then four classes per power of two).
+// Each size class has a segregated free list per thread, so Allocate() and Free() are O(1) and lock
+// free in the common case; threads exchange blocks in batches with a central free list per class,
+// which is refilled by carving chunks obtained from the system allocator. Chunks are never returned.
+// Larger requests are passed through to malloc.
+// The allocator is a process wide, never destroyed object, so it can back the global operator new.
+
+class SizeClassAllocator {
+public:
+    static constexpr int32_t classCount = 40;
+    static constexpr size_t maxClassSize = 32768;
+    static constexpr size_t chunkSize = 256 * 1024;
+
+    struct ClassStats {
+        size_t      blockSize;      // usable bytes of the blocks of this class
+        uint64_t    allocations;
+        uint64_t    releases;
+    };
+
+    struct Stats {
+        size_t      liveBytes;      // requested bytes of all live blocks
+        size_t      peakBytes;      // highest liveBytes value so far
+        size_t      systemBytes;    // memory obtained from the system for size classes
+        uint64_t    largeAllocations;
+        uint64_t    largeReleases;
+        ClassStats  classes[classCount];
+    };
+
+    static void* Allocate(size_t size) noexcept;
+
+    static void Free(void* p) noexcept;
+
+    // usable size of a block returned by Allocate()
+    static size_t BlockSize(const void* p) noexcept;
+
+    static Stats GetStats(void) noexcept;
+
+    static void PrintStats(FILE* stream = stderr) noexcept;
+
+    // Only with SIZE_CLASS_DEBUG: check the guard bytes of all live blocks, report live blocks.
+    // Both return the number of corrupted/live blocks found.
+    static int32_t CheckIntegrity(FILE* stream = stderr) noexcept;
+
+    static int32_t ReportLeaks(FILE* stream = stderr) noexcept;
+
+    static constexpr int32_t SizeClass(size_t size) noexcept {
+        if (size <= 128)
+            return (size <= 16) ? 0 : int32_t((size + 15) / 16) - 1;
+        size_t s = size - 1;
+        int32_t bits = 0;
+        while (s >> bits)
+            ++bits;
+        // 2^(bits-1) < size <= 2^bits: four classes in this range
+        return 8 + (bits - 8) * 4 + int32_t((s - (size_t(1) << (bits - 1))) >> (bits - 3));
+    }
+
+    static constexpr size_t ClassSize(int32_t sizeClass) noexcept {
+        if (sizeClass < 8)
+            return size_t(sizeClass + 1) * 16;
+        int32_t bits = 8 + (sizeClass - 8) / 4;
+        return (size_t(1) << (bits - 1)) + (size_t((sizeClass - 8) % 4 + 1) << (bits - 3));
+    }
+};
+
+static_assert(SizeClassAllocator::SizeClass(SizeClassAllocator::maxClassSize) == SizeClassAllocator::classCount - 1, "size class table mismatch");
+static_assert(SizeClassAllocator::ClassSize(SizeClassAllocator::classCount - 1) == SizeClassAllocator::maxClassSize, "size class table mismatch");
+
+// =================================================================================================
@@ -0,0 +1,290 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <new>
+#include <span>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+
+// =================================================================================================
+// Array with inline storage for INLINE_CAPACITY items. As long as it holds no more items than that,
+// it does not touch the heap; when it grows beyond, the items move to a heap buffer (doubling its
+// capacity on every growth) and stay there until Reset() or destruction. Use it for arrays which are
+// small and short lived most of the time, e.g. per draw or per message temporaries.
+// The interface is the AutoArray-style capitalized one plus std style iterators (plain pointers).
+// Like with std::vector, growing invalidates pointers to items; and since inline items move with
+// the array, so does moving the array.
+
+template <typename DATA_T, int32_t INLINE_CAPACITY>
+class SmallArray {
+    static_assert(INLINE_CAPACITY > 0, "SmallArray inline capacity must be positive");
+
+private:
+    DATA_T*                     m_data;
+    int32_t                     m_length{ 0 };
+    int32_t                     m_capacity{ INLINE_CAPACITY };
+    alignas(DATA_T) std::byte   m_storage[sizeof(DATA_T) * INLINE_CAPACITY];
+
+public:
+    using value_type = DATA_T;
+    using iterator = DATA_T*;
+    using const_iterator = const DATA_T*;
+
+    static constexpr int32_t inlineCapacity = INLINE_CAPACITY;
+
+    SmallArray() noexcept
+        : m_data(InlineData())
+    { }
+
+    SmallArray(std::initializer_list<DATA_T> data)
+        : m_data(InlineData())
+    {
+        CopyConstruct(data.begin(), int32_t(data.size()));
+    }
+
+    SmallArray(const SmallArray& other)
+        : m_data(InlineData())
+    {
+        CopyConstruct(other.m_data, other.m_length);
+    }
+
+    SmallArray(SmallArray&& other) noexcept(std::is_nothrow_move_constructible_v<DATA_T>)
+        : m_data(InlineData())
+    {
+        MoveFrom(other);
+    }
+
+    ~SmallArray() {
+        Reset();
+    }
+
+    SmallArray& operator=(const SmallArray& other) {
+        if (this != &other) {
+            Clear();
+            Reserve(other.m_length);
+            std::uninitialized_copy_n(other.m_data, other.m_length, m_data);
+            m_length = other.m_length;
+        }
+        return *this;
+    }
+
+    SmallArray& operator=(SmallArray&& other) noexcept(std::is_nothrow_move_constructible_v<DATA_T>) {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    // Constructs a new item at the end of the array and returns a pointer to it. args may refer to
+    // items of the array.
+    template <typename... ARGS>
+    DATA_T* Append(ARGS&&... args) {
+        if (m_length < m_capacity)
+            return std::construct_at(m_data + m_length++, std::forward<ARGS>(args)...);
+        // construct the new item before the existing ones are moved, in case args refer to one of them
+        int32_t capacity = m_capacity * 2;
+        DATA_T* data = Allocate(capacity);
+        DATA_T* item;
+        try {
+            item = std::construct_at(data + m_length, std::forward<ARGS>(args)...);
+        }
+        catch (...) {
+            Deallocate(data, capacity);
+            throw;
+        }
+        try {
+            Relocate(data);
+        }
+        catch (...) {
+            std::destroy_at(item);
+            Deallocate(data, capacity);
+            throw;
+        }
+        m_capacity = capacity;
+        ++m_length;
+        return item;
+    }
+
+    inline bool Push(const DATA_T& data) {
+        return Append(data) != nullptr;
+    }
+
+    // removes the last item and returns it; the array must not be empty
+    DATA_T Pop(void) {
+        DATA_T data = std::move(m_data[m_length - 1]);
+        std::destroy_at(m_data + --m_length);
+        return data;
+    }
+
+    void Reserve(int32_t capacity) {
+        if (capacity <= m_capacity)
+            return;
+        DATA_T* data = Allocate(capacity);
+        try {
+            Relocate(data);
+        }
+        catch (...) {
+            Deallocate(data, capacity);
+            throw;
+        }
+        m_capacity = capacity;
+    }
+
+    // Sets the length of the array. New items are value initialized. Returns the first item.
+    DATA_T* Resize(int32_t length) {
+        if (length < m_length)
+            Truncate(length);
+        else if (length > m_length) {
+            if (length > m_capacity)
+                Reserve(std::max(length, m_capacity * 2));
+            std::uninitialized_value_construct(m_data + m_length, m_data + length);
+            m_length = length;
+        }
+        return m_data;
+    }
+
+    DATA_T* Resize(int32_t length, const DATA_T& value) {
+        if (length < m_length)
+            Truncate(length);
+        else if (length > m_length) {
+            if (length > m_capacity) {
+                DATA_T v = value; // value may be an item of this array
+                Reserve(length);
+                std::uninitialized_fill(m_data + m_length, m_data + length, v);
+            }
+            else
+                std::uninitialized_fill(m_data + m_length, m_data + length, value);
+            m_length = length;
+        }
+        return m_data;
+    }
+
+    // destroys all items, but keeps the memory
+    inline void Clear(void) noexcept {
+        Truncate(0);
+    }
+
+    // destroys all items and returns to the inline storage
+    void Reset(void) noexcept {
+        Clear();
+        if (not IsInline()) {
+            Deallocate(m_data, m_capacity);
+            m_data = InlineData();
+            m_capacity = INLINE_CAPACITY;
+        }
+    }
+
+    inline int32_t Length(void) const noexcept { return m_length; }
+
+    inline int32_t Capacity(void) const noexcept { return m_capacity; }
+
+    inline bool IsEmpty(void) const noexcept { return m_length == 0; }
+
+    // true while the items are held in the inline storage
+    inline bool IsInline(void) const noexcept { return m_data == InlineData(); }
+
+    inline bool IsValidIndex(int32_t i) const noexcept { return (i >= 0) and (i < m_length); }
+
+    inline DATA_T* Data(void) noexcept { return m_data; }
+
+    inline const DATA_T* Data(void) const noexcept { return m_data; }
+
+    inline DATA_T* DataPtr(int32_t i = 0) noexcept { return m_data + i; }
+
+    inline const DATA_T* DataPtr(int32_t i = 0) const noexcept { return m_data + i; }
+
+    inline DATA_T& operator[](int32_t i) noexcept { return m_data[i]; }
+
+    inline const DATA_T& operator[](int32_t i) const noexcept { return m_data[i]; }
+
+    inline std::span<DATA_T> Span(void) noexcept { return std::span<DATA_T>(m_data, size_t(m_length)); }
+
+    inline std::span<const DATA_T> Span(void) const noexcept { return std::span<const DATA_T>(m_data, size_t(m_length)); }
+
+    inline DATA_T* begin(void) noexcept { return m_data; }
+
+    inline DATA_T* end(void) noexcept { return m_data + m_length; }
+
+    inline const DATA_T* begin(void) const noexcept { return m_data; }
+
+    inline const DATA_T* end(void) const noexcept { return m_data + m_length; }
+
+    inline auto rbegin(void) noexcept { return std::reverse_iterator<DATA_T*>(end()); }
+
+    inline auto rend(void) noexcept { return std::reverse_iterator<DATA_T*>(begin()); }
+
+    inline auto rbegin(void) const noexcept { return std::reverse_iterator<const DATA_T*>(end()); }
+
+    inline auto rend(void) const noexcept { return std::reverse_iterator<const DATA_T*>(begin()); }
+
+private:
+    inline DATA_T* InlineData(void) noexcept { return reinterpret_cast<DATA_T*>(m_storage); }
+
+    inline const DATA_T* InlineData(void) const noexcept { return reinterpret_cast<const DATA_T*>(m_storage); }
+
+    static inline DATA_T* Allocate(int32_t capacity) {
+        return std::allocator<DATA_T>().allocate(size_t(capacity));
+    }
+
+    static inline void Deallocate(DATA_T* data, int32_t capacity) noexcept {
+        std::allocator<DATA_T>().deallocate(data, size_t(capacity));
+    }
+
+    inline void Truncate(int32_t length) noexcept {
+        std::destroy(m_data + length, m_data + m_length);
+        m_length = length;
+    }
+
+    // Moves the items to data and releases the current heap buffer; the caller sets m_capacity. Items
+    // which may throw when moved are copied, so the array is unchanged if that fails.
+    void Relocate(DATA_T* data) noexcept(std::is_nothrow_move_constructible_v<DATA_T>) {
+        if constexpr (std::is_nothrow_move_constructible_v<DATA_T> or not std::is_copy_constructible_v<DATA_T>)
+            std::uninitialized_move_n(m_data, m_length, data);
+        else
+            std::uninitialized_copy_n(m_data, m_length, data);
+        std::destroy_n(m_data, m_length);
+        if (not IsInline())
+            Deallocate(m_data, m_capacity);
+        m_data = data;
+    }
+
+    // Copies length items into the empty array being constructed. If a copy throws, the destructor
+    // won't run, so the heap buffer is released here (uninitialized_copy_n destroys the items already
+    // copied).
+    void CopyConstruct(const DATA_T* data, int32_t length) {
+        Reserve(length);
+        try {
+            std::uninitialized_copy_n(data, length, m_data);
+        }
+        catch (...) {
+            Reset();
+            throw;
+        }
+        m_length = length;
+    }
+
+    void MoveFrom(SmallArray& other) noexcept(std::is_nothrow_move_constructible_v<DATA_T>) {
+        if (other.IsInline()) {
+            std::uninitialized_move_n(other.m_data, other.m_length, m_data);
+            m_length = other.m_length;
+            other.Clear();
+        }
+        else {
+            m_data = std::exchange(other.m_data, other.InlineData());
+            m_length = std::exchange(other.m_length, 0);
+            m_capacity = std::exchange(other.m_capacity, INLINE_CAPACITY);
+        }
+    }
+};
+
+// =================================================================================================
@@ -0,0 +1,270 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <new>
+#include <span>
+#include <tuple>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+// =================================================================================================
+// Structure of arrays: a table of rows whose fields are stored column by column, each column being a
+// contiguous, 32 byte aligned array of one field type. Loops over a single field (e.g. all velocities)
+// thus walk dense memory and can be vectorized; Column<I>() hands out a column as a span for them.
+// All columns live in one heap block which grows by doubling.
+// Rows are addressed by index. Remove() moves the last row into the gap (swap and pop), so removing
+// changes the index of the last row, and row order is not preserved.
+// operator[] returns a tuple of references to a row's fields; View<VIEW_T>() builds a client defined
+// aggregate of references instead, so scalar code can keep using field names (soa.View<Ref>(i).position).
+// Fields are meant to be plain simulation data and must not throw when copied or moved.
+
+template <typename... FIELDS_T>
+class SoAArray {
+    static_assert(sizeof...(FIELDS_T) > 0, "SoAArray needs at least one field");
+    static_assert((std::is_nothrow_copy_constructible_v<FIELDS_T> and ...), "SoAArray fields must be nothrow copy constructible");
+    static_assert(((std::is_nothrow_move_constructible_v<FIELDS_T> and std::is_nothrow_move_assignable_v<FIELDS_T>) and ...), "SoAArray fields must be nothrow movable");
+
+public:
+    static constexpr size_t columnAlignment = 32;
+    static constexpr size_t columnCount = sizeof...(FIELDS_T);
+
+    static_assert(((alignof(FIELDS_T) <= columnAlignment) and ...), "SoAArray field alignment exceeds column alignment");
+
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<FIELDS_T...>>;
+
+    using Row = std::tuple<FIELDS_T&...>;
+    using ConstRow = std::tuple<const FIELDS_T&...>;
+
+private:
+    using Columns = std::tuple<FIELDS_T*...>;
+    using ColumnIndices = std::index_sequence_for<FIELDS_T...>;
+
+    Columns     m_columns{};
+    void*       m_buffer{ nullptr };
+    int32_t     m_length{ 0 };
+    int32_t     m_capacity{ 0 };
+
+public:
+    SoAArray() noexcept = default;
+
+    explicit SoAArray(int32_t capacity) {
+        Reserve(capacity);
+    }
+
+    SoAArray(const SoAArray& other) {
+        Copy(other);
+    }
+
+    SoAArray(SoAArray&& other) noexcept {
+        Move(other);
+    }
+
+    ~SoAArray() {
+        Reset();
+    }
+
+    SoAArray& operator=(const SoAArray& other) {
+        if (this != &other) {
+            Clear();
+            Copy(other);
+        }
+        return *this;
+    }
+
+    SoAArray& operator=(SoAArray&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            Move(other);
+        }
+        return *this;
+    }
+
+    // Appends a row with the given field values and returns its index. The values may refer to
+    // fields of this array.
+    int32_t Append(const FIELDS_T&... values) {
+        if (m_length == m_capacity) {
+            // construct the new row in the new block before the old one is released, in case values
+            // refer to it
+            int32_t capacity = Grown();
+            Columns columns;
+            void* buffer = Allocate(capacity, columns);
+            ConstructRow(columns, m_length, ColumnIndices{}, values...);
+            Relocate(buffer, columns, capacity);
+        }
+        else
+            ConstructRow(m_columns, m_length, ColumnIndices{}, values...);
+        return m_length++;
+    }
+
+    // appends a value initialized row and returns its index
+    int32_t Append(void) {
+        if (m_length == m_capacity)
+            Reserve(Grown());
+        std::apply([this](FIELDS_T*... columns) { (std::construct_at(columns + m_length), ...); }, m_columns);
+        return m_length++;
+    }
+
+    // Removes row i by moving the last row into its place.
+    void Remove(int32_t i) noexcept {
+        int32_t last = m_length - 1;
+        if (i != last)
+            std::apply([i, last](FIELDS_T*... columns) { ((columns[i] = std::move(columns[last])), ...); }, m_columns);
+        Truncate(last);
+    }
+
+    void Reserve(int32_t capacity) {
+        if (capacity <= m_capacity)
+            return;
+        Columns columns;
+        void* buffer = Allocate(capacity, columns);
+        Relocate(buffer, columns, capacity);
+    }
+
+    // Sets the number of rows. New rows are value initialized.
+    void Resize(int32_t length) {
+        if (length < m_length)
+            Truncate(length);
+        else if (length > m_length) {
+            Reserve(std::max(length, m_capacity * 2));
+            std::apply([this, length](FIELDS_T*... columns) {
+                (std::uninitialized_value_construct(columns + m_length, columns + length), ...);
+            }, m_columns);
+            m_length = length;
+        }
+    }
+
+    // destroys all rows, but keeps the memory
+    inline void Clear(void) noexcept {
+        Truncate(0);
+    }
+
+    // destroys all rows and releases the memory
+    void Reset(void) noexcept {
+        Clear();
+        Deallocate(m_buffer);
+        m_buffer = nullptr;
+        m_columns = Columns{};
+        m_capacity = 0;
+    }
+
+    inline int32_t Length(void) const noexcept { return m_length; }
+
+    inline int32_t Capacity(void) const noexcept { return m_capacity; }
+
+    inline bool IsEmpty(void) const noexcept { return m_length == 0; }
+
+    inline bool IsValidIndex(int32_t i) const noexcept { return (i >= 0) and (i < m_length); }
+
+    // the I-th field of all rows
+    template <size_t I>
+    inline std::span<FieldType<I>> Column(void) noexcept {
+        return std::span<FieldType<I>>(std::get<I>(m_columns), size_t(m_length));
+    }
+
+    template <size_t I>
+    inline std::span<const FieldType<I>> Column(void) const noexcept {
+        return std::span<const FieldType<I>>(std::get<I>(m_columns), size_t(m_length));
+    }
+
+    template <size_t I>
+    inline FieldType<I>& Get(int32_t i) noexcept { return std::get<I>(m_columns)[i]; }
+
+    template <size_t I>
+    inline const FieldType<I>& Get(int32_t i) const noexcept { return std::get<I>(m_columns)[i]; }
+
+    inline Row operator[](int32_t i) noexcept {
+        return std::apply([i](FIELDS_T*... columns) { return Row(columns[i]...); }, m_columns);
+    }
+
+    inline ConstRow operator[](int32_t i) const noexcept {
+        return std::apply([i](FIELDS_T*... columns) { return ConstRow(columns[i]...); }, m_columns);
+    }
+
+    // VIEW_T is an aggregate of references (or values), one per field in column order.
+    template <typename VIEW_T>
+    inline VIEW_T View(int32_t i) noexcept {
+        return std::apply([i](FIELDS_T*... columns) { return VIEW_T{ columns[i]... }; }, m_columns);
+    }
+
+    template <typename VIEW_T>
+    inline VIEW_T View(int32_t i) const noexcept {
+        return std::apply([i](FIELDS_T*... columns) { return VIEW_T{ std::as_const(columns[i])... }; }, m_columns);
+    }
+
+private:
+    inline int32_t Grown(void) const noexcept {
+        return m_capacity ? m_capacity * 2 : 16;
+    }
+
+    static constexpr size_t ColumnSize(size_t fieldSize, int32_t capacity) noexcept {
+        return (fieldSize * size_t(capacity) + columnAlignment - 1) & ~(columnAlignment - 1);
+    }
+
+    // allocates a block for capacity rows and sets columns to the column starts within it
+    static void* Allocate(int32_t capacity, Columns& columns) {
+        size_t size = (ColumnSize(sizeof(FIELDS_T), capacity) + ...);
+        std::byte* buffer = static_cast<std::byte*>(::operator new(size, std::align_val_t(columnAlignment)));
+        std::byte* p = buffer;
+        std::apply([&p, capacity](auto&... column) {
+            ((column = reinterpret_cast<std::remove_reference_t<decltype(column)>>(p), p += ColumnSize(sizeof(*column), capacity)), ...);
+        }, columns);
+        return buffer;
+    }
+
+    static inline void Deallocate(void* buffer) noexcept {
+        if (buffer)
+            ::operator delete(buffer, std::align_val_t(columnAlignment));
+    }
+
+    template <size_t... Is>
+    static inline void ConstructRow(Columns& columns, int32_t i, std::index_sequence<Is...>, const FIELDS_T&... values) noexcept {
+        (std::construct_at(std::get<Is>(columns) + i, values), ...);
+    }
+
+    // moves the rows to the given block and releases the current one
+    void Relocate(void* buffer, Columns& columns, int32_t capacity) noexcept {
+        RelocateColumns(columns, ColumnIndices{});
+        Deallocate(m_buffer);
+        m_buffer = buffer;
+        m_columns = columns;
+        m_capacity = capacity;
+    }
+
+    template <size_t... Is>
+    void RelocateColumns(Columns& columns, std::index_sequence<Is...>) noexcept {
+        ((std::uninitialized_move_n(std::get<Is>(m_columns), m_length, std::get<Is>(columns)), std::destroy_n(std::get<Is>(m_columns), m_length)), ...);
+    }
+
+    inline void Truncate(int32_t length) noexcept {
+        std::apply([this, length](FIELDS_T*... columns) { (std::destroy(columns + length, columns + m_length), ...); }, m_columns);
+        m_length = length;
+    }
+
+    void Copy(const SoAArray& other) {
+        Reserve(other.m_length);
+        CopyColumns(other, ColumnIndices{});
+        m_length = other.m_length;
+    }
+
+    template <size_t... Is>
+    void CopyColumns(const SoAArray& other, std::index_sequence<Is...>) noexcept {
+        (std::uninitialized_copy_n(std::get<Is>(other.m_columns), other.m_length, std::get<Is>(m_columns)), ...);
+    }
+
+    void Move(SoAArray& other) noexcept {
+        m_columns = std::exchange(other.m_columns, Columns{});
+        m_buffer = std::exchange(other.m_buffer, nullptr);
+        m_length = std::exchange(other.m_length, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+    }
+};
+
+// =================================================================================================
@@ -0,0 +1,237 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <bit>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+class ParallelSorter;
+
+// =================================================================================================
+// Sorting algorithms for contiguous data.
+// Introsort() is a quicksort with median of three pivots which switches to insertion sort for short
+// ranges and to heapsort when the partitioning gets too deep, so it is O(n log n) even for sorted,
+// reversed or adversarial input. It only recurses into the smaller partition, bounding the stack
+// depth to log2(n). The comparator is a template parameter (a callable returning a < b), so it is
+// inlined instead of being called through a function pointer.
+// RadixSort() is a stable LSD radix sort with 8 bit digits for integral and floating point values,
+// or for items with an unsigned integer sort key (e.g. 64 bit render keys). It is O(n) but needs a
+// temporary copy of the data, so it is only used for arrays of at least radixSortThreshold items.
+
+class Sorter {
+public:
+    static constexpr int32_t insertionSortThreshold = 16;
+    static constexpr int32_t radixSortThreshold = 256;
+
+    template <typename DATA_T>
+    static constexpr bool isRadixSortable = std::is_arithmetic_v<DATA_T> and not std::is_same_v<DATA_T, bool> and (sizeof(DATA_T) <= sizeof(uint64_t));
+
+    template <typename DATA_T, typename LESS_T = std::less<DATA_T>>
+    static void Introsort(DATA_T* data, int32_t count, LESS_T less = LESS_T()) {
+        if (count > 1)
+            IntrosortLoop(data, data + count, DepthLimit(count), less);
+    }
+
+    // ascending order of the values
+    template <typename DATA_T>
+    static void RadixSort(DATA_T* data, int32_t count) {
+        static_assert(isRadixSortable<DATA_T>, "RadixSort requires integral or floating point values");
+        RadixSort(data, count, [](const DATA_T& value) { return RadixKey(value); });
+    }
+
+    // ascending order of key(item), which must return an unsigned integer. Items must be default
+    // constructible and movable.
+    template <typename DATA_T, typename KEY_FUNC_T>
+    static void RadixSort(DATA_T* data, int32_t count, KEY_FUNC_T key);
+
+    // Sort with the best algorithm for the data type and amount: radix sort for long arrays of numbers,
+    // introsort otherwise.
+    template <typename DATA_T>
+    static void SortAscending(DATA_T* data, int32_t count) {
+        if constexpr (isRadixSortable<DATA_T>) {
+            if (count >= radixSortThreshold) {
+                RadixSort(data, count);
+                return;
+            }
+        }
+        Introsort(data, count, std::less<DATA_T>());
+    }
+
+    template <typename DATA_T>
+    static void SortDescending(DATA_T* data, int32_t count) {
+        if constexpr (isRadixSortable<DATA_T>) {
+            if (count >= radixSortThreshold) {
+                RadixSort(data, count);
+                std::reverse(data, data + count);
+                return;
+            }
+        }
+        Introsort(data, count, std::greater<DATA_T>());
+    }
+
+    // order preserving mapping of a number to an unsigned integer of the same size
+    template <typename DATA_T>
+    static inline auto RadixKey(DATA_T value) noexcept {
+        using KEY_T = std::conditional_t<sizeof(DATA_T) == 1, uint8_t,
+                      std::conditional_t<sizeof(DATA_T) == 2, uint16_t,
+                      std::conditional_t<sizeof(DATA_T) == 4, uint32_t, uint64_t>>>;
+        constexpr KEY_T signBit = KEY_T(KEY_T(1) << (sizeof(KEY_T) * 8 - 1));
+        KEY_T key;
+        memcpy(&key, &value, sizeof(KEY_T));
+        if constexpr (std::is_floating_point_v<DATA_T>) // negative: larger magnitudes must come first
+            return KEY_T((key & signBit) ? ~key : (key | signBit));
+        else if constexpr (std::is_signed_v<DATA_T>)
+            return KEY_T(key ^ signBit);
+        else
+            return key;
+    }
+
+private:
+    static inline int32_t DepthLimit(int32_t count) noexcept {
+        return 2 * (int32_t(std::bit_width(uint32_t(count))) - 1);
+    }
+
+    template <typename DATA_T, typename LESS_T>
+    static void InsertionSort(DATA_T* first, DATA_T* last, LESS_T less) {
+        if (first == last)
+            return;
+        for (DATA_T* i = first + 1; i < last; ++i) {
+            DATA_T value = std::move(*i);
+            DATA_T* j = i;
+            if (less(value, *first)) {
+                std::move_backward(first, i, i + 1);
+                j = first;
+            }
+            else {
+                for (; less(value, *(j - 1)); --j) // *first is a sentinel
+                    *j = std::move(*(j - 1));
+            }
+            *j = std::move(value);
+        }
+    }
+
+    template <typename DATA_T, typename LESS_T>
+    static void HeapSort(DATA_T* first, DATA_T* last, LESS_T less) {
+        std::make_heap(first, last, less);
+        std::sort_heap(first, last, less);
+    }
+
+    // Move the median of *a, *b, *c to *result
+    template <typename DATA_T, typename LESS_T>
+    static inline void MoveMedianToFirst(DATA_T* result, DATA_T* a, DATA_T* b, DATA_T* c, LESS_T& less) {
+        using std::swap;
+        if (less(*a, *b)) {
+            if (less(*b, *c))
+                swap(*result, *b);
+            else if (less(*a, *c))
+                swap(*result, *c);
+            else
+                swap(*result, *a);
+        }
+        else if (less(*a, *c))
+            swap(*result, *a);
+        else if (less(*b, *c))
+            swap(*result, *c);
+        else
+            swap(*result, *b);
+    }
+
+    // Hoare partition of [first, last) around the median of three, which is moved to *first. The
+    // median of three guarantees that both scans stop inside the range. Returns the start of the
+    // right partition.
+    template <typename DATA_T, typename LESS_T>
+    static DATA_T* Partition(DATA_T* first, DATA_T* last, LESS_T& less) {
+        using std::swap;
+        MoveMedianToFirst(first, first + 1, first + (last - first) / 2, last - 1, less);
+        DATA_T* l = first + 1;
+        DATA_T* r = last;
+        for (;;) {
+            while (less(*l, *first))
+                ++l;
+            --r;
+            while (less(*first, *r))
+                --r;
+            if (not (l < r))
+                return l;
+            swap(*l, *r);
+            ++l;
+        }
+    }
+
+    template <typename DATA_T, typename LESS_T>
+    static void IntrosortLoop(DATA_T* first, DATA_T* last, int32_t depth, LESS_T less) {
+        while (last - first > insertionSortThreshold) {
+            if (depth-- == 0) {
+                HeapSort(first, last, less);
+                return;
+            }
+            DATA_T* cut = Partition(first, last, less);
+            if (cut - first < last - cut) {
+                IntrosortLoop(first, cut, depth, less);
+                first = cut;
+            }
+            else {
+                IntrosortLoop(cut, last, depth, less);
+                last = cut;
+            }
+        }
+        InsertionSort(first, last, less);
+    }
+
+    friend class ParallelSorter;
+};
+
+// =================================================================================================
+
+template <typename DATA_T, typename KEY_FUNC_T>
+void Sorter::RadixSort(DATA_T* data, int32_t count, KEY_FUNC_T key) {
+    using KEY_T = std::decay_t<std::invoke_result_t<KEY_FUNC_T&, const DATA_T&>>;
+    static_assert(std::is_integral_v<KEY_T> and std::is_unsigned_v<KEY_T>, "RadixSort keys must be unsigned integers");
+    constexpr int32_t digitCount = int32_t(sizeof(KEY_T));
+
+    if (count < 2)
+        return;
+
+    // histograms of all digits in one pass
+    std::vector<uint32_t> histograms(size_t(digitCount) * 256, 0);
+    for (int32_t i = 0; i < count; ++i) {
+        KEY_T k = key(data[i]);
+        for (int32_t d = 0; d < digitCount; ++d)
+            ++histograms[size_t(d) * 256 + size_t((k >> (d * 8)) & 0xFF)];
+    }
+
+    std::vector<DATA_T> buffer;
+    DATA_T* source = data;
+    DATA_T* dest = nullptr;
+    for (int32_t d = 0; d < digitCount; ++d) {
+        uint32_t* histogram = histograms.data() + size_t(d) * 256;
+        int32_t shift = d * 8;
+        if (histogram[(key(source[0]) >> shift) & 0xFF] == uint32_t(count)) // all items have the same digit
+            continue;
+        if (buffer.empty()) {
+            buffer.resize(size_t(count));
+            dest = buffer.data();
+        }
+        uint32_t offset = 0;
+        for (int32_t i = 0; i < 256; ++i) {
+            uint32_t n = histogram[i];
+            histogram[i] = offset;
+            offset += n;
+        }
+        for (int32_t i = 0; i < count; ++i)
+            dest[histogram[(key(source[i]) >> shift) & 0xFF]++] = std::move(source[i]);
+        std::swap(source, dest);
+    }
+    if (source != data)
+        std::move(source, source + count, data);
+}
+
+// =================================================================================================
@@ -101,18 +101,6 @@ public:
     inline uint32_t Growth(void) const noexcept { return 0; }
 
     inline void SetGrowth(uint32_t) noexcept { }
-
-    inline void SortAscending(int32_t left = 0, int32_t right = -1) {
-        int32_t n = Base::Length();
-        if (n > 0)
-            std::sort(Base::DataPtr(left), Base::DataPtr((right >= 0) ? right + 1 : n));
-    }
-
-    inline void SortDescending(int32_t left = 0, int32_t right = -1) {
-        int32_t n = Base::Length();
-        if (n > 0)
-            std::sort(Base::Data(left), Base::Data((right >= 0) ? right + 1 : n), std::greater<DATA_T>());
-    }
 };
 
 // =================================================================================================
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -10,6 +11,7 @@
 #include <type_traits>
 #include <fstream>
 #include <filesystem>
+#include "sort.hpp"
 
 // =================================================================================================
 
@@ -324,6 +326,14 @@ public:
         return m_arrayPtr->data();
     }
 
+    inline std::span<DATA_T> Span(void) noexcept {
+        return std::span<DATA_T>(m_arrayPtr->data(), m_arrayPtr->size());
+    }
+
+    inline std::span<const DATA_T> Span(void) const noexcept {
+        return std::span<const DATA_T>(m_arrayPtr->data(), m_arrayPtr->size());
+    }
+
 #if 0
     // Zeiger auf Rohdaten (z.B. fuer OpenGL)
     inline DATA_T* DataPtr(int32_t i = 0) noexcept { 
@@ -418,6 +428,24 @@ public:
 
     inline operator const std::vector<DATA_T>& () const noexcept { return (*m_arrayPtr); }
 
+    // Sort [left, right] (right < 0: up to the end). Long arrays of numbers are radix sorted.
+    inline void SortAscending(int32_t left = 0, int32_t right = -1) {
+        if (Length() > 0)
+            Sorter::SortAscending(DataPtr(left), ((right >= 0) ? right + 1 : Length()) - left);
+    }
+
+    inline void SortDescending(int32_t left = 0, int32_t right = -1) {
+        if (Length() > 0)
+            Sorter::SortDescending(DataPtr(left), ((right >= 0) ? right + 1 : Length()) - left);
+    }
+
+    // less(a, b) returns a < b; it is inlined by the sorter
+    template <typename LESS_T>
+    inline void Sort(LESS_T less, int32_t left = 0, int32_t right = -1) {
+        if (Length() > 0)
+            Sorter::Introsort(DataPtr(left), ((right >= 0) ? right + 1 : Length()) - left, less);
+    }
+
     template <typename Predicate>
     auto Find(Predicate compare) {
         return std::find_if(m_arrayPtr->begin(), m_arrayPtr->end(), compare);
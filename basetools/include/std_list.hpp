@@ -5,10 +5,12 @@
 #pragma once
 
 #include <list>
+#include <vector>
 #include <functional>
 #include <algorithm>
 #include <utility>
 #include <cstddef>
+#include <cstdlib>
 #include <cstring>
 #include <stdexcept>
 
@@ -19,38 +21,89 @@ class List
     using ItemFilter = std::function<bool(ItemType*)>;
 
 private:
-    std::list<ItemType> m_list;
+    using ListIterator = typename std::list<ItemType>::iterator;
+
+    static constexpr int32_t skipStep = 64;                 // distance of skip index entries
+    static constexpr int32_t skipIndexThreshold = 1024;     // shortest list getting a skip index
+
+    std::list<ItemType>         m_list;
+    // Random access acceleration: the last accessed position (cursor) and, for long lists, a skip index
+    // holding every skipStep-th position. Both are dropped by mutations which shift indices or remove
+    // nodes; appending keeps them. m_indexedLength is the list length they were valid for, which also
+    // catches most structural changes made through StdList().
+    ListIterator                m_cursor;
+    int32_t                     m_cursorIndex{ -1 };
+    std::vector<ListIterator>   m_skipIndex;
+    size_t                      m_indexedLength{ 0 };
 
     // ----------------------------------------------------------
     // Zentrale Iterator-Funktion: ElementAt
     // i == 0: return start
     // i == -1: return end
     // i < 0: return -i-th element counted from the end
+    // Walks from the closest of head, tail, cursor and skip index entry, so sequential or
+    // nearby accesses are O(1) and random accesses O(skipStep) on long lists.
     // ----------------------------------------------------------
-    typename std::list<ItemType>::iterator ElementAt(int32_t i)
+    ListIterator ElementAt(int32_t i)
     {
         int32_t l = static_cast<int32_t>(m_list.size());
-        if (i == 0)
-            return m_list.begin();
-        if (i < 0) {
-            if (i == -1)
-                return l ? std::prev(m_list.end()) : m_list.end();
-            i = l + i;
-        }
-        if (i >= l)
+        if (i < 0)
+            i += l;
+        if ((i < 0) or (i >= l))
             return m_list.end();
-        typename std::list<ItemType>::iterator it;
-        if (i <= l / 2) { // optimize iteration by starting at list end if i closer to that
-            it = m_list.begin();
-            std::advance(it, i);
-        }
-        else {
+        if (m_indexedLength != m_list.size())
+            InvalidateIndex();
+        ListIterator it = m_list.begin();
+        int32_t from = 0;
+        if (l - i < i) {
             it = m_list.end();
-            std::advance(it, -static_cast<long>(l - i));
+            from = l;
+        }
+        if ((m_cursorIndex >= 0) and (std::abs(i - m_cursorIndex) < std::abs(i - from))) {
+            it = m_cursor;
+            from = m_cursorIndex;
         }
+        if ((std::abs(i - from) > skipStep) and (l >= skipIndexThreshold)) {
+            if (m_skipIndex.empty())
+                BuildSkipIndex();
+            int32_t k = std::min((i + skipStep / 2) / skipStep, static_cast<int32_t>(m_skipIndex.size()) - 1);
+            if (std::abs(i - k * skipStep) < std::abs(i - from)) {
+                it = m_skipIndex[k];
+                from = k * skipStep;
+            }
+        }
+        std::advance(it, i - from);
+        m_cursor = it;
+        m_cursorIndex = i;
         return it;
     }
 
+
+    void BuildSkipIndex(void) {
+        m_skipIndex.reserve(m_list.size() / skipStep + 1);
+        int32_t i = 0;
+        for (auto it = m_list.begin(); it != m_list.end(); ++it, ++i) {
+            if (i % skipStep == 0)
+                m_skipIndex.push_back(it);
+        }
+    }
+
+    // items appended at the end don't shift any index
+    inline void IndexAppended(void) noexcept {
+        if (m_indexedLength + 1 == m_list.size())
+            ++m_indexedLength;
+        else
+            InvalidateIndex();
+    }
+
+public:
+    // Drop cursor and skip index. Must be called after changing the list structure through StdList().
+    inline void InvalidateIndex(void) noexcept {
+        m_cursorIndex = -1;
+        m_skipIndex.clear();
+        m_indexedLength = m_list.size();
+    }
+
 public:
     List() = default;
     ~List() = default;
@@ -58,19 +111,25 @@ public:
     List(std::initializer_list<ItemType> itemList) {
         for (const auto& elem : itemList)
             m_list.push_back(elem);
+        InvalidateIndex();
     }
 
     inline std::list<ItemType>& StdList(void) noexcept {
+        InvalidateIndex();
         return m_list;
     }
 
-    inline operator std::list<ItemType>& () { return m_list; }
+    inline operator std::list<ItemType>& () {
+        InvalidateIndex();
+        return m_list;
+    }
 
     inline operator const std::list<ItemType>& () const { return m_list; }
 
     List& operator=(std::initializer_list<ItemType> itemList) {
         m_list.clear();
         m_list.insert(m_list.end(), itemList.begin(), itemList.end());
+        InvalidateIndex();
         return *this;
     }
 
@@ -96,6 +155,7 @@ public:
         catch (...) {
             return nullptr;
         }
+        IndexAppended();
         return &m_list.back();
     }
 
@@ -106,6 +166,7 @@ public:
         catch (...) {
             return nullptr;
         }
+        IndexAppended();
         return &m_list.back();
     }
 
@@ -121,6 +182,7 @@ public:
         catch (...) {
             return nullptr;
         }
+        IndexAppended();
         return &m_list.back();
     }
 
@@ -133,10 +195,12 @@ public:
         if (i >= m_list.size())
         {
             m_list.push_back(std::forward<T>(dataItem));
+            IndexAppended();
             return &m_list.back();
         }
         auto it = ElementAt(i);
         it = m_list.insert(it, std::forward<T>(dataItem));
+        InvalidateIndex();
         return &(*it);
     }
 
@@ -149,6 +213,7 @@ public:
             return ItemType();
         ItemType value = *it;
         m_list.erase(it);
+        InvalidateIndex();
         return value;
     }
 
@@ -160,6 +225,7 @@ public:
             return false;
         value = *it;
         m_list.erase(it);
+        InvalidateIndex();
         return true;
     }
 
@@ -171,31 +237,47 @@ public:
         if (it == m_list.end())
             return false;
         m_list.erase(it);
+        InvalidateIndex();
         return true;
     }
 
 
     inline auto Erase(int32_t i) {
         auto it = ElementAt(i);
-        return (it == m_list.end()) ? it : m_list.Erase(it);
+        if (it == m_list.end())
+            return it;
+        it = m_list.erase(it);
+        InvalidateIndex();
+        return it;
     }
 
 
     template<typename Iterator>
-    Iterator Discard(Iterator it) { return m_list.erase(it); }
+    Iterator Discard(Iterator it) {
+        it = m_list.erase(it);
+        InvalidateIndex();
+        return it;
+    }
 
-    inline void DiscardFirst(void) { m_list.pop_front(); }
+    inline void DiscardFirst(void) {
+        m_list.pop_front();
+        InvalidateIndex();
+    }
 
-    inline void DiscardLast(void) { m_list.pop_back(); }
+    inline void DiscardLast(void) {
+        m_list.pop_back();
+        InvalidateIndex();
+    }
 
     // ----------------------------------------------------------
 
     bool Remove(const ItemType& data)
     {
         auto it = std::find(m_list.begin(), m_list.end(), data);
-        if (it != m_list.end())
+        if (it == m_list.end())
             return false;
         m_list.erase(it);
+        InvalidateIndex();
         return true;
     }
 
@@ -205,10 +287,14 @@ public:
     int Find(T&& data) {
         ItemType pattern = std::forward<T>(data);
         int i = 0;
-        for (const auto& value : m_list) {
-            if (value == pattern)
+        for (auto it = m_list.begin(); it != m_list.end(); ++it, ++i) {
+            if (*it == pattern) { // a following access by index starts here
+                if (m_indexedLength != m_list.size())
+                    InvalidateIndex();
+                m_cursor = it;
+                m_cursorIndex = i;
                 return int(i);
-            ++i;
+            }
         }
         return -1;
     }
@@ -225,18 +311,23 @@ public:
         else
             // item ist ItemType (z.B. Decal&), Ihr Lambda erwartet Decal&
             m_list.remove_if([&filter](ItemType& item) { return filter(item); });
+        InvalidateIndex();
         return static_cast<int32_t>(oldSize - m_list.size());
     }
 
     List& Move(List& other) noexcept {
         if (other.Length())
             m_list.splice(m_list.end(), other.m_list);
+        InvalidateIndex();
+        other.InvalidateIndex();
         return *this;
     }
     
     List& Move(List&& other) noexcept {
         if (other.Length())
             m_list.splice(m_list.end(), other.m_list); // 'other' ist L-Wert hier, splice erwartet lvalue-ref -> ok
+        InvalidateIndex();
+        other.InvalidateIndex();
         return *this;
     }
 
@@ -244,6 +335,7 @@ public:
     List& Copy(const List& other) {
         if (other.Length())
             m_list.insert(m_list.end(), other.m_list.begin(), other.m_list.end());
+        InvalidateIndex();
         return *this;
     }
 
@@ -281,13 +373,37 @@ public:
         return Copy(other);
     }
 
+    // ----------------------------------------------------------
+    // Stable merge sort; nodes are relinked, items are neither copied nor moved. less(a, b) returns a < b.
+
+    template <typename LESS_T = std::less<ItemType>>
+    inline void Sort(LESS_T less = LESS_T()) {
+        m_list.sort(less);
+        InvalidateIndex();
+    }
+
+    // Merge other, which must be sorted by the same comparator, into this sorted list. Of equal items,
+    // those of this list come first. other is left empty.
+    template <typename LESS_T = std::less<ItemType>>
+    inline List& Merge(List&& other, LESS_T less = LESS_T()) {
+        if (this != &other) {
+            m_list.merge(other.m_list, less);
+            InvalidateIndex();
+            other.InvalidateIndex();
+        }
+        return *this;
+    }
+
     // ----------------------------------------------------------
 
     inline int32_t Length(void) const { return static_cast<int32_t>(m_list.size()); }
 
     inline bool IsEmpty(void) const { return m_list.empty(); }
 
-    inline void Clear(void) { m_list.clear(); }
+    inline void Clear(void) {
+        m_list.clear();
+        InvalidateIndex();
+    }
 
     inline void Reset(void) { Clear(); }
 
@@ -309,16 +425,23 @@ public:
 
     inline const std::list<ItemType>& GetList() const { return m_list; }
 
-    inline std::list<ItemType>& GetList() { return m_list; }
+    inline std::list<ItemType>& GetList() {
+        InvalidateIndex();
+        return m_list;
+    }
 
     template <typename T>
-    void Push(T&& value) { m_list.push_back(std::forward<T>(value)); }
+    void Push(T&& value) {
+        m_list.push_back(std::forward<T>(value));
+        IndexAppended();
+    }
 
     ItemType Pop(void) {
         if (Length() == 0)
             return ItemType();
         ItemType value = m_list.back();
         m_list.pop_back();
+        InvalidateIndex();
         return value;
     }
 
@@ -327,6 +450,7 @@ public:
             return false;
         value = std::move(m_list.back());
         m_list.pop_back();
+        InvalidateIndex();
         return true;
     }
 };
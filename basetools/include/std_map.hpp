@@ -129,6 +129,15 @@ public:
         m_map.clear();
     }
 
+    void Clear() noexcept {
+        m_map.clear();
+    }
+
+    // std::map allocates per node; kept for interface parity with AVLTree
+    inline bool Reserve(int /*nodeCount*/) noexcept {
+        return true;
+    }
+
     template<typename Func>
     bool Walk(Func processNode) {
         for (auto& [key, data] : m_map) {
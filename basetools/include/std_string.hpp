@@ -12,6 +12,7 @@
 #include <iostream>
 #include <type_traits>
 #include "array.hpp"
+#include "stringutils.hpp"
 #include <fmt/format.h>
 
 // =================================================================================================
@@ -132,6 +133,8 @@ public:
 
     inline const char* Data(void) const noexcept { return m_str.data(); }
 
+    inline std::string_view View(void) const noexcept { return std::string_view(m_str); }
+
     // Methoden
     inline String SubStr(int offset, int length) const {
         if (offset < 0 or offset > Length()) return String("");
@@ -162,6 +165,12 @@ public:
         return Split(m_str, delim);
     }
 
+    // Same fields as Split(), but as views into this string instead of copies. The string must not be
+    // modified while the fields are in use.
+    inline StringUtils::SplitView SplitView(char delim) const noexcept {
+        return StringUtils::SplitView(View(), delim);
+    }
+
     inline auto begin() noexcept {
         return m_str.begin();
     }
@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Dietfrid Mali
+// This software is licensed under the MIT License.
+// See the LICENSE file for more details.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#include "string.hpp"
+#include "flatmap.hpp"
+
+// =================================================================================================
+// Interned string. Every distinct character sequence is stored exactly once in a process wide intern
+// table together with its 64 bit hash; a StringId is just a pointer to that entry. Comparing,
+// copying and hashing StringIds therefore costs a pointer compare, copy or load, and they make cheap
+// keys for identifiers which are looked up often (shader names, resource names ...).
+// Constructing a StringId from text hashes the text and looks it up in the table, which is sharded
+// by hash and guarded by a reader/writer lock per shard, so StringIds can be created from any thread.
+// Repeated constructions from literals on hot paths should be hoisted into static StringIds.
+// Interned text is never freed, so only intern a bounded set of strings.
+// operator< orders by hash, not alphabetically; the order is stable for the lifetime of the process.
+
+class StringId {
+public:
+    struct Entry {
+        uint64_t    hash;
+        uint32_t    length;
+        char        text[1];    // zero terminated, allocated with length + 1 bytes
+    };
+
+private:
+    const Entry*    m_entry;
+
+public:
+    StringId() noexcept
+        : m_entry(EmptyEntry())
+    { }
+
+    StringId(const char* s)
+        : m_entry(Intern(s, s ? strlen(s) : 0))
+    { }
+
+    StringId(const char* s, size_t length)
+        : m_entry(Intern(s, length))
+    { }
+
+    StringId(std::string_view s)
+        : m_entry(Intern(s.data(), s.length()))
+    { }
+
+    StringId(const String& s)
+        : m_entry(Intern(s.Data(), size_t(s.Length())))
+    { }
+
+    inline const char* CStr(void) const noexcept { return m_entry->text; }
+
+    inline const char* Data(void) const noexcept { return m_entry->text; }
+
+    inline int Length(void) const noexcept { return int(m_entry->length); }
+
+    inline bool IsEmpty(void) const noexcept { return m_entry->length == 0; }
+
+    inline uint64_t Hash(void) const noexcept { return m_entry->hash; }
+
+    inline uint32_t Hash32(void) const noexcept { return uint32_t(m_entry->hash ^ (m_entry->hash >> 32)); }
+
+    inline std::string_view View(void) const noexcept { return std::string_view(m_entry->text, m_entry->length); }
+
+    inline String ToString(void) const { return String(m_entry->text); }
+
+    inline bool operator==(const StringId& other) const noexcept { return m_entry == other.m_entry; }
+
+    inline bool operator!=(const StringId& other) const noexcept { return m_entry != other.m_entry; }
+
+    inline bool operator<(const StringId& other) const noexcept {
+        return (m_entry->hash != other.m_entry->hash) ? (m_entry->hash < other.m_entry->hash) : (m_entry < other.m_entry);
+    }
+
+    inline bool operator>(const StringId& other) const noexcept { return other < *this; }
+
+    // comparator for AVLTree keys
+    static int Compare(void*, const StringId& s1, const StringId& s2) noexcept {
+        return (s1 < s2) ? -1 : (s2 < s1) ? 1 : 0;
+    }
+
+    // number of distinct strings interned so far (including the empty string)
+    static int32_t InternedCount(void) noexcept;
+
+    // hash function used by the intern table
+    static inline uint64_t HashText(const char* s, size_t length) noexcept {
+        return HashBytes(s, length);
+    }
+
+private:
+    static const Entry* Intern(const char* s, size_t length);
+
+    static const Entry* EmptyEntry(void) noexcept;
+};
+
+// =================================================================================================
+// StringIds carry their hash, so hash maps keyed by StringId never touch the text.
+
+template <>
+struct FlatMapHash<StringId> {
+    inline uint64_t operator()(const StringId& key) const noexcept {
+        return key.Hash();
+    }
+};
+
+template <typename DATA_T>
+using StringIdDictionary = FlatMap<StringId, DATA_T>;
+
+// =================================================================================================
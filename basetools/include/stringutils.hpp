@@ -5,38 +5,75 @@
 #include <list>
 #include <string_view>
 #include <charconv>
+#include <iterator>
 #include <cctype>
 #include <algorithm>
 #include <stdexcept>
 #include <sstream>
 #include <ranges>
 #include <limits>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "smallarray.hpp"
 
 namespace StringUtils {
 
+    // ---------- Trim ----------
+
+    inline std::string_view Trim(std::string_view s) noexcept {
+        size_t first = 0;
+        size_t last = s.size();
+        while ((first < last) and std::isspace(static_cast<unsigned char>(s[first])))
+            ++first;
+        while ((last > first) and std::isspace(static_cast<unsigned char>(s[last - 1])))
+            --last;
+        return s.substr(first, last - first);
+    }
+
+    // ---------- Zahlen parsen (ohne Allokation, ohne Exceptions, locale-unabhngig) ----------
+
+    // Parses all of s as a decimal number using std::from_chars. Surrounding white space and a leading
+    // '+' are accepted; an empty field, trailing characters or a value out of the range of T fail.
+    // value is only written on success.
+    template <typename T>
+    inline bool ParseNumber(std::string_view s, T& value) noexcept {
+        static_assert(std::is_arithmetic_v<T> and not std::is_same_v<T, bool>, "ParseNumber requires a numeric type");
+        s = Trim(s);
+        if ((s.size() > 1) and (s[0] == '+') and (s[1] != '-'))
+            s.remove_prefix(1);
+        if (s.empty())
+            return false;
+        T v{};
+        std::from_chars_result res;
+        if constexpr (std::is_floating_point_v<T>)
+            res = std::from_chars(s.data(), s.data() + s.size(), v, std::chars_format::general);
+        else
+            res = std::from_chars(s.data(), s.data() + s.size(), v, 10);
+        if ((res.ec != std::errc()) or (res.ptr != s.data() + s.size()))
+            return false;
+        value = v;
+        return true;
+    }
+
     // ---------- Konvertierungsfunktionen ----------
 
     inline int ToInt(std::string_view s) {
         int value{};
-        auto res = std::from_chars(s.data(), s.data() + s.size(), value);
-        if (res.ec != std::errc()) throw std::invalid_argument("Ungltiger Integer");
+        if (not ParseNumber(s, value)) throw std::invalid_argument("Ungltiger Integer");
         return value;
     }
 
     inline size_t ToSizeT(std::string_view s) {
         size_t value{};
-        auto res = std::from_chars(s.data(), s.data() + s.size(), value);
-        if (res.ec != std::errc()) throw std::invalid_argument("Ungltiges size_t");
+        if (not ParseNumber(s, value)) throw std::invalid_argument("Ungltiges size_t");
         return value;
     }
 
     inline float ToFloat(std::string_view s) {
-        try {
-            return std::stof(std::string{ s });
-        }
-        catch (...) {
-            throw std::invalid_argument("Ungltiger Float");
-        }
+        float value{};
+        if (not ParseNumber(s, value)) throw std::invalid_argument("Ungltiger Float");
+        return value;
     }
 
     inline uint16_t ToUInt16(std::string_view s) {
@@ -76,7 +113,105 @@ namespace StringUtils {
 
     // ---------- Split ----------
 
-    std::list<std::string> Split(std::string_view s, char delimiter) {
+    // Zero copy tokenizer: iterates over the fields of text separated by delimiter as views into text.
+    // Fields are delimited like by String::Split() (std::getline): an empty text has no fields, and a
+    // trailing delimiter does not start another (empty) field. text must outlive the SplitView.
+    class SplitView {
+    public:
+        class Iterator {
+        private:
+            const char* m_field{ nullptr }; // nullptr: end
+            const char* m_fieldEnd{ nullptr };
+            const char* m_end{ nullptr };
+            char        m_delimiter{ 0 };
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view*;
+            using reference = std::string_view;
+
+            Iterator() = default;
+
+            Iterator(std::string_view text, char delimiter) noexcept
+                : m_end(text.data() + text.size()), m_delimiter(delimiter)
+            {
+                if (not text.empty())
+                    SetField(text.data());
+            }
+
+            inline std::string_view operator*() const noexcept {
+                return std::string_view(m_field, size_t(m_fieldEnd - m_field));
+            }
+
+            Iterator& operator++() noexcept {
+                if ((m_fieldEnd == m_end) or (m_fieldEnd + 1 == m_end))
+                    m_field = nullptr;
+                else
+                    SetField(m_fieldEnd + 1);
+                return *this;
+            }
+
+            inline Iterator operator++(int) noexcept {
+                Iterator i = *this;
+                ++*this;
+                return i;
+            }
+
+            inline bool operator==(const Iterator& other) const noexcept { return m_field == other.m_field; }
+
+            inline bool operator!=(const Iterator& other) const noexcept { return m_field != other.m_field; }
+
+        private:
+            inline void SetField(const char* field) noexcept {
+                m_field = field;
+                m_fieldEnd = static_cast<const char*>(memchr(field, m_delimiter, size_t(m_end - field)));
+                if (not m_fieldEnd)
+                    m_fieldEnd = m_end;
+            }
+        };
+
+    private:
+        std::string_view    m_text;
+        char                m_delimiter;
+
+    public:
+        SplitView(std::string_view text, char delimiter) noexcept
+            : m_text(text), m_delimiter(delimiter)
+        { }
+
+        inline Iterator begin(void) const noexcept { return Iterator(m_text, m_delimiter); }
+
+        inline Iterator end(void) const noexcept { return Iterator(); }
+
+        int32_t Count(void) const noexcept {
+            int32_t count = 0;
+            for (Iterator i = begin(); i != end(); ++i)
+                ++count;
+            return count;
+        }
+
+        // i-th field, or an empty view if there are not that many fields
+        std::string_view operator[](int32_t index) const noexcept {
+            for (Iterator i = begin(); i != end(); ++i, --index)
+                if (index == 0)
+                    return *i;
+            return std::string_view();
+        }
+    };
+
+    // Stores the fields of text in fields and returns their number. Only allocates if there are more
+    // than CAPACITY fields.
+    template <int32_t CAPACITY>
+    inline int32_t SplitInto(std::string_view text, char delimiter, SmallArray<std::string_view, CAPACITY>& fields) {
+        fields.Clear();
+        for (std::string_view field : SplitView(text, delimiter))
+            fields.Append(field);
+        return fields.Length();
+    }
+
+    inline std::list<std::string> Split(std::string_view s, char delimiter) {
         std::list<std::string> parts;
         size_t start = 0;
         size_t end = 0;
@@ -90,7 +225,7 @@ namespace StringUtils {
 
     // ---------- Replace mit Limitierung ----------
 
-    std::string Replace(std::string_view s, std::string_view oldPattern, std::string_view newPattern, int repetitions = 0) {
+    inline std::string Replace(std::string_view s, std::string_view oldPattern, std::string_view newPattern, int repetitions = 0) {
         std::string result;
         size_t start = 0;
         int count = 0;
@@ -120,7 +255,7 @@ namespace StringUtils {
 
     // ---------- Concat mit Initializer-List ----------
 
-    std::string Concat(std::initializer_list<std::string_view> list) {
+    inline std::string Concat(std::initializer_list<std::string_view> list) {
         size_t totalSize = 0;
         for (auto& str : list)
             totalSize += str.size();
@@ -11,6 +11,7 @@
 #include "SDL.h"
 #pragma warning(pop)
 
+#include "clock.h"
 #include "hiressleep.h"
 #include "conversions.hpp"
 
@@ -38,24 +39,15 @@ public:
     }
 
 
-    static inline int64_t BaseTime() {
-        static int64_t baseTime = int64_t(SDL_GetPerformanceCounter());
+    // time of the first call; hires times are relative to it
+    static inline int64_t BaseTime() noexcept {
+        static int64_t baseTime = Clock::Micros();
         return baseTime;
     }
 
 
-    static inline int64_t Frequency() {
-        static int64_t frequency = int64_t(SDL_GetPerformanceFrequency());
-        return frequency;
-    }
-
-
     static inline int64_t GetHiresTime(int64_t scale = 1) noexcept { // micro seconds
-        const int64_t t = int64_t(SDL_GetPerformanceCounter()) - BaseTime();
-        const int64_t f = Frequency();
-        const int64_t q = t / f;      // Sekunden
-        const int64_t r = t % f;      // Rest-Ticks
-        int64_t time = q * 1000000 + (r * 1000000 + f / 2) / f; // rundet
+        int64_t time = Clock::Micros() - BaseTime();
         return (scale == 1) ? time : (time + scale / 2) / scale;
     }
 
@@ -4,6 +4,11 @@
 #  define USE_TRACY 0
 #endif
 
+// without Tracy, the profiling macros feed the built-in profiler unless USE_PROFILER is 0
+#if !defined(USE_PROFILER)
+#  define USE_PROFILER 1
+#endif
+
 #if USE_TRACY
 #  ifndef TRACY_ENABLE
 #		define TRACY_ENABLE
@@ -27,17 +32,40 @@
 
 #else
 
-#	define ZoneScoped
-#	define ZoneScopedN(x)
-#	define ZoneScopedC(c)
-#	define ZoneScopedNC(x, c)
-#	define FrameMark
-#	define FrameMarkNamed(x)
-#	define FrameMarkStart(x)
-#	define FrameMarkEnd(x)
-#	define TracyMessage(text, size)
-#	define TracyMessageL(text)
-#	define TracyPlot(name, value)
+#	if USE_PROFILER
+
+	// built-in CPU profiler (profiler.h); colors, frame ranges and plot configs are ignored
+#		include "profiler.h"
+
+#		define PROFILER_CONCAT_(a, b) a##b
+#		define PROFILER_CONCAT(a, b) PROFILER_CONCAT_(a, b)
+#		define PROFILER_ZONE(name) ProfileZone PROFILER_CONCAT(profileZone, __LINE__)(name)
+
+#		define ZoneScoped PROFILER_ZONE(__func__)
+#		define ZoneScopedN(x) PROFILER_ZONE(x)
+#		define ZoneScopedC(c) PROFILER_ZONE(__func__)
+#		define ZoneScopedNC(x, c) PROFILER_ZONE(x)
+#		define FrameMark Profiler::Frame()
+#		define FrameMarkNamed(x) Profiler::Frame(x)
+#		define FrameMarkStart(x)
+#		define FrameMarkEnd(x)
+#		define TracyMessage(text, size)
+#		define TracyMessageL(text) Profiler::Message(text)
+#		define TracyPlot(name, value) Profiler::Plot(name, double(value))
+#	else
+#		define ZoneScoped
+#		define ZoneScopedN(x)
+#		define ZoneScopedC(c)
+#		define ZoneScopedNC(x, c)
+#		define FrameMark
+#		define FrameMarkNamed(x)
+#		define FrameMarkStart(x)
+#		define FrameMarkEnd(x)
+#		define TracyMessage(text, size)
+#		define TracyMessageL(text)
+#		define TracyPlot(name, value)
+#	endif
+
 #	define TracyPlotConfig(name, type, step, fill, color)
 #	define TracyGpuContext
 #	define TracyGpuZone(x)
@@ -4,64 +4,77 @@
 #include <new>
 #include "allocator.h"
 
-static bool initializing = false;
-
-static MemoryDescriptor* itemPool = nullptr;
-
-inline void InitAllocator(int capacity = 1000000) {
-	if (not initializing) {
-		initializing = true;
-		static bool initialized = (MemoryManager::Instance().Create(capacity, true), true);
-		itemPool = MemoryManager::Instance().GetDataPool();
-		initializing = false;
-		(void)initialized; // suppress unused warning if needed
-	}
-}
-
 // =================================================================================================
 
-#if DEBUG_MALLOC
+#if SIZE_CLASS_MALLOC
+
+static inline void* AllocOrThrow(std::size_t size) {
+	void* p = SizeClassAllocator::Allocate(size);
+	if (not p)
+		throw std::bad_alloc();
+	return p;
+}
+
 
 void* Allocator::operator new(std::size_t size) {
-	::InitAllocator();
-	return MemoryManager::Instance().Alloc(size);
+	return AllocOrThrow(size);
 }
 
 void Allocator::operator delete(void* ptr) noexcept {
-	MemoryManager::Instance().Free(ptr);
+	SizeClassAllocator::Free(ptr);
 }
 
 void* Allocator::operator new[](std::size_t size) {
-	::InitAllocator();
-	return MemoryManager::Instance().Alloc(size);
+	return AllocOrThrow(size);
 }
 
 void Allocator::operator delete[](void* ptr) noexcept {
-	MemoryManager::Instance().Free(ptr);
+	SizeClassAllocator::Free(ptr);
 }
 
-#endif
-
 // =================================================================================================
-
-#if DEBUG_MALLOC
+// The sized and nothrow variants are replaced as well since some runtimes (and the sanitizers) don't
+// forward them to the plain operators. Over-aligned allocations (align_val_t) keep using the system
+// allocator.
 
 void* operator new(std::size_t size) {
-	InitAllocator();
-	return MemoryManager::Instance().Alloc(size);
+	return AllocOrThrow(size);
 }
 
 void operator delete(void* ptr) noexcept {
-	MemoryManager::Instance().Free(ptr);
+	SizeClassAllocator::Free(ptr);
 }
 
 void* operator new[](std::size_t size) {
-	InitAllocator();
-	return MemoryManager::Instance().Alloc(size);
+	return AllocOrThrow(size);
 }
 
 void operator delete[](void* ptr) noexcept {
-	MemoryManager::Instance().Free(ptr);
+	SizeClassAllocator::Free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	SizeClassAllocator::Free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	SizeClassAllocator::Free(ptr);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return SizeClassAllocator::Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return SizeClassAllocator::Allocate(size);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	SizeClassAllocator::Free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	SizeClassAllocator::Free(ptr);
 }
 
 #endif
@@ -0,0 +1,145 @@
+
+#include <cstdio>
+#include <cstring>
+#include "clock.h"
+
+#ifdef _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <time.h>
+#endif
+
+#if CLOCK_HAS_TSC and not defined(_MSC_VER)
+#   include <cpuid.h>
+#endif
+
+// =================================================================================================
+
+uint64_t Clock::ReadOSTicks(void) noexcept {
+#ifdef _WIN32
+    LARGE_INTEGER c;
+    QueryPerformanceCounter(&c);
+    return uint64_t(c.QuadPart);
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return uint64_t(ts.tv_sec) * uint64_t(nanosPerSecond) + uint64_t(ts.tv_nsec);
+#endif
+}
+
+
+// the clock the TSC is calibrated against, and whose time base Clock adopts
+static int64_t ReferenceNanos(void) noexcept {
+#ifdef _WIN32
+    LARGE_INTEGER c, f;
+    QueryPerformanceCounter(&c);
+    QueryPerformanceFrequency(&f);
+    return int64_t(c.QuadPart / f.QuadPart) * Clock::nanosPerSecond + int64_t(c.QuadPart % f.QuadPart) * Clock::nanosPerSecond / f.QuadPart;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return int64_t(ts.tv_sec) * Clock::nanosPerSecond + int64_t(ts.tv_nsec);
+#endif
+}
+
+// =================================================================================================
+
+#if CLOCK_HAS_TSC
+
+static bool HasInvariantTSC(void) noexcept {
+#   ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0x80000000);
+    if (uint32_t(info[0]) < 0x80000007u)
+        return false;
+    __cpuid(info, 0x80000007);
+    return (info[3] & (1 << 8)) != 0;
+#   else
+    unsigned int eax, ebx, ecx, edx;
+    if (not __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (edx & (1u << 8)) != 0;
+#   endif
+}
+
+
+// Linux only keeps "tsc" as clocksource if the TSCs of all cores are synchronized and did not
+// misbehave; hypervisors usually make it pick their paravirtual clock instead.
+static bool KernelTrustsTSC(void) noexcept {
+#   ifdef __linux__
+    FILE* f = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+    if (not f)
+        return true;
+    char name[32] = {};
+    bool isTSC = fgets(name, sizeof(name), f) and (strncmp(name, "tsc", 3) == 0);
+    fclose(f);
+    return isTSC;
+#   else
+    return true;
+#   endif
+}
+
+
+struct ClockSample {
+    uint64_t    ticks;
+    int64_t     nanos;
+};
+
+// TSC and reference time taken as close together as possible: the reading of the reference clock
+// with the shortest bracketing TSC interval out of a few
+static ClockSample SampleTSC(void) noexcept {
+    ClockSample best{ 0, 0 };
+    uint64_t bestSpan = ~uint64_t(0);
+    for (int i = 0; i < 8; ++i) {
+        uint64_t t0 = Clock::ReadTSC();
+        int64_t nanos = ReferenceNanos();
+        uint64_t t1 = Clock::ReadTSC();
+        if (t1 - t0 < bestSpan) {
+            bestSpan = t1 - t0;
+            best = ClockSample{ t0 + (t1 - t0) / 2, nanos };
+        }
+    }
+    return best;
+}
+
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+Clock::Calibration Clock::Calibrate(void) noexcept {
+#if CLOCK_HAS_TSC
+    static constexpr int64_t calibrationNanos = 10000000;
+    if (HasInvariantTSC() and KernelTrustsTSC()) {
+        ClockSample start = SampleTSC();
+        while (ReferenceNanos() - start.nanos < calibrationNanos)
+            ;
+        ClockSample end = SampleTSC();
+        double ticksPerSecond = double(end.ticks - start.ticks) * double(nanosPerSecond) / double(end.nanos - start.nanos);
+        // reject implausible results, e.g. from a TSC stopped or scaled by a hypervisor
+        if ((ticksPerSecond > 1e8) and (ticksPerSecond < 1e11)) {
+            uint64_t multiplier = uint64_t(double(nanosPerSecond) * double(uint64_t(1) << fractionBits) / ticksPerSecond + 0.5);
+            return Calibration{ Source::TSC, end.ticks, end.nanos, multiplier, ticksPerSecond };
+        }
+    }
+#endif
+#ifdef _WIN32
+    LARGE_INTEGER f;
+    QueryPerformanceFrequency(&f);
+    uint64_t ticks = ReadOSTicks();
+    int64_t nanos = ReferenceNanos();
+    uint64_t multiplier = uint64_t((double(nanosPerSecond) * double(uint64_t(1) << fractionBits)) / double(f.QuadPart) + 0.5);
+    return Calibration{ Source::OS, ticks, nanos, multiplier, double(f.QuadPart) };
+#else
+    return Calibration{ Source::OS, 0, 0, uint64_t(1) << fractionBits, double(nanosPerSecond) };
+#endif
+}
+
+
+const char* Clock::SourceName(Source source) noexcept {
+    return (source == Source::TSC) ? "TSC" : "OS";
+}
+
+// =================================================================================================
@@ -0,0 +1,98 @@
+
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <time.h>
+#include "clock.h"
+
+// =================================================================================================
+// Clock benchmark (make bench): the cost of Clock::Nanos() against clock_gettime(), and the drift of
+// Clock::Nanos() against CLOCK_MONOTONIC over a configurable duration, reported once per second. With
+// the TSC source the drift is the calibration error; with the OS source (CLOCK_MONOTONIC_RAW) it is
+// the NTP frequency correction applied to CLOCK_MONOTONIC only.
+// usage: clockbench [seconds] [calls per cost measurement]
+
+static int64_t ReadClock(clockid_t id) noexcept {
+    timespec ts;
+    clock_gettime(id, &ts);
+    return int64_t(ts.tv_sec) * Clock::nanosPerSecond + int64_t(ts.tv_nsec);
+}
+
+
+// Returns the best time per call in nanoseconds; read must return a time stamp, which also must not
+// decrease from call to call.
+template <typename READ_T>
+static double Measure(int32_t calls, READ_T read, bool& isMonotonic) {
+    double best = 1e30;
+    for (int r = 0; r < 5; ++r) {
+        int64_t last = read();
+        int64_t t0 = ReadClock(CLOCK_MONOTONIC);
+        for (int32_t i = 0; i < calls; ++i) {
+            int64_t t = read();
+            if (t < last)
+                isMonotonic = false;
+            last = t;
+        }
+        best = std::min(best, double(ReadClock(CLOCK_MONOTONIC) - t0) / double(calls));
+    }
+    return best;
+}
+
+
+// Clock::Nanos() - CLOCK_MONOTONIC, with the monotonic clock read before and after and averaged
+static int64_t Offset(void) noexcept {
+    int64_t best = 0;
+    int64_t bestSpan = INT64_MAX;
+    for (int i = 0; i < 8; ++i) {
+        int64_t t0 = ReadClock(CLOCK_MONOTONIC);
+        int64_t nanos = Clock::Nanos();
+        int64_t t1 = ReadClock(CLOCK_MONOTONIC);
+        if (t1 - t0 < bestSpan) {
+            bestSpan = t1 - t0;
+            best = nanos - (t0 + (t1 - t0) / 2);
+        }
+    }
+    return best;
+}
+
+// =================================================================================================
+
+int main(int argc, char** argv) {
+    int seconds = (argc > 1) ? atoi(argv[1]) : 5;
+    int32_t calls = (argc > 2) ? int32_t(atoi(argv[2])) : 1000000;
+    if ((seconds < 1) or (calls < 1)) {
+        fprintf(stderr, "usage: clockbench [seconds >= 1] [calls >= 1]\n");
+        return EXIT_FAILURE;
+    }
+    const Clock::Calibration& calibration = Clock::Calibrated();
+    printf("Clock source: %s (%.0f ticks/s)\n", Clock::SourceName(calibration.source), calibration.ticksPerSecond);
+
+    bool isMonotonic = true;
+    printf("ns per call (best of 5 x %d calls)\n", calls);
+    printf("  Clock::Nanos()                        %6.1f\n", Measure(calls, []() { return Clock::Nanos(); }, isMonotonic));
+    printf("  clock_gettime(CLOCK_MONOTONIC)        %6.1f\n", Measure(calls, []() { return ReadClock(CLOCK_MONOTONIC); }, isMonotonic));
+    printf("  clock_gettime(CLOCK_MONOTONIC_RAW)    %6.1f\n", Measure(calls, []() { return ReadClock(CLOCK_MONOTONIC_RAW); }, isMonotonic));
+#if CLOCK_HAS_TSC
+    bool isTSCMonotonic = true;     // the raw TSC is not checked: it only has to be if Clock uses it
+    printf("  rdtsc                                 %6.1f\n", Measure(calls, []() { return int64_t(Clock::ReadTSC()); }, isTSCMonotonic));
+#endif
+    if (not isMonotonic) {
+        fprintf(stderr, "Clock: a time stamp decreased\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("drift of Clock::Nanos() against CLOCK_MONOTONIC\n");
+    int64_t start = ReadClock(CLOCK_MONOTONIC);
+    int64_t startOffset = Offset();
+    printf("  offset at start: %lld ns\n", (long long) startOffset);
+    for (int s = 1; s <= seconds; ++s) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(start + s * Clock::nanosPerSecond - ReadClock(CLOCK_MONOTONIC)));
+        int64_t drift = Offset() - startOffset;
+        double elapsed = double(ReadClock(CLOCK_MONOTONIC) - start);
+        printf("  %3d s: %+8lld ns (%+.2f ppm)\n", s, (long long) drift, double(drift) * 1e6 / elapsed);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "flatmap.hpp"
+#include "avltree.hpp"
+#include "std_map.hpp"
+#include "string.hpp"
+#include "random.hpp"
+#include "clock.h"
+
+// =================================================================================================
+// Dictionary backend benchmark (make bench): insert, find (hits and misses) and remove on FlatMap,
+// AVLTree and StdMap with integer and String keys. FlatMap is measured with its own key equality and
+// with a comparator set, as the existing Dictionary call sites do. Every round checks the results, so
+// a broken backend fails the run instead of producing fast numbers.
+// usage: flatmapbench [entries] [rounds]
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        ++failures; \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+    }
+
+
+static int CompareInts(void*, const int32_t& i1, const int32_t& i2) noexcept {
+    return (i1 < i2) ? -1 : (i1 > i2) ? 1 : 0;
+}
+
+template <typename KEY_T>
+struct KeyTraits;
+
+template <>
+struct KeyTraits<int32_t> {
+    static constexpr const char* name = "int32_t";
+    static constexpr AVLTreeTraits<int32_t, int32_t>::Comparator compare = CompareInts;
+
+    // the multiplication is a bijection on 32 bits, so the keys are distinct and scattered
+    static int32_t Make(uint32_t i) noexcept {
+        return int32_t(i * 2654435761u);
+    }
+};
+
+template <>
+struct KeyTraits<String> {
+    static constexpr const char* name = "String";
+    static constexpr AVLTreeTraits<String, int32_t>::Comparator compare = String::Compare;
+
+    static String Make(uint32_t i) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "entity/%08x", i * 2654435761u);
+        return String(buffer);
+    }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+struct Timing {
+    double insert{ 1e30 };  // nanoseconds per operation, best round
+    double find{ 1e30 };
+    double miss{ 1e30 };
+    double remove{ 1e30 };
+};
+
+
+static double NanosPerOp(int64_t t0, size_t count) noexcept {
+    return double(Clock::Nanos() - t0) / double(count);
+}
+
+
+template <typename MAP_T, typename KEY_T>
+static Timing Measure(const std::vector<KEY_T>& keys, const std::vector<KEY_T>& lookups, const std::vector<KEY_T>& missing, int rounds, bool setComparator) {
+    Timing best;
+    for (int r = 0; r < rounds; ++r) {
+        MAP_T map;
+        if constexpr (requires { map.SetComparator(KeyTraits<KEY_T>::compare); }) {
+            if (setComparator)
+                map.SetComparator(KeyTraits<KEY_T>::compare);
+        }
+        size_t inserted = 0;
+        int64_t t = Clock::Nanos();
+        for (size_t i = 0; i < keys.size(); ++i)
+            inserted += map.Insert(keys[i], int32_t(i));
+        best.insert = std::min(best.insert, NanosPerOp(t, keys.size()));
+
+        int64_t sum = 0;
+        size_t found = 0;
+        t = Clock::Nanos();
+        for (const KEY_T& key : lookups) {
+            if (const int32_t* value = map.Find(key)) {
+                sum += *value;
+                ++found;
+            }
+        }
+        best.find = std::min(best.find, NanosPerOp(t, lookups.size()));
+
+        size_t falseHits = 0;
+        t = Clock::Nanos();
+        for (const KEY_T& key : missing)
+            falseHits += (map.Find(key) != nullptr);
+        best.miss = std::min(best.miss, NanosPerOp(t, missing.size()));
+
+        size_t removed = 0;
+        t = Clock::Nanos();
+        for (const KEY_T& key : lookups)
+            removed += map.Remove(key);
+        best.remove = std::min(best.remove, NanosPerOp(t, lookups.size()));
+
+        CHECK(inserted == keys.size());
+        CHECK((found == keys.size()) and (sum == int64_t(keys.size()) * int64_t(keys.size() - 1) / 2));
+        CHECK(falseHits == 0);
+        CHECK((removed == keys.size()) and (map.Size() == 0));
+    }
+    return best;
+}
+
+
+static void Print(const char* name, const Timing& timing) {
+    printf("  %-12s %8.1f %8.1f %8.1f %8.1f\n", name, timing.insert, timing.find, timing.miss, timing.remove);
+}
+
+
+template <typename KEY_T>
+static void Run(int entries, int rounds) {
+    std::vector<KEY_T> keys, lookups, missing;
+    keys.reserve(size_t(entries));
+    missing.reserve(size_t(entries));
+    for (int i = 0; i < entries; ++i) {
+        keys.push_back(KeyTraits<KEY_T>::Make(uint32_t(i)));
+        missing.push_back(KeyTraits<KEY_T>::Make(uint32_t(entries + i)));
+    }
+    // look keys up in another order than they were inserted in
+    lookups = keys;
+    RandomStream rng{ uint64_t(entries) };
+    for (size_t i = lookups.size() - 1; i > 0; --i)
+        std::swap(lookups[i], lookups[rng.Bounded(uint32_t(i + 1))]);
+
+    printf("%s keys, %d entries, ns per operation (best of %d rounds)\n", KeyTraits<KEY_T>::name, entries, rounds);
+    printf("  %-12s %8s %8s %8s %8s\n", "", "insert", "find", "miss", "remove");
+    Print("AVLTree", Measure<AVLTree<KEY_T, int32_t>>(keys, lookups, missing, rounds, true));
+    Print("StdMap", Measure<StdMap<KEY_T, int32_t>>(keys, lookups, missing, rounds, true));
+    Print("FlatMap", Measure<FlatMap<KEY_T, int32_t>>(keys, lookups, missing, rounds, false));
+    Print("FlatMap+cmp", Measure<FlatMap<KEY_T, int32_t>>(keys, lookups, missing, rounds, true));
+}
+
+// =================================================================================================
+
+int main(int argc, char** argv) {
+    int entries = (argc > 1) ? atoi(argv[1]) : 100000;
+    int rounds = (argc > 2) ? atoi(argv[2]) : 5;
+    if ((entries < 2) or (rounds < 1)) {
+        fprintf(stderr, "usage: flatmapbench [entries >= 2] [rounds >= 1]\n");
+        return EXIT_FAILURE;
+    }
+    Run<int32_t>(entries, rounds);
+    Run<String>(entries, rounds);
+    if (failures) {
+        fprintf(stderr, "FlatMap benchmark: %d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+
+#include <cstdlib>
+#include <algorithm>
+#include "framearena.h"
+
+// =================================================================================================
+
+void* LinearArena::Allocate(size_t size, size_t alignment) noexcept {
+    for (;;) {
+        if (m_block < int32_t(m_blocks.size())) {
+            Block& block = m_blocks[m_block];
+            uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+            uintptr_t p = (base + m_offset + alignment - 1) & ~uintptr_t(alignment - 1);
+            size_t end = size_t(p - base) + size;
+            if (end <= block.size) {
+                m_used += end - m_offset;
+                m_offset = end;
+                return reinterpret_cast<void*>(p);
+            }
+            if (m_block + 1 < int32_t(m_blocks.size())) { // move on to the next block, if there is one
+                m_used += block.size - m_offset;
+                ++m_block;
+                m_offset = 0;
+                continue;
+            }
+        }
+        if (not AllocBlock(std::max(m_blockSize, size + alignment)))
+            return nullptr;
+        if (m_block < int32_t(m_blocks.size()) - 1) {
+            m_used += m_blocks[m_block].size - m_offset;
+            m_block = int32_t(m_blocks.size()) - 1;
+            m_offset = 0;
+        }
+    }
+}
+
+
+void LinearArena::Reset(void) {
+    if (m_block > 0) { // the last cycle needed several blocks: consolidate them
+        size_t size = Capacity();
+        Destroy();
+        AllocBlock(size);
+    }
+    m_block = 0;
+    m_offset = 0;
+    m_used = 0;
+}
+
+
+void LinearArena::Destroy(void) noexcept {
+    for (Block& block : m_blocks)
+        free(block.data);
+    m_blocks.clear();
+    m_block = 0;
+    m_offset = 0;
+    m_used = 0;
+}
+
+
+size_t LinearArena::Capacity(void) const noexcept {
+    size_t capacity = 0;
+    for (const Block& block : m_blocks)
+        capacity += block.size;
+    return capacity;
+}
+
+
+bool LinearArena::AllocBlock(size_t size) noexcept {
+    char* data = static_cast<char*>(malloc(size));
+    if (not data)
+        return false;
+    try {
+        m_blocks.push_back(Block{ data, size });
+    }
+    catch (...) {
+        free(data);
+        return false;
+    }
+    return true;
+}
+
+// =================================================================================================
+// Links a thread to its arenas. Destroyed at thread exit, which retires the thread's arenas.
+// Threads may outlive the FrameArena singleton (e.g. job workers stopped during static destruction);
+// their arenas have been freed by the FrameArena destructor then.
+
+static std::atomic<bool> frameArenaExists{ false };
+
+struct FrameArenaThreadLink {
+    FrameArena::ThreadArenas*   arenas{ nullptr };
+
+    ~FrameArenaThreadLink() {
+        if (arenas and frameArenaExists.load())
+            frameArena.UnregisterThread(arenas);
+    }
+};
+
+static thread_local FrameArenaThreadLink threadLink;
+
+
+FrameArena::ThreadArenas* FrameArena::ThreadLocalArenas(void) noexcept {
+    return threadLink.arenas ? threadLink.arenas : (threadLink.arenas = RegisterThread());
+}
+
+
+FrameArena::ThreadArenas* FrameArena::RegisterThread(void) noexcept {
+    try {
+        std::unique_ptr<ThreadArenas> arenas = std::make_unique<ThreadArenas>();
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (LinearArena& arena : arenas->arenas)
+            arena.SetBlockSize(m_blockSize);
+        m_threadArenas.push_back(std::move(arenas));
+        return m_threadArenas.back().get();
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+
+void FrameArena::UnregisterThread(ThreadArenas* arenas) noexcept {
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto it = std::find_if(m_threadArenas.begin(), m_threadArenas.end(), [arenas](const auto& p) { return p.get() == arenas; });
+    if (it == m_threadArenas.end())
+        return;
+    // allocations of the thread may still be in use during the frames in flight
+    (*it)->retireFrame = m_frame;
+    try {
+        m_retiredArenas.push_back(std::move(*it));
+    }
+    catch (...) { } // out of memory: the arenas are freed right away
+    m_threadArenas.erase(it);
+}
+
+
+FrameArena::FrameArena() {
+    frameArenaExists.store(true);
+}
+
+
+FrameArena::~FrameArena() {
+    frameArenaExists.store(false);
+    Destroy();
+}
+
+
+void FrameArena::BeginFrame(void) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    int32_t slot = m_slot.load(std::memory_order_relaxed);
+    Stats stats;
+    for (auto& t : m_threadArenas) {
+        stats.used += t->arenas[slot].Used();
+        stats.capacity += t->arenas[slot].Capacity();
+    }
+    stats.threadCount = int32_t(m_threadArenas.size());
+    stats.highWaterMark = std::max(m_stats.highWaterMark, stats.used);
+    m_stats = stats;
+
+    ++m_frame;
+    slot = int32_t(m_frame % FRAME_COUNT);
+    for (auto& t : m_threadArenas)
+        t->arenas[slot].Reset();
+    std::erase_if(m_retiredArenas, [this](const auto& t) { return m_frame >= t->retireFrame + FRAME_COUNT; });
+    m_slot.store(slot, std::memory_order_relaxed);
+}
+
+
+void FrameArena::SetBlockSize(size_t blockSize) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_blockSize = blockSize;
+    for (auto& t : m_threadArenas)
+        for (LinearArena& arena : t->arenas)
+            arena.SetBlockSize(blockSize);
+}
+
+
+void FrameArena::Destroy(void) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (auto& t : m_threadArenas)
+        for (LinearArena& arena : t->arenas)
+            arena.Destroy();
+    m_retiredArenas.clear();
+}
+
+// =================================================================================================
@@ -0,0 +1,101 @@
+
+#include <cmath>
+#include <thread>
+#include <algorithm>
+#include "simd.h"
+#include "hiressleep.h"
+#include "framepacer.h"
+
+#if SIMD_X86
+#   include <immintrin.h>
+#endif
+
+// =================================================================================================
+
+static inline void Pause(void) noexcept {
+#if SIMD_X86
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+
+void FramePacer::Start(void) noexcept {
+    m_deadline = Clock::Nanos() + m_interval;
+    m_frames = 0;
+    m_missed = 0;
+    m_errorCount = 0;
+}
+
+
+int64_t FramePacer::Wait(void) {
+    int64_t now = Clock::Nanos();
+    if (m_interval == 0)
+        return now;
+    if (m_deadline == 0)
+        m_deadline = now + m_interval;
+    ++m_frames;
+    if (now >= m_deadline) {
+        ++m_missed;
+        m_deadline = (now - m_deadline >= m_interval) ? now + m_interval : m_deadline + m_interval;
+        return now;
+    }
+    int64_t sleepEnd = m_deadline - m_margin;
+    if (now < sleepEnd) {
+        hiresSleep.SleepTo(sleepEnd / 1000);
+        now = Clock::Nanos();
+        TuneMargin(now - sleepEnd);
+    }
+    for (; now < m_deadline; now = Clock::Nanos()) {
+        if (m_deadline - now >= yieldThreshold)
+            std::this_thread::yield();
+        else
+            Pause();
+    }
+    RecordWake(now - m_deadline);
+    m_deadline += m_interval;
+    return now;
+}
+
+
+void FramePacer::RecordWake(int64_t error) noexcept {
+    m_wakeErrors[m_errorCount % windowSize] = int32_t(std::min(error, int64_t(INT32_MAX)));
+    ++m_errorCount;
+}
+
+
+void FramePacer::TuneMargin(int64_t oversleep) noexcept {
+    double delta = double(oversleep) - m_oversleepMean;
+    m_oversleepMean += delta / 16.0;
+    m_oversleepDeviation += (std::fabs(delta) - m_oversleepDeviation) / 16.0;
+    int64_t target = int64_t(m_oversleepMean + 4.0 * m_oversleepDeviation) + minMargin;
+    if (oversleep >= m_margin)   // woke up in (or past) the spin phase: back off at once
+        m_margin = oversleep + oversleep / 2;
+    else if (target > m_margin)
+        m_margin = target;
+    else
+        m_margin -= (m_margin - target) / 32;
+    m_margin = std::clamp(m_margin, minMargin, maxMargin);
+}
+
+
+FramePacer::Statistics FramePacer::GetStatistics(void) const noexcept {
+    Statistics stats{ m_frames, m_missed, 0.0f, 0.0f, 0.0f, float(m_margin) * 0.001f };
+    size_t n = std::min(m_errorCount, windowSize);
+    if (n == 0)
+        return stats;
+    int32_t errors[windowSize];
+    std::copy_n(m_wakeErrors, n, errors);
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+        sum += errors[i];
+    size_t p99 = (n * 99 + 99) / 100 - 1;
+    std::nth_element(errors, errors + p99, errors + n);
+    stats.meanError = float(double(sum) / double(n) * 0.001);
+    stats.p99Error = float(errors[p99]) * 0.001f;
+    stats.maxError = float(*std::max_element(errors + p99, errors + n)) * 0.001f;
+    return stats;
+}
+
+// =================================================================================================
@@ -0,0 +1,266 @@
+
+#include <cstdio>
+#include "jobsystem.h"
+#include "profiler.h"
+
+// =================================================================================================
+
+static thread_local int32_t currentThreadIndex = -1;
+
+int32_t JobSystem::ThreadIndex(void) noexcept {
+    return currentThreadIndex;
+}
+
+// =================================================================================================
+// Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models").
+// top and bottom are accessed sequentially consistent where the original uses seq_cst fences,
+// which keeps the algorithm verifiable by ThreadSanitizer.
+
+bool JobSystem::WorkQueue::Push(Job* job) noexcept {
+    int64_t b = m_bottom.load(std::memory_order_relaxed);
+    int64_t t = m_top.load(std::memory_order_acquire);
+    if (b - t >= capacity)
+        return false;
+    m_jobs[b & mask].store(job, std::memory_order_relaxed);
+    m_bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+
+JobSystem::Job* JobSystem::WorkQueue::Pop(void) noexcept {
+    int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(b, std::memory_order_seq_cst);
+    int64_t t = m_top.load(std::memory_order_seq_cst);
+    if (t > b) { // empty
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Job* job = m_jobs[b & mask].load(std::memory_order_relaxed);
+    if (t == b) { // last job: race against thieves
+        if (not m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            job = nullptr;
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+
+JobSystem::Job* JobSystem::WorkQueue::Steal(void) noexcept {
+    int64_t t = m_top.load(std::memory_order_seq_cst);
+    int64_t b = m_bottom.load(std::memory_order_seq_cst);
+    if (t >= b)
+        return nullptr;
+    Job* job = m_jobs[t & mask].load(std::memory_order_relaxed);
+    if (not m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+    return job;
+}
+
+// =================================================================================================
+
+void JobCounter::Done(void) {
+#if USE_JOBS
+    m_finishing.fetch_add(1, std::memory_order_relaxed);
+    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::vector<JobEntry*> jobs;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            jobs.swap(m_waitingJobs);
+        }
+        for (JobEntry* job : jobs)
+            jobSystem.Enqueue(job);
+    }
+    m_finishing.fetch_sub(1, std::memory_order_release); // last access to this counter
+#else
+    m_pending.fetch_sub(1, std::memory_order_relaxed);
+#endif
+}
+
+// =================================================================================================
+
+bool JobSystem::Init(int32_t threadCount) {
+#if USE_JOBS
+    if (m_isRunning.load())
+        return true;
+    if (threadCount < 0)
+        threadCount = std::max(int32_t(std::thread::hardware_concurrency()) - 1, 0);
+    if (threadCount == 0)
+        return true;
+    currentThreadIndex = 0;
+    m_queues.reserve(size_t(threadCount) + 1);
+    for (int32_t i = 0; i <= threadCount; ++i)
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    m_isRunning.store(true);
+    try {
+        m_workers.reserve(size_t(threadCount));
+        for (int32_t i = 1; i <= threadCount; ++i)
+            m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+    catch (...) {
+        Shutdown();
+        return false;
+    }
+#endif
+    return true;
+}
+
+
+void JobSystem::Shutdown(void) {
+#if USE_JOBS
+    if (not m_isRunning.exchange(false))
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepLock);
+        m_wakeUp.notify_all();
+    }
+    for (auto& worker : m_workers)
+        worker.join();
+    m_workers.clear();
+    // whatever is left is executed by the calling thread so no counter is left waiting
+    while (Job* job = FindJob(currentThreadIndex))
+        Execute(job);
+    m_queues.clear();
+    m_queuedJobs.store(0);
+#endif
+}
+
+
+void JobSystem::Submit(JobFunction task, JobCounter* counter, JobCounter* dependency) {
+    if (counter)
+        counter->Add();
+#if USE_JOBS
+    if (m_isRunning.load(std::memory_order_relaxed)) {
+        Job* job = new Job{ std::move(task), counter };
+        if (dependency) {
+            std::unique_lock<std::mutex> lock(dependency->m_lock);
+            if (dependency->m_pending.load(std::memory_order_acquire) != 0) {
+                dependency->m_waitingJobs.push_back(job);
+                return;
+            }
+        }
+        Enqueue(job);
+        return;
+    }
+#endif
+    // immediate mode: dependencies are always done since every job completes when submitted
+    task();
+    if (counter)
+        counter->Done();
+}
+
+
+void JobSystem::Enqueue(Job* job) {
+#if USE_JOBS
+    if (not m_isRunning.load(std::memory_order_relaxed)) { // job was held back by a dependency during shutdown
+        Execute(job);
+        return;
+    }
+    int32_t i = currentThreadIndex;
+    m_queuedJobs.fetch_add(1, std::memory_order_seq_cst);
+    if (i < 0) {
+        std::lock_guard<std::mutex> lock(m_sharedLock);
+        m_sharedQueue.push_back(job);
+    }
+    else if (not m_queues[i]->Push(job)) { // queue full: execute right away
+        m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        Execute(job);
+        return;
+    }
+    if (m_sleepers.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepLock);
+        m_wakeUp.notify_one();
+    }
+#else
+    Execute(job);
+#endif
+}
+
+
+JobSystem::Job* JobSystem::FindJob(int32_t threadIndex) {
+#if USE_JOBS
+    if (m_queues.empty())
+        return nullptr;
+    Job* job = nullptr;
+    if (threadIndex >= 0)
+        job = m_queues[threadIndex]->Pop();
+    if (not job) {
+        std::lock_guard<std::mutex> lock(m_sharedLock);
+        if (not m_sharedQueue.empty()) {
+            job = m_sharedQueue.front();
+            m_sharedQueue.pop_front();
+        }
+    }
+    if (not job) {
+        // start stealing at a different queue for every thread to spread the contention
+        int32_t queueCount = int32_t(m_queues.size());
+        int32_t start = (threadIndex < 0) ? 0 : threadIndex + 1;
+        for (int32_t i = 0; (i < queueCount) and not job; ++i) {
+            int32_t q = (start + i) % queueCount;
+            if (q != threadIndex)
+                job = m_queues[q]->Steal();
+        }
+    }
+    if (job)
+        m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+#else
+    return nullptr;
+#endif
+}
+
+
+void JobSystem::Execute(Job* job) {
+    job->task();
+    JobCounter* counter = job->counter;
+    delete job;
+    if (counter)
+        counter->Done();
+}
+
+
+bool JobSystem::Help(void) {
+    Job* job = FindJob(currentThreadIndex);
+    if (not job)
+        return false;
+    Execute(job);
+    return true;
+}
+
+
+void JobSystem::Wait(JobCounter& counter) {
+    while (not counter.IsDone()) {
+        if (not Help())
+            std::this_thread::yield();
+    }
+}
+
+
+void JobSystem::WorkerLoop(int32_t index) {
+#if USE_JOBS
+    currentThreadIndex = index;
+    char threadName[32];
+    snprintf(threadName, sizeof(threadName), "Worker %d", index);
+    Profiler::SetThreadName(threadName);
+    static constexpr int spinCount = 64;
+    int idleSpins = 0;
+    while (m_isRunning.load(std::memory_order_relaxed)) {
+        if (Help()) {
+            idleSpins = 0;
+            continue;
+        }
+        if (++idleSpins < spinCount) {
+            std::this_thread::yield();
+            continue;
+        }
+        idleSpins = 0;
+        std::unique_lock<std::mutex> lock(m_sleepLock);
+        m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+        m_wakeUp.wait(lock, [this]() {
+            return (m_queuedJobs.load(std::memory_order_seq_cst) > 0) or not m_isRunning.load();
+            });
+        m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+#endif
+}
+
+// =================================================================================================
@@ -0,0 +1,218 @@
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include "jobsystem.h"
+
+// =================================================================================================
+// Stress test of the JobSystem (make test; make test-tsan builds it with ThreadSanitizer).
+// usage: jobsystemtest [rounds] [worker threads]
+// Every round checks plain submission (more jobs than a work queue holds), dependencies, jobs
+// submitted by jobs and by threads outside the job system, ParallelFor, Wait()/Help() on the Init()
+// thread and Shutdown() with jobs still queued or held back by a dependency.
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        ++failures; \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+    }
+
+
+// a little work, so jobs overlap and get stolen
+static void Spin(int n) {
+    volatile int x = 0;
+    for (int i = 0; i < n; ++i)
+        x = x + i;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+static void TestSubmit(void) {
+    static constexpr int jobCount = 10000;  // more than a WorkQueue holds: the rest runs right away
+    std::atomic<int> executed{ 0 };
+    JobCounter counter;
+    for (int i = 0; i < jobCount; ++i)
+        jobSystem.Submit([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    jobSystem.Wait(counter);
+    CHECK(counter.IsDone() and (counter.Pending() == 0));
+    CHECK(executed.load() == jobCount);
+}
+
+
+// three stages, each depending on the previous one; every job checks that its stage's
+// dependency has completely finished
+static void TestDependencies(void) {
+    static constexpr int jobCount = 200;
+    std::atomic<int> stages[3] = { 0, 0, 0 };
+    std::atomic<int> violations{ 0 };
+    JobCounter counters[3];
+    for (int s = 0; s < 3; ++s) {
+        for (int i = 0; i < jobCount; ++i)
+            jobSystem.Submit([&, s]() {
+                if ((s > 0) and (stages[s - 1].load() != jobCount))
+                    violations.fetch_add(1);
+                Spin(100);
+                stages[s].fetch_add(1);
+                }, counters + s, (s > 0) ? counters + s - 1 : nullptr);
+    }
+    // depending on a counter which is already done must not hold the job back
+    JobCounter done, late;
+    std::atomic<bool> hasRun{ false };
+    jobSystem.Submit([&hasRun]() { hasRun.store(true); }, &late, &done);
+    // every counter has to be waited for: a dependent stage can finish before the Done() call of the
+    // stage it depends on has returned
+    for (JobCounter& counter : counters)
+        jobSystem.Wait(counter);
+    jobSystem.Wait(late);
+    CHECK(violations.load() == 0);
+    CHECK((stages[0].load() == jobCount) and (stages[1].load() == jobCount) and (stages[2].load() == jobCount));
+    CHECK(hasRun.load());
+}
+
+
+// jobs submitting jobs from worker threads, and a thread outside of the job system submitting to
+// the shared queue at the same time
+static void TestNestedAndExternal(void) {
+    static constexpr int jobCount = 100;
+    static constexpr int childCount = 10;
+    std::atomic<int> executed{ 0 };
+    JobCounter parents, children, external;
+    for (int i = 0; i < jobCount; ++i)
+        jobSystem.Submit([&]() {
+            for (int j = 0; j < childCount; ++j)
+                jobSystem.Submit([&executed]() { Spin(50); executed.fetch_add(1); }, &children);
+            }, &parents);
+    std::atomic<int> externalIndex{ 0 };
+    std::thread submitter([&]() {
+        externalIndex.store(JobSystem::ThreadIndex());
+        for (int i = 0; i < jobCount; ++i)
+            jobSystem.Submit([&executed]() { executed.fetch_add(1); }, &external);
+        });
+    submitter.join();
+    // children are only counted once their parent has submitted them
+    jobSystem.Wait(parents);
+    jobSystem.Wait(children);
+    jobSystem.Wait(external);
+    CHECK(externalIndex.load() == -1);
+    CHECK(executed.load() == jobCount * childCount + jobCount);
+}
+
+
+static void TestParallelFor(void) {
+    static constexpr int32_t count = 10000;
+    std::vector<std::atomic<int>> visits(count);
+    for (int32_t grain : { 0, 1, 7, 1000, count, 2 * count }) {
+        for (auto& v : visits)
+            v.store(0, std::memory_order_relaxed);
+        jobSystem.ParallelFor(0, count, grain, [&visits](int32_t i) { visits[size_t(i)].fetch_add(1, std::memory_order_relaxed); });
+        int wrong = 0;
+        for (auto& v : visits)
+            wrong += (v.load() != 1);
+        CHECK(wrong == 0);
+    }
+    // empty and offset ranges
+    std::atomic<int> calls{ 0 };
+    jobSystem.ParallelFor(5, 5, 0, [&calls](int32_t) { calls.fetch_add(1); });
+    CHECK(calls.load() == 0);
+    std::atomic<int64_t> sum{ 0 };
+    jobSystem.ParallelFor(-500, 1500, 16, [&sum](int32_t i) { sum.fetch_add(i); });
+    CHECK(sum.load() == int64_t(-500 + 1499) * 2000 / 2);
+    // item overload
+    AutoArray<int> items;
+    items.Resize(1000);
+    for (int i = 0; i < 1000; ++i)
+        items[i] = i;
+    jobSystem.ParallelFor(items, 0, [](int& item) { item *= 2; });
+    int wrong = 0;
+    for (int i = 0; i < 1000; ++i)
+        wrong += (items[i] != 2 * i);
+    CHECK(wrong == 0);
+}
+
+
+// While every worker is blocked, only the Init() thread can run the jobs it submitted: Help()
+// executes them one by one on thread 0 and returns false once the queues are empty.
+static void TestHelp(void) {
+    static constexpr int jobCount = 50;
+    int32_t workerCount = jobSystem.WorkerCount();
+    std::atomic<int> blocked{ 0 };
+    std::atomic<bool> release{ false };
+    JobCounter blockers;
+    for (int32_t i = 0; i < workerCount; ++i)
+        jobSystem.Submit([&]() {
+            blocked.fetch_add(1);
+            while (not release.load())
+                std::this_thread::yield();
+            }, &blockers);
+    while (blocked.load() < workerCount)
+        std::this_thread::yield();
+    std::atomic<int> onMainThread{ 0 };
+    JobCounter counter;
+    for (int i = 0; i < jobCount; ++i)
+        jobSystem.Submit([&onMainThread]() {
+            if (JobSystem::ThreadIndex() == 0)
+                onMainThread.fetch_add(1);
+            }, &counter);
+    int helped = 0;
+    while (jobSystem.Help())
+        ++helped;
+    CHECK(helped == jobCount);
+    CHECK(counter.IsDone());
+    CHECK(onMainThread.load() == jobCount);
+    release.store(true);
+    jobSystem.Wait(blockers);
+    CHECK(not jobSystem.Help());
+}
+
+
+// Shutdown() must run every job that is still queued or held back by a dependency, so no counter is
+// left waiting.
+static void TestShutdown(int32_t workerCount) {
+    static constexpr int jobCount = 2000;
+    std::atomic<int> executed{ 0 };
+    JobCounter first, second;
+    for (int i = 0; i < jobCount; ++i)
+        jobSystem.Submit([&executed]() { Spin(200); executed.fetch_add(1); }, &first);
+    for (int i = 0; i < jobCount; ++i)
+        jobSystem.Submit([&executed]() { executed.fetch_add(1); }, &second, &first);
+    jobSystem.Shutdown();
+    CHECK(not jobSystem.IsParallel());
+    CHECK(first.IsDone() and second.IsDone());
+    CHECK(executed.load() == 2 * jobCount);
+    // after Shutdown() jobs are executed immediately by the submitting thread
+    bool hasRun = false;
+    JobCounter counter;
+    jobSystem.Submit([&hasRun]() { hasRun = true; }, &counter);
+    CHECK(hasRun and counter.IsDone());
+    CHECK(jobSystem.Init(workerCount));
+}
+
+// =================================================================================================
+
+int main(int argc, char** argv) {
+    int rounds = (argc > 1) ? atoi(argv[1]) : 20;
+    int32_t workerCount = (argc > 2) ? int32_t(atoi(argv[2])) : 3;   // more workers than cores is fine
+    if (not jobSystem.Init(workerCount) or (jobSystem.WorkerCount() != workerCount)) {
+        fprintf(stderr, "JobSystem: cannot start %d workers\n", workerCount);
+        return EXIT_FAILURE;
+    }
+    CHECK(JobSystem::ThreadIndex() == 0);
+    for (int i = 0; (i < rounds) and not failures; ++i) {
+        TestSubmit();
+        TestDependencies();
+        TestNestedAndExternal();
+        TestParallelFor();
+        TestHelp();
+        TestShutdown(workerCount);
+    }
+    jobSystem.Shutdown();
+    if (failures)
+        fprintf(stderr, "JobSystem: %d checks failed\n", failures);
+    else
+        printf("JobSystem: all checks passed (%d rounds, %d workers)\n", rounds, workerCount);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+
+#include <list>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "std_list.hpp"
+#include "random.hpp"
+#include "clock.h"
+
+// =================================================================================================
+// Indexed access benchmark of List (make bench): forward and backward loops over list indices, random
+// indices (served by the skip index) and, for comparison, iterator traversal and the walk from the
+// closer list end that every indexed access took before the cursor and skip index existed.
+// usage: listbench [items] [rounds]
+
+struct Timing {
+    double  nanos{ 1e30 };  // per access, best round
+    int64_t sum{ 0 };
+};
+
+
+template <typename FUNC_T>
+static Timing Measure(int rounds, int32_t accesses, FUNC_T access) {
+    Timing timing;
+    for (int r = 0; r < rounds; ++r) {
+        int64_t t = Clock::Nanos();
+        timing.sum = access();
+        timing.nanos = std::min(timing.nanos, double(Clock::Nanos() - t) / double(accesses));
+    }
+    return timing;
+}
+
+
+// the former List::operator[]: walk from head or tail
+static int WalkFromEnd(const std::list<int>& list, int32_t i) {
+    int32_t l = int32_t(list.size());
+    return (l - i < i) ? *std::prev(list.end(), l - i) : *std::next(list.begin(), i);
+}
+
+// =================================================================================================
+
+int main(int argc, char** argv) {
+    int32_t count = (argc > 1) ? int32_t(atoi(argv[1])) : 100000;
+    int rounds = (argc > 2) ? atoi(argv[2]) : 5;
+    if ((count < 1) or (rounds < 1)) {
+        fprintf(stderr, "usage: listbench [items >= 1] [rounds >= 1]\n");
+        return EXIT_FAILURE;
+    }
+    List<int> list;
+    for (int32_t i = 0; i < count; ++i)
+        list.Append(i);
+    int64_t expected = int64_t(count) * int64_t(count - 1) / 2;
+
+    RandomStream rng{ uint64_t(count) };
+    std::vector<int32_t> indices;
+    indices.resize(size_t(count));
+    for (int32_t& i : indices)
+        i = int32_t(rng.Bounded(uint32_t(count)));
+    int64_t randomSum = 0;
+    for (int32_t i : indices)
+        randomSum += i;
+    // walking to random positions is O(n) per access: only a sample of them is timed
+    int32_t walkCount = std::min(count, 2000);
+    const std::list<int>& stdList = list.GetList();
+
+    Timing timings[5] = {
+        Measure(rounds, count, [&]() { int64_t s = 0; for (int value : list) s += value; return s; }),
+        Measure(rounds, count, [&]() { int64_t s = 0; for (int32_t i = 0; i < count; ++i) s += list[i]; return s; }),
+        Measure(rounds, count, [&]() { int64_t s = 0; for (int32_t i = count - 1; i >= 0; --i) s += list[i]; return s; }),
+        Measure(rounds, count, [&]() { int64_t s = 0; for (int32_t i : indices) s += list[i]; return s; }),
+        Measure(rounds, walkCount, [&]() { int64_t s = 0; for (int32_t k = 0; k < walkCount; ++k) s += WalkFromEnd(stdList, indices[size_t(k)]); return s; }),
+    };
+    int64_t walkSum = 0;
+    for (int32_t k = 0; k < walkCount; ++k)
+        walkSum += indices[size_t(k)];
+    bool correct = (timings[0].sum == expected) and (timings[1].sum == expected) and (timings[2].sum == expected) and (timings[3].sum == randomSum) and (timings[4].sum == walkSum);
+    if (not correct) {
+        fprintf(stderr, "List benchmark: wrong items accessed\n");
+        return EXIT_FAILURE;
+    }
+    printf("List of %d items, ns per access (best of %d rounds)\n", count, rounds);
+    printf("  iterator            %10.1f\n", timings[0].nanos);
+    printf("  index, forward      %10.1f\n", timings[1].nanos);
+    printf("  index, backward     %10.1f\n", timings[2].nanos);
+    printf("  index, random       %10.1f\n", timings[3].nanos);
+    printf("  walk from list end  %10.1f (random indices, without cursor and skip index)\n", timings[4].nanos);
+    return EXIT_SUCCESS;
+}
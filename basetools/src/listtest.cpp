@@ -0,0 +1,238 @@
+
+#include <list>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "std_list.hpp"
+#include "random.hpp"
+
+// =================================================================================================
+// Randomized test of the index acceleration of List (make test): applies random mutations (append,
+// insert, erase, extract, remove, pop, sort, merge, move, filter and structural changes through
+// StdList(), including length preserving splices) to a List and to a std::vector as reference, and
+// after each one compares indexed accesses (near the cursor, far jumps through the skip index and
+// negative indices) and occasionally complete forward and backward indexed scans.
+// usage: listtest [operations] [seed]
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        ++failures; \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+    }
+
+
+using Model = std::vector<int>;
+
+static int nextValue = 0;  // values are unique, so Find() and Remove() have a single match
+
+
+static bool IsEqual(List<int>& list, const Model& model, bool scan, RandomStream& rng) {
+    int32_t l = int32_t(model.size());
+    if (list.Length() != l)
+        return false;
+    if (l == 0)
+        return true;
+    if (scan) {
+        for (int32_t i = 0; i < l; ++i)
+            if (list[i] != model[size_t(i)])
+                return false;
+        for (int32_t i = l - 1; i >= 0; --i)
+            if (list[i] != model[size_t(i)])
+                return false;
+    }
+    for (int n = 0; n < 8; ++n) {
+        int32_t i = int32_t(rng.Bounded(uint32_t(l)));
+        if (list[i] != model[size_t(i)])
+            return false;
+        if ((i + 1 < l) and (list[i + 1] != model[size_t(i + 1)])) // next to the cursor
+            return false;
+        if (list[i - l] != model[size_t(i)]) // counted from the end
+            return false;
+    }
+    return true;
+}
+
+
+// a list of count sorted unique values, for Merge()
+static void MakeSorted(List<int>& list, Model& model, int count) {
+    for (int i = 0; i < count; ++i) {
+        list.Append(nextValue);
+        model.push_back(nextValue++);
+    }
+}
+
+
+static void Mutate(List<int>& list, Model& model, RandomStream& rng) {
+    int32_t l = int32_t(model.size());
+    // keep the length mostly above the skip index threshold, but let it shrink now and then
+    bool grow = (l < 512) or ((l < 4096) and (rng.Bounded(2) == 0));
+    uint32_t op = rng.Bounded(16);
+    if ((l == 0) or (grow and (op >= 8)))
+        op = rng.Bounded(4);
+    int32_t i = (l > 0) ? int32_t(rng.Bounded(uint32_t(l))) : 0;
+    switch (op) {
+        case 0:
+            list.Append(nextValue);
+            model.push_back(nextValue++);
+            break;
+        case 1:
+            list.Push(nextValue);
+            model.push_back(nextValue++);
+            break;
+        case 2: { // at any position including the end
+            int32_t j = int32_t(rng.Bounded(uint32_t(l + 1)));
+            list.Insert(j, nextValue);
+            model.insert(model.begin() + j, nextValue++);
+            break;
+        }
+        case 3: { // through StdList()
+            std::list<int>& stdList = list.StdList();
+            stdList.insert(std::next(stdList.begin(), i), nextValue);
+            model.insert(model.begin() + i, nextValue++);
+            break;
+        }
+        case 8:
+            CHECK(list.Discard(i));
+            model.erase(model.begin() + i);
+            break;
+        case 9: {
+            int value = -1;
+            CHECK(list.Extract(value, i) and (value == model[size_t(i)]));
+            model.erase(model.begin() + i);
+            break;
+        }
+        case 10:
+            list.Erase(i);
+            model.erase(model.begin() + i);
+            break;
+        case 11:
+            if (rng.Bounded(2)) {
+                list.DiscardFirst();
+                model.erase(model.begin());
+            }
+            else {
+                CHECK(list.Pop() == model.back());
+                model.pop_back();
+            }
+            break;
+        case 12: // an existing and a missing value
+            CHECK(list.Remove(model[size_t(i)]));
+            model.erase(model.begin() + i);
+            CHECK(not list.Remove(-1));
+            break;
+        case 13: { // length preserving: move a range to another position
+            std::list<int>& stdList = list.StdList();
+            int32_t n = int32_t(rng.Bounded(uint32_t(std::min(l - i, 200)))) + 1;
+            int32_t to = int32_t(rng.Bounded(uint32_t(l - n + 1)));   // position in the remaining list
+            auto first = std::next(stdList.begin(), i);
+            auto last = std::next(first, n);
+            std::list<int> range;
+            range.splice(range.end(), stdList, first, last);
+            stdList.splice(std::next(stdList.begin(), to), range);
+            Model moved(model.begin() + i, model.begin() + i + n);
+            model.erase(model.begin() + i, model.begin() + i + n);
+            model.insert(model.begin() + to, moved.begin(), moved.end());
+            break;
+        }
+        case 14: { // a following access by index starts at the found item
+            int value = model[size_t(i)];
+            CHECK(list.Find(value) == i);
+            CHECK(list[i] == value);
+            CHECK(list.Find(-1) == -1);
+            break;
+        }
+        default:
+            switch (rng.Bounded(5)) {
+                case 0: { // append another list
+                    List<int> other;
+                    int count = int(rng.Bounded(100));
+                    for (int k = 0; k < count; ++k) {
+                        other.Append(nextValue);
+                        model.push_back(nextValue++);
+                    }
+                    if (count)
+                        (void) other[count / 2];    // other has a cursor
+                    list += other;
+                    CHECK(other.IsEmpty());
+                    break;
+                }
+                case 1: { // descending, then merge a sorted list of larger values
+                    list.Sort(std::greater<int>());
+                    std::sort(model.begin(), model.end(), std::greater<int>());
+                    CHECK(IsEqual(list, model, false, rng));
+                    list.Sort();
+                    std::sort(model.begin(), model.end());
+                    List<int> other;
+                    MakeSorted(other, model, int(rng.Bounded(100)));
+                    list.Merge(std::move(other));
+                    break;
+                }
+                case 2: {
+                    int modulus = 7 + int(rng.Bounded(20));
+                    int32_t removed = list.Filter([modulus](int& value) { return value % modulus == 0; });
+                    int32_t expected = int32_t(std::erase_if(model, [modulus](int value) { return value % modulus == 0; }));
+                    CHECK(removed == expected);
+                    break;
+                }
+                case 3: // through an iterator
+                    list.Discard(std::next(list.begin(), i));
+                    model.erase(model.begin() + i);
+                    break;
+                default:
+                    if (rng.Bounded(20) == 0) {
+                        list.Clear();
+                        model.clear();
+                    }
+                    break;
+            }
+            break;
+    }
+}
+
+
+// A reference to the std::list kept across indexed accesses bypasses InvalidateIndex(); changes of
+// the list length through it are still detected.
+static void TestRetainedReference(RandomStream& rng) {
+    List<int> list;
+    Model model;
+    for (int i = 0; i < 3000; ++i) {
+        list.Append(i);
+        model.push_back(i);
+    }
+    std::list<int>& stdList = list.StdList();
+    CHECK(list[2000] == 2000);
+    CHECK(list[100] == 100);
+    stdList.push_front(-1);
+    model.insert(model.begin(), -1);
+    CHECK(IsEqual(list, model, true, rng));
+    stdList.erase(std::next(stdList.begin(), 1500));
+    model.erase(model.begin() + 1500);
+    CHECK(IsEqual(list, model, true, rng));
+}
+
+// =================================================================================================
+
+int main(int argc, char** argv) {
+    int operations = (argc > 1) ? atoi(argv[1]) : 100000;
+    uint64_t seed = (argc > 2) ? uint64_t(atoll(argv[2])) : 1;
+    RandomStream rng{ seed };
+    TestRetainedReference(rng);
+    List<int> list;
+    Model model;
+    for (int n = 0; (n < operations) and not failures; ++n) {
+        Mutate(list, model, rng);
+        if (not IsEqual(list, model, n % 1000 == 0, rng)) {
+            ++failures;
+            fprintf(stderr, "List: index mismatch after operation %d (seed %llu)\n", n, (unsigned long long) seed);
+        }
+    }
+    if (failures)
+        fprintf(stderr, "List: %d checks failed\n", failures);
+    else
+        printf("List: all checks passed (%d operations, seed %llu)\n", operations, (unsigned long long) seed);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,22 @@
+
+#include <cstdio>
+#include <cstdlib>
+#include "matrixbenchmark.h"
+
+// =================================================================================================
+// MatrixKernels check and benchmark (make bench): checks every supported level against the double
+// precision reference, then measures them.
+// usage: matrixbench [points per batch] [seconds per kernel and level]
+
+int main(int argc, char** argv) {
+    size_t count = (argc > 1) ? size_t(atol(argv[1])) : 4096;
+    float duration = (argc > 2) ? float(atof(argv[2])) : 0.25f;
+    int failures = MatrixBenchmark::Check();
+    if (failures) {
+        fprintf(stderr, "MatrixKernels: %d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("MatrixKernels: all checks passed\n");
+    MatrixBenchmark::Print(MatrixBenchmark::Run(count, duration));
+    return EXIT_SUCCESS;
+}
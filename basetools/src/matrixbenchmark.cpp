@@ -0,0 +1,423 @@
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <algorithm>
+#include "matrixbenchmark.h"
+
+// =================================================================================================
+// Fixed seed inputs, so failures can be reproduced.
+
+class Generator {
+private:
+    std::mt19937    m_engine;
+
+public:
+    Generator(uint32_t seed) noexcept
+        : m_engine(seed)
+    { }
+
+    // [0, scale)
+    inline float Float(float scale = 1.0f) noexcept {
+        return std::uniform_real_distribution<float>(0.0f, scale)(m_engine);
+    }
+};
+
+// =================================================================================================
+// Double precision reference. Matrices are column major like the kernels' ones: element (row r,
+// column c) of m is m[4 * c + r].
+
+struct ReferenceMatrix {
+    double m[16];
+
+    inline double& operator()(int r, int c) noexcept { return m[4 * c + r]; }
+    inline double operator()(int r, int c) const noexcept { return m[4 * c + r]; }
+};
+
+
+static ReferenceMatrix ToReference(const float* m) noexcept {
+    ReferenceMatrix r;
+    for (int i = 0; i < 16; ++i)
+        r.m[i] = double(m[i]);
+    return r;
+}
+
+
+static void FromReference(const ReferenceMatrix& r, float* m) noexcept {
+    for (int i = 0; i < 16; ++i)
+        m[i] = float(r.m[i]);
+}
+
+
+static ReferenceMatrix Multiply(const ReferenceMatrix& a, const ReferenceMatrix& b) noexcept {
+    ReferenceMatrix p;
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 4; ++c) {
+            double s = 0.0;
+            for (int k = 0; k < 4; ++k)
+                s += a(r, k) * b(k, c);
+            p(r, c) = s;
+        }
+    return p;
+}
+
+
+// Gauss-Jordan elimination with partial pivoting; false if m is (numerically) singular
+static bool Inverse(const ReferenceMatrix& m, ReferenceMatrix& inverse) noexcept {
+    double a[4][8];
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 4; ++c) {
+            a[r][c] = m(r, c);
+            a[r][4 + c] = (r == c) ? 1.0 : 0.0;
+        }
+    for (int c = 0; c < 4; ++c) {
+        int pivot = c;
+        for (int r = c + 1; r < 4; ++r)
+            if (std::fabs(a[r][c]) > std::fabs(a[pivot][c]))
+                pivot = r;
+        if (std::fabs(a[pivot][c]) < 1e-12)
+            return false;
+        std::swap(a[c], a[pivot]);
+        double scale = 1.0 / a[c][c];
+        for (int k = 0; k < 8; ++k)
+            a[c][k] *= scale;
+        for (int r = 0; r < 4; ++r)
+            if ((r != c) and (a[r][c] != 0.0)) {
+                double f = a[r][c];
+                for (int k = 0; k < 8; ++k)
+                    a[r][k] -= f * a[c][k];
+            }
+    }
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 4; ++c)
+            inverse(r, c) = a[r][4 + c];
+    return true;
+}
+
+
+// n = inverse transpose of the upper 3x3 part of m, row major; false if it is singular
+static bool NormalMatrix(const float* m, double n[3][3]) noexcept {
+    ReferenceMatrix a = ToReference(m);
+    for (int i = 0; i < 3; ++i) {
+        a(3, i) = a(i, 3) = 0.0;
+    }
+    a(3, 3) = 1.0;
+    ReferenceMatrix inverse;
+    if (not Inverse(a, inverse))
+        return false;
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 3; ++c)
+            n[r][c] = inverse(c, r);
+    return true;
+}
+
+
+static ReferenceMatrix Rotation(double x, double y, double z, double degrees) noexcept {
+    double l = std::sqrt(x * x + y * y + z * z);
+    x /= l;
+    y /= l;
+    z /= l;
+    double a = degrees * 3.14159265358979323846 / 180.0;
+    double s = std::sin(a), c = std::cos(a), t = 1.0 - c;
+    ReferenceMatrix r{};
+    r(0, 0) = t * x * x + c;     r(0, 1) = t * x * y - s * z; r(0, 2) = t * x * z + s * y;
+    r(1, 0) = t * x * y + s * z; r(1, 1) = t * y * y + c;     r(1, 2) = t * y * z - s * x;
+    r(2, 0) = t * x * z - s * y; r(2, 1) = t * y * z + s * x; r(2, 2) = t * z * z + c;
+    r(3, 3) = 1.0;
+    return r;
+}
+
+
+static ReferenceMatrix Scale(double x, double y, double z) noexcept {
+    ReferenceMatrix s{};
+    s(0, 0) = x;
+    s(1, 1) = y;
+    s(2, 2) = z;
+    s(3, 3) = 1.0;
+    return s;
+}
+
+
+static ReferenceMatrix Translation(double x, double y, double z) noexcept {
+    ReferenceMatrix t = Scale(1.0, 1.0, 1.0);
+    t(0, 3) = x;
+    t(1, 3) = y;
+    t(2, 3) = z;
+    return t;
+}
+
+
+static ReferenceMatrix RandomAffine(Generator& generator) noexcept {
+    ReferenceMatrix m = Scale(1.0, 1.0, 1.0);
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c)
+            m(r, c) = double(generator.Float(4.0f) - 2.0f);
+        m(r, 3) = double(generator.Float(20.0f) - 10.0f);
+    }
+    return m;
+}
+
+
+static double Determinant3x3(const ReferenceMatrix& a) noexcept {
+    return a(0, 0) * (a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1))
+         - a(0, 1) * (a(1, 0) * a(2, 2) - a(1, 2) * a(2, 0))
+         + a(0, 2) * (a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0));
+}
+
+// =================================================================================================
+
+static constexpr size_t checkCount = 37;    // leaves a remainder for the 4 and 8 wide loops
+
+
+class KernelCheck {
+private:
+    FILE*   m_stream;
+    int     m_failures{ 0 };
+
+public:
+    explicit KernelCheck(FILE* stream) noexcept
+        : m_stream(stream)
+    { }
+
+    inline int Failures(void) const noexcept {
+        return m_failures;
+    }
+
+    void Expect(bool condition, const char* what, const char* matrix, double error) noexcept {
+        if (condition)
+            return;
+        ++m_failures;
+        if (m_stream)
+            fprintf(m_stream, "MatrixKernels (%s): %s failed for %s (error %g)\n",
+                    MatrixKernels::LevelName(MatrixKernels::ActiveLevel()), what, matrix, error);
+    }
+
+    void Points(const char* name, const float* m, const float* src) noexcept {
+        ReferenceMatrix a = ToReference(m);
+        float dst[3 * checkCount], inPlace[3 * checkCount];
+        std::memcpy(inPlace, src, sizeof(inPlace));
+        MatrixKernels::TransformPoints(m, src, dst, checkCount);
+        MatrixKernels::TransformPoints(m, inPlace, inPlace, checkCount);
+        double error = 0.0, inPlaceError = 0.0;
+        for (size_t i = 0; i < checkCount; ++i) {
+            const float* s = src + 3 * i;
+            for (int r = 0; r < 3; ++r) {
+                double p = a(r, 0) * s[0] + a(r, 1) * s[1] + a(r, 2) * s[2] + a(r, 3);
+                // rounding errors scale with the terms, not with their (possibly cancelling) sum
+                double magnitude = std::fabs(a(r, 0) * s[0]) + std::fabs(a(r, 1) * s[1]) + std::fabs(a(r, 2) * s[2]) + std::fabs(a(r, 3));
+                double tolerance = 1e-6 * std::max(1.0, magnitude);
+                error = std::max(error, std::fabs(dst[3 * i + r] - p) / tolerance);
+                inPlaceError = std::max(inPlaceError, std::fabs(inPlace[3 * i + r] - p) / tolerance);
+            }
+        }
+        Expect(error <= 1.0, "TransformPoints", name, error);
+        Expect(inPlaceError <= 1.0, "TransformPoints in place", name, inPlaceError);
+    }
+
+    void Normals(const char* name, const float* m, const float* src) noexcept {
+        double n[3][3];
+        if (not NormalMatrix(m, n)) {
+            Expect(false, "NormalMatrix", name, 0.0);
+            return;
+        }
+        for (bool normalize : { true, false }) {
+            float dst[3 * checkCount], inPlace[3 * checkCount];
+            std::memcpy(inPlace, src, sizeof(inPlace));
+            MatrixKernels::TransformNormals(m, src, dst, checkCount, normalize);
+            MatrixKernels::TransformNormals(m, inPlace, inPlace, checkCount, normalize);
+            double error = 0.0, inPlaceError = 0.0;
+            for (size_t i = 0; i < checkCount; ++i) {
+                const float* s = src + 3 * i;
+                double t[3];
+                for (int r = 0; r < 3; ++r)
+                    t[r] = n[r][0] * s[0] + n[r][1] * s[1] + n[r][2] * s[2];
+                double l = normalize ? std::sqrt(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]) : 1.0;
+                for (int r = 0; r < 3; ++r) {
+                    double e = t[r] / l;
+                    double tolerance = 1e-3 * std::max(1.0, std::fabs(e));
+                    // also catches NaNs
+                    double d = std::isfinite(dst[3 * i + r]) ? std::fabs(dst[3 * i + r] - e) : HUGE_VAL;
+                    double dInPlace = std::isfinite(inPlace[3 * i + r]) ? std::fabs(inPlace[3 * i + r] - e) : HUGE_VAL;
+                    error = std::max(error, d / tolerance);
+                    inPlaceError = std::max(inPlaceError, dInPlace / tolerance);
+                }
+            }
+            Expect(error <= 1.0, normalize ? "TransformNormals" : "TransformNormals (not normalized)", name, error);
+            Expect(inPlaceError <= 1.0, normalize ? "TransformNormals in place" : "TransformNormals in place (not normalized)", name, inPlaceError);
+        }
+    }
+
+    void Inverse(const char* name, const float* m) noexcept {
+        ReferenceMatrix expected;
+        bool isRegular = ::Inverse(ToReference(m), expected);
+        float inverse[16];
+        bool isInvertible = MatrixKernels::Inverse(inverse, m);
+        Expect(isInvertible == isRegular, "Inverse (singularity)", name, 0.0);
+        if (not isRegular)
+            return;
+        double error = 0.0;
+        for (int i = 0; i < 16; ++i)
+            error = std::max(error, std::fabs(inverse[i] - expected.m[i]) / (1e-3 * std::max(1.0, std::fabs(expected.m[i]))));
+        Expect(error <= 1.0, "Inverse", name, error);
+    }
+
+    void Multiply(const char* name, const float* a, const float* b) noexcept {
+        ReferenceMatrix expected = ::Multiply(ToReference(a), ToReference(b));
+        float product[16], inPlace[16];
+        MatrixKernels::Multiply(product, a, b);
+        std::memcpy(inPlace, a, sizeof(inPlace));
+        MatrixKernels::Multiply(inPlace, inPlace, b);
+        double error = 0.0;
+        for (int i = 0; i < 16; ++i) {
+            double tolerance = 1e-5 * std::max(1.0, std::fabs(expected.m[i]));
+            error = std::max({ error, std::fabs(product[i] - expected.m[i]) / tolerance, std::fabs(inPlace[i] - expected.m[i]) / tolerance });
+        }
+        Expect(error <= 1.0, "Multiply", name, error);
+    }
+};
+
+
+int MatrixBenchmark::Check(FILE* stream) {
+    Generator generator(0x4D4B);
+    float points[3 * checkCount], normals[3 * checkCount];
+    for (size_t i = 0; i < 3 * checkCount; ++i)
+        points[i] = generator.Float(200.0f) - 100.0f;
+    for (size_t i = 0; i < checkCount; ++i) {
+        float* n = normals + 3 * i;
+        do {
+            for (int j = 0; j < 3; ++j)
+                n[j] = generator.Float(2.0f) - 1.0f;
+        } while (n[0] * n[0] + n[1] * n[1] + n[2] * n[2] < 0.01f);
+        float l = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        for (int j = 0; j < 3; ++j)
+            n[j] /= l;
+    }
+
+    struct NamedMatrix {
+        const char*     name;
+        ReferenceMatrix m;
+    };
+    const NamedMatrix matrices[] = {
+        { "identity", Scale(1.0, 1.0, 1.0) },
+        { "45 degree z rotation", Rotation(0.0, 0.0, 1.0, 45.0) },
+        { "60 degree z rotation", Rotation(0.0, 0.0, 1.0, 60.0) },
+        { "30 degree x rotation", Rotation(1.0, 0.0, 0.0, 30.0) },
+        { "rotation about (1, 2, 3)", Multiply(Translation(5.0, -3.0, 2.0), Rotation(1.0, 2.0, 3.0, 127.0)) },
+        { "non-uniform scale", Scale(2.0, 0.5, 3.0) },
+        { "rotation * non-uniform scale", Multiply(Rotation(0.0, 1.0, 1.0, 70.0), Scale(0.25, 4.0, 1.5)) },
+        { "non-uniform scale * rotation", Multiply(Scale(-1.0, 3.0, 0.5), Rotation(2.0, -1.0, 0.5, -40.0)) },
+    };
+
+    MatrixKernels::Level active = MatrixKernels::ActiveLevel();
+    KernelCheck check(stream);
+    for (int l = 0; l <= int(MatrixKernels::SupportedLevel()); ++l) {
+        if (MatrixKernels::SetLevel(MatrixKernels::Level(l)) != MatrixKernels::Level(l))
+            continue;
+        float m[16], b[16];
+        for (const NamedMatrix& nm : matrices) {
+            FromReference(nm.m, m);
+            check.Points(nm.name, m, points);
+            check.Normals(nm.name, m, normals);
+            check.Inverse(nm.name, m);
+        }
+        Generator affine(0xAFF1);
+        for (int i = 0; i < 200; ++i) {
+            ReferenceMatrix a = RandomAffine(affine);
+            FromReference(a, m);
+            FromReference(RandomAffine(affine), b);
+            check.Multiply("random affine", m, b);
+            check.Points("random affine", m, points);
+            // skip nearly singular matrices: their float inverses are too imprecise to compare
+            if (std::fabs(Determinant3x3(a)) > 0.25) {
+                check.Normals("random affine", m, normals);
+                check.Inverse("random affine", m);
+            }
+        }
+        // flattening to the xy plane: normals become (0, 0, +-1) instead of non-finite values
+        FromReference(Multiply(Rotation(0.0, 0.0, 1.0, 30.0), Scale(2.0, 1.0, 0.0)), m);
+        float flat[3 * checkCount];
+        MatrixKernels::TransformNormals(m, normals, flat, checkCount);
+        double error = 0.0;
+        for (size_t i = 0; i < checkCount; ++i) {
+            const float* f = flat + 3 * i;
+            double e = (normals[3 * i + 2] == 0.0f) ? 0.0 : 1.0;
+            double d = std::fabs(f[0]) + std::fabs(f[1]) + std::fabs(std::fabs(f[2]) - e);
+            error = std::max(error, std::isfinite(d) ? d : HUGE_VAL);
+        }
+        check.Expect(error <= 1e-5, "TransformNormals", "singular matrix", error);
+        check.Inverse("singular matrix", m);
+    }
+    MatrixKernels::SetLevel(active);
+    return check.Failures();
+}
+
+// =================================================================================================
+
+static inline int64_t Nanos(void) noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+template <typename KERNEL_T>
+static double Throughput(KERNEL_T&& kernel, size_t itemsPerCall, int64_t duration) noexcept {
+    kernel();   // warm up caches
+    uint64_t items = 0;
+    int64_t start = Nanos();
+    int64_t elapsed;
+    do {
+        for (int i = 0; i < 16; ++i)
+            kernel();
+        items += 16 * itemsPerCall;
+        elapsed = Nanos() - start;
+    } while (elapsed < duration);
+    return double(items) * 1e9 / double(elapsed);
+}
+
+
+std::vector<MatrixBenchmark::Result> MatrixBenchmark::Run(size_t count, float duration) {
+    count = std::max(count, size_t(1));
+    int64_t nanos = int64_t(double(std::max(duration, 0.001f)) * 1e9);
+    Generator generator(0xBE4C);
+    std::vector<float> src(3 * count), dst(3 * count);
+    for (float& v : src)
+        v = generator.Float(2.0f);
+    float m[16];
+    FromReference(Multiply(Translation(1.0, 2.0, 3.0), Multiply(Rotation(1.0, 2.0, 3.0, 40.0), Scale(2.0, 0.5, 1.5))), m);
+    static constexpr size_t matrixCount = 256;
+    std::vector<float> matrices(16 * matrixCount), products(16 * matrixCount);
+    for (float& v : matrices)
+        v = generator.Float();
+
+    std::vector<Result> results;
+    MatrixKernels::Level active = MatrixKernels::ActiveLevel();
+    for (int l = 0; l <= int(MatrixKernels::SupportedLevel()); ++l) {
+        if (MatrixKernels::SetLevel(MatrixKernels::Level(l)) != MatrixKernels::Level(l))
+            continue;
+        Result result{ MatrixKernels::Level(l), 0.0, 0.0, 0.0 };
+        result.pointsPerSecond = Throughput([&]() { MatrixKernels::TransformPoints(m, src.data(), dst.data(), count); }, count, nanos);
+        result.normalsPerSecond = Throughput([&]() { MatrixKernels::TransformNormals(m, src.data(), dst.data(), count); }, count, nanos);
+        result.multipliesPerSecond = Throughput([&]() {
+            for (size_t i = 0; i < matrixCount; ++i)
+                MatrixKernels::Multiply(products.data() + 16 * i, matrices.data() + 16 * i, m);
+            }, matrixCount, nanos);
+        results.push_back(result);
+    }
+    MatrixKernels::SetLevel(active);
+    return results;
+}
+
+
+void MatrixBenchmark::Print(const std::vector<Result>& results, FILE* stream) {
+    if (results.empty())
+        return;
+    const Result& base = results.front();
+    for (const Result& r : results)
+        fprintf(stream, "%-7s %7.1f M points/s (%.2fx), %7.1f M normals/s (%.2fx), %7.1f M multiplies/s (%.2fx)\n",
+                MatrixKernels::LevelName(r.level),
+                r.pointsPerSecond * 1e-6, r.pointsPerSecond / base.pointsPerSecond,
+                r.normalsPerSecond * 1e-6, r.normalsPerSecond / base.normalsPerSecond,
+                r.multipliesPerSecond * 1e-6, r.multipliesPerSecond / base.multipliesPerSecond);
+}
+
+// =================================================================================================
@@ -0,0 +1,491 @@
+
+#include <cmath>
+#include <cstring>
+#include "matrixkernels.h"
+
+#if SIMD_X86
+#   include <immintrin.h>
+#endif
+
+std::atomic<const MatrixKernels::KernelTable*> MatrixKernels::m_kernels{ nullptr };
+
+// =================================================================================================
+// Scalar kernels
+
+static void MultiplyScalar(float* r, const float* a, const float* b) noexcept {
+    float t[16];
+    for (int j = 0; j < 4; ++j) {
+        const float* bj = b + 4 * j;
+        for (int i = 0; i < 4; ++i)
+            t[4 * j + i] = a[i] * bj[0] + a[4 + i] * bj[1] + a[8 + i] * bj[2] + a[12 + i] * bj[3];
+    }
+    memcpy(r, t, sizeof(t));
+}
+
+
+static void TransposeScalar(float* r, const float* m) noexcept {
+    float t[16];
+    for (int j = 0; j < 4; ++j)
+        for (int i = 0; i < 4; ++i)
+            t[4 * i + j] = m[4 * j + i];
+    memcpy(r, t, sizeof(t));
+}
+
+
+// cofactor expansion with 2x2 sub determinants, as in glm::inverse
+static bool InverseScalar(float* r, const float* m) noexcept {
+    auto M = [m](int c, int row) { return m[4 * c + row]; };
+    float c00 = M(2, 2) * M(3, 3) - M(3, 2) * M(2, 3);
+    float c02 = M(1, 2) * M(3, 3) - M(3, 2) * M(1, 3);
+    float c03 = M(1, 2) * M(2, 3) - M(2, 2) * M(1, 3);
+    float c04 = M(2, 1) * M(3, 3) - M(3, 1) * M(2, 3);
+    float c06 = M(1, 1) * M(3, 3) - M(3, 1) * M(1, 3);
+    float c07 = M(1, 1) * M(2, 3) - M(2, 1) * M(1, 3);
+    float c08 = M(2, 1) * M(3, 2) - M(3, 1) * M(2, 2);
+    float c10 = M(1, 1) * M(3, 2) - M(3, 1) * M(1, 2);
+    float c11 = M(1, 1) * M(2, 2) - M(2, 1) * M(1, 2);
+    float c12 = M(2, 0) * M(3, 3) - M(3, 0) * M(2, 3);
+    float c14 = M(1, 0) * M(3, 3) - M(3, 0) * M(1, 3);
+    float c15 = M(1, 0) * M(2, 3) - M(2, 0) * M(1, 3);
+    float c16 = M(2, 0) * M(3, 2) - M(3, 0) * M(2, 2);
+    float c18 = M(1, 0) * M(3, 2) - M(3, 0) * M(1, 2);
+    float c19 = M(1, 0) * M(2, 2) - M(2, 0) * M(1, 2);
+    float c20 = M(2, 0) * M(3, 1) - M(3, 0) * M(2, 1);
+    float c22 = M(1, 0) * M(3, 1) - M(3, 0) * M(1, 1);
+    float c23 = M(1, 0) * M(2, 1) - M(2, 0) * M(1, 1);
+
+    const float fac[6][4] = {
+        { c00, c00, c02, c03 }, { c04, c04, c06, c07 }, { c08, c08, c10, c11 },
+        { c12, c12, c14, c15 }, { c16, c16, c18, c19 }, { c20, c20, c22, c23 }
+    };
+    float vec[4][4];
+    for (int x = 0; x < 4; ++x) {
+        vec[x][0] = M(1, x);
+        vec[x][1] = vec[x][2] = vec[x][3] = M(0, x);
+    }
+    // column c = sign * (vecA * facA - vecB * facB + vecC * facC)
+    static const int terms[4][6] = {
+        { 1, 0, 2, 1, 3, 2 }, { 0, 0, 2, 3, 3, 4 }, { 0, 1, 1, 3, 3, 5 }, { 0, 2, 1, 4, 2, 5 }
+    };
+    float t[16];
+    for (int c = 0; c < 4; ++c) {
+        const int* k = terms[c];
+        for (int i = 0; i < 4; ++i) {
+            float sign = ((c + i) & 1) ? -1.0f : 1.0f;
+            t[4 * c + i] = sign * (vec[k[0]][i] * fac[k[1]][i] - vec[k[2]][i] * fac[k[3]][i] + vec[k[4]][i] * fac[k[5]][i]);
+        }
+    }
+    float det = m[0] * t[0] + m[1] * t[4] + m[2] * t[8] + m[3] * t[12];
+    float scale = 1.0f / det;
+    for (int i = 0; i < 16; ++i)
+        r[i] = t[i] * scale;
+    return det != 0.0f;
+}
+
+
+static inline void TransformOneScalar(const float* m, const float* s, float* d, bool normalize) noexcept {
+    float x = m[0] * s[0] + m[3] * s[1] + m[6] * s[2] + m[9];
+    float y = m[1] * s[0] + m[4] * s[1] + m[7] * s[2] + m[10];
+    float z = m[2] * s[0] + m[5] * s[1] + m[8] * s[2] + m[11];
+    if (normalize) {
+        float l = x * x + y * y + z * z;
+        if (l != 0.0f) {
+            l = sqrtf(l);
+            x /= l;
+            y /= l;
+            z /= l;
+        }
+    }
+    d[0] = x;
+    d[1] = y;
+    d[2] = z;
+}
+
+
+static void TransformScalar(const float* m, const float* src, float* dst, size_t count, bool normalize) noexcept {
+    for (size_t i = 0; i < count; ++i)
+        TransformOneScalar(m, src + 3 * i, dst + 3 * i, normalize);
+}
+
+
+// same arithmetic as Vector3f::Length() and division by it, so results match the per vector code
+static void NormalizeScalar(const float* src, float* dst, float* lengths, size_t count, float tolerance) noexcept {
+    for (size_t i = 0; i < count; ++i, src += 3, dst += 3) {
+        float x = src[0], y = src[1], z = src[2];
+        float l = sqrtf(x * x + y * y + z * z);
+        lengths[i] = l;
+        if (l > tolerance) {
+            dst[0] = x / l;
+            dst[1] = y / l;
+            dst[2] = z / l;
+        }
+        else
+            dst[0] = dst[1] = dst[2] = 0.0f;
+    }
+}
+
+
+static const MatrixKernels::KernelTable scalarKernels = {
+    MultiplyScalar, InverseScalar, TransposeScalar, TransformScalar, NormalizeScalar, MatrixKernels::Level::Scalar
+};
+
+#if SIMD_X86
+
+// =================================================================================================
+// SSE4.1 kernels
+
+SIMD_TARGET_SSE4
+static void MultiplySSE4(float* r, const float* a, const float* b) noexcept {
+    __m128 a0 = _mm_loadu_ps(a);
+    __m128 a1 = _mm_loadu_ps(a + 4);
+    __m128 a2 = _mm_loadu_ps(a + 8);
+    __m128 a3 = _mm_loadu_ps(a + 12);
+    __m128 bc[4] = { _mm_loadu_ps(b), _mm_loadu_ps(b + 4), _mm_loadu_ps(b + 8), _mm_loadu_ps(b + 12) };
+    for (int j = 0; j < 4; ++j) {
+        __m128 bj = bc[j];
+        __m128 c = _mm_mul_ps(a0, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(0, 0, 0, 0)));
+        c = _mm_add_ps(c, _mm_mul_ps(a1, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(1, 1, 1, 1))));
+        c = _mm_add_ps(c, _mm_mul_ps(a2, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(2, 2, 2, 2))));
+        c = _mm_add_ps(c, _mm_mul_ps(a3, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(3, 3, 3, 3))));
+        _mm_storeu_ps(r + 4 * j, c);
+    }
+}
+
+
+SIMD_TARGET_SSE4
+static void TransposeSSE4(float* r, const float* m) noexcept {
+    __m128 c0 = _mm_loadu_ps(m);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_storeu_ps(r, c0);
+    _mm_storeu_ps(r + 4, c1);
+    _mm_storeu_ps(r + 8, c2);
+    _mm_storeu_ps(r + 12, c3);
+}
+
+
+// (c2[x], c2[x], c1[x], c1[x]) and (c3[x], c3[x], c3[x], c2[x]): the factors of the 2x2 sub determinants
+template <int X>
+SIMD_TARGET_SSE4
+static inline void SubDetOperands(__m128 c1, __m128 c2, __m128 c3, __m128& a, __m128& b) noexcept {
+    a = _mm_shuffle_ps(c2, c1, _MM_SHUFFLE(X, X, X, X));
+    __m128 t = _mm_shuffle_ps(c3, c2, _MM_SHUFFLE(X, X, X, X));
+    b = _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 0, 0, 0));
+}
+
+
+// (c1[x], c0[x], c0[x], c0[x])
+template <int X>
+SIMD_TARGET_SSE4
+static inline __m128 CofactorOperand(__m128 c0, __m128 c1) noexcept {
+    __m128 t = _mm_shuffle_ps(c1, c0, _MM_SHUFFLE(X, X, X, X));
+    return _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 0));
+}
+
+
+// 2x2 sub determinants a_p * b_q - b_p * a_q
+SIMD_TARGET_SSE4
+static inline __m128 Fac(__m128 ap, __m128 bp, __m128 aq, __m128 bq) noexcept {
+    return _mm_sub_ps(_mm_mul_ps(ap, bq), _mm_mul_ps(bp, aq));
+}
+
+
+// vectorized form of InverseScalar()
+SIMD_TARGET_SSE4
+static bool InverseSSE4(float* r, const float* m) noexcept {
+    __m128 c0 = _mm_loadu_ps(m);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+
+    __m128 a0, b0, a1, b1, a2, b2, a3, b3;
+    SubDetOperands<0>(c1, c2, c3, a0, b0);
+    SubDetOperands<1>(c1, c2, c3, a1, b1);
+    SubDetOperands<2>(c1, c2, c3, a2, b2);
+    SubDetOperands<3>(c1, c2, c3, a3, b3);
+    __m128 fac0 = Fac(a2, b2, a3, b3);
+    __m128 fac1 = Fac(a1, b1, a3, b3);
+    __m128 fac2 = Fac(a1, b1, a2, b2);
+    __m128 fac3 = Fac(a0, b0, a3, b3);
+    __m128 fac4 = Fac(a0, b0, a2, b2);
+    __m128 fac5 = Fac(a0, b0, a1, b1);
+
+    __m128 v0 = CofactorOperand<0>(c0, c1);
+    __m128 v1 = CofactorOperand<1>(c0, c1);
+    __m128 v2 = CofactorOperand<2>(c0, c1);
+    __m128 v3 = CofactorOperand<3>(c0, c1);
+
+    const __m128 signA = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+    const __m128 signB = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+    __m128 i0 = _mm_mul_ps(signA, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(v1, fac0), _mm_mul_ps(v2, fac1)), _mm_mul_ps(v3, fac2)));
+    __m128 i1 = _mm_mul_ps(signB, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(v0, fac0), _mm_mul_ps(v2, fac3)), _mm_mul_ps(v3, fac4)));
+    __m128 i2 = _mm_mul_ps(signA, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(v0, fac1), _mm_mul_ps(v1, fac3)), _mm_mul_ps(v3, fac5)));
+    __m128 i3 = _mm_mul_ps(signB, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(v0, fac2), _mm_mul_ps(v1, fac4)), _mm_mul_ps(v2, fac5)));
+
+    // determinant: first column of m dotted with the first row of the adjugate
+    __m128 row0 = _mm_shuffle_ps(_mm_shuffle_ps(i0, i1, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(i2, i3, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 dot = _mm_mul_ps(c0, row0);
+    dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(2, 3, 0, 1)));
+    dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(1, 0, 3, 2)));
+    __m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), dot);
+    _mm_storeu_ps(r, _mm_mul_ps(i0, scale));
+    _mm_storeu_ps(r + 4, _mm_mul_ps(i1, scale));
+    _mm_storeu_ps(r + 8, _mm_mul_ps(i2, scale));
+    _mm_storeu_ps(r + 12, _mm_mul_ps(i3, scale));
+    return _mm_cvtss_f32(dot) != 0.0f;
+}
+
+
+// Packed xyz triples of 4 points (3 registers) to x, y, z registers and back
+SIMD_TARGET_SSE4
+static inline void Deinterleave(__m128 a, __m128 b, __m128 c, __m128& x, __m128& y, __m128& z) noexcept {
+    __m128 xy = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+    __m128 yz = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+
+SIMD_TARGET_SSE4
+static inline void Interleave(__m128 x, __m128 y, __m128 z, __m128& a, __m128& b, __m128& c) noexcept {
+    __m128 xy = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 yz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+    __m128 zx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+    a = _mm_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+    b = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    c = _mm_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+
+SIMD_TARGET_SSE4
+static void TransformSSE4(const float* m, const float* src, float* dst, size_t count, bool normalize) noexcept {
+    __m128 k[12];
+    for (int i = 0; i < 12; ++i)
+        k[i] = _mm_set1_ps(m[i]);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    size_t n = count & ~size_t(3);
+    for (size_t i = 0; i < n; i += 4, src += 12, dst += 12) {
+        __m128 x, y, z;
+        Deinterleave(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+        __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(k[0], x), _mm_mul_ps(k[3], y)), _mm_add_ps(_mm_mul_ps(k[6], z), k[9]));
+        __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(k[1], x), _mm_mul_ps(k[4], y)), _mm_add_ps(_mm_mul_ps(k[7], z), k[10]));
+        __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(k[2], x), _mm_mul_ps(k[5], y)), _mm_add_ps(_mm_mul_ps(k[8], z), k[11]));
+        if (normalize) {
+            __m128 l = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), _mm_mul_ps(rz, rz));
+            // divide (instead of multiplying with the reciprocal) to match the scalar kernel
+            l = _mm_blendv_ps(one, _mm_sqrt_ps(l), _mm_cmpneq_ps(l, zero));
+            rx = _mm_div_ps(rx, l);
+            ry = _mm_div_ps(ry, l);
+            rz = _mm_div_ps(rz, l);
+        }
+        __m128 a, b, c;
+        Interleave(rx, ry, rz, a, b, c);
+        _mm_storeu_ps(dst, a);
+        _mm_storeu_ps(dst + 4, b);
+        _mm_storeu_ps(dst + 8, c);
+    }
+    TransformScalar(m, src, dst, count - n, normalize);
+}
+
+
+SIMD_TARGET_SSE4
+static void NormalizeSSE4(const float* src, float* dst, float* lengths, size_t count, float tolerance) noexcept {
+    const __m128 t = _mm_set1_ps(tolerance);
+    const __m128 one = _mm_set1_ps(1.0f);
+    size_t n = count & ~size_t(3);
+    for (size_t i = 0; i < n; i += 4, src += 12, dst += 12) {
+        __m128 x, y, z;
+        Deinterleave(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+        __m128 l = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+        _mm_storeu_ps(lengths + i, l);
+        __m128 valid = _mm_cmpgt_ps(l, t);
+        __m128 d = _mm_blendv_ps(one, l, valid);
+        __m128 a, b, c;
+        Interleave(_mm_and_ps(_mm_div_ps(x, d), valid), _mm_and_ps(_mm_div_ps(y, d), valid), _mm_and_ps(_mm_div_ps(z, d), valid), a, b, c);
+        _mm_storeu_ps(dst, a);
+        _mm_storeu_ps(dst + 4, b);
+        _mm_storeu_ps(dst + 8, c);
+    }
+    NormalizeScalar(src, dst, lengths + n, count - n, tolerance);
+}
+
+
+static const MatrixKernels::KernelTable sse4Kernels = {
+    MultiplySSE4, InverseSSE4, TransposeSSE4, TransformSSE4, NormalizeSSE4, MatrixKernels::Level::SSE4
+};
+
+// =================================================================================================
+// AVX2 kernels. Inverse and transpose don't profit from wider registers and use the SSE4 code.
+
+SIMD_TARGET_AVX2
+static void MultiplyAVX2(float* r, const float* a, const float* b) noexcept {
+    // each register holds two result columns; the a columns are duplicated into both halves
+    __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+    __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+    __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+    __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+    __m256 b01 = _mm256_loadu_ps(b);
+    __m256 b23 = _mm256_loadu_ps(b + 8);
+    __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+    __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+    r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), r01);
+    r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), r23);
+    r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xAA), r01);
+    r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xAA), r23);
+    r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xFF), r01);
+    r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xFF), r23);
+    _mm256_storeu_ps(r, r01);
+    _mm256_storeu_ps(r + 8, r23);
+}
+
+
+// 8 points per register set: the low register halves hold points 0 - 3, the high halves points 4 - 7,
+// so the 128 bit shuffles of Deinterleave()/Interleave() work unchanged on both halves.
+SIMD_TARGET_AVX2
+static inline void Load8(const float* src, __m256& x, __m256& y, __m256& z) noexcept {
+    __m256 p03 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src)), _mm_loadu_ps(src + 12), 1);
+    __m256 p14 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 4)), _mm_loadu_ps(src + 16), 1);
+    __m256 p25 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 8)), _mm_loadu_ps(src + 20), 1);
+    __m256 xy = _mm256_shuffle_ps(p14, p25, _MM_SHUFFLE(2, 1, 3, 2));
+    __m256 yz = _mm256_shuffle_ps(p03, p14, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm256_shuffle_ps(p03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm256_shuffle_ps(yz, p25, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+
+SIMD_TARGET_AVX2
+static inline void Store8(float* dst, __m256 x, __m256 y, __m256 z) noexcept {
+    __m256 xy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 yz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+    __m256 zx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+    __m256 p03 = _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 p14 = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    __m256 p25 = _mm256_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+    _mm_storeu_ps(dst, _mm256_castps256_ps128(p03));
+    _mm_storeu_ps(dst + 4, _mm256_castps256_ps128(p14));
+    _mm_storeu_ps(dst + 8, _mm256_castps256_ps128(p25));
+    _mm_storeu_ps(dst + 12, _mm256_extractf128_ps(p03, 1));
+    _mm_storeu_ps(dst + 16, _mm256_extractf128_ps(p14, 1));
+    _mm_storeu_ps(dst + 20, _mm256_extractf128_ps(p25, 1));
+}
+
+
+SIMD_TARGET_AVX2
+static void TransformAVX2(const float* m, const float* src, float* dst, size_t count, bool normalize) noexcept {
+    __m256 k[12];
+    for (int i = 0; i < 12; ++i)
+        k[i] = _mm256_set1_ps(m[i]);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    size_t n = count & ~size_t(7);
+    for (size_t i = 0; i < n; i += 8, src += 24, dst += 24) {
+        __m256 x, y, z;
+        Load8(src, x, y, z);
+        __m256 rx = _mm256_fmadd_ps(k[0], x, _mm256_fmadd_ps(k[3], y, _mm256_fmadd_ps(k[6], z, k[9])));
+        __m256 ry = _mm256_fmadd_ps(k[1], x, _mm256_fmadd_ps(k[4], y, _mm256_fmadd_ps(k[7], z, k[10])));
+        __m256 rz = _mm256_fmadd_ps(k[2], x, _mm256_fmadd_ps(k[5], y, _mm256_fmadd_ps(k[8], z, k[11])));
+        if (normalize) {
+            __m256 l = _mm256_fmadd_ps(rx, rx, _mm256_fmadd_ps(ry, ry, _mm256_mul_ps(rz, rz)));
+            l = _mm256_blendv_ps(one, _mm256_sqrt_ps(l), _mm256_cmp_ps(l, zero, _CMP_NEQ_UQ));
+            rx = _mm256_div_ps(rx, l);
+            ry = _mm256_div_ps(ry, l);
+            rz = _mm256_div_ps(rz, l);
+        }
+        Store8(dst, rx, ry, rz);
+    }
+    TransformSSE4(m, src, dst, count - n, normalize);
+}
+
+
+// no FMA here, so the lengths are rounded like the scalar ones
+SIMD_TARGET_AVX2
+static void NormalizeAVX2(const float* src, float* dst, float* lengths, size_t count, float tolerance) noexcept {
+    const __m256 t = _mm256_set1_ps(tolerance);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    size_t n = count & ~size_t(7);
+    for (size_t i = 0; i < n; i += 8, src += 24, dst += 24) {
+        __m256 x, y, z;
+        Load8(src, x, y, z);
+        __m256 l = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+        _mm256_storeu_ps(lengths + i, l);
+        __m256 valid = _mm256_cmp_ps(l, t, _CMP_GT_OQ);
+        __m256 d = _mm256_blendv_ps(one, l, valid);
+        Store8(dst, _mm256_and_ps(_mm256_div_ps(x, d), valid), _mm256_and_ps(_mm256_div_ps(y, d), valid), _mm256_and_ps(_mm256_div_ps(z, d), valid));
+    }
+    NormalizeSSE4(src, dst, lengths + n, count - n, tolerance);
+}
+
+
+static const MatrixKernels::KernelTable avx2Kernels = {
+    MultiplyAVX2, InverseSSE4, TransposeSSE4, TransformAVX2, NormalizeAVX2, MatrixKernels::Level::AVX2
+};
+
+#endif //SIMD_X86
+
+// =================================================================================================
+
+MatrixKernels::Level MatrixKernels::SetLevel(Level level) noexcept {
+    if (level > SupportedLevel())
+        level = SupportedLevel();
+    const KernelTable* kernels = &scalarKernels;
+#if SIMD_X86
+    if (level == Level::AVX2)
+        kernels = &avx2Kernels;
+    else if (level == Level::SSE4)
+        kernels = &sse4Kernels;
+#endif
+    m_kernels.store(kernels, std::memory_order_release);
+    return kernels->level;
+}
+
+
+const MatrixKernels::KernelTable& MatrixKernels::SelectKernels(void) noexcept {
+    SetLevel(Level::AVX2);
+    return *m_kernels.load(std::memory_order_acquire);
+}
+
+// =================================================================================================
+
+void MatrixKernels::TransformPoints(const float* m, const float* src, float* dst, size_t count) noexcept {
+    const float k[12] = { m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10], m[12], m[13], m[14] };
+    Kernels().transform(k, src, dst, count, false);
+}
+
+
+void MatrixKernels::TransformVectors(const float* m, const float* src, float* dst, size_t count) noexcept {
+    const float k[12] = { m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10], 0.0f, 0.0f, 0.0f };
+    Kernels().transform(k, src, dst, count, false);
+}
+
+
+void MatrixKernels::Normalize(const float* src, float* dst, float* lengths, size_t count, float tolerance) noexcept {
+    Kernels().normalize(src, dst, lengths, count, tolerance);
+}
+
+
+void MatrixKernels::TransformNormals(const float* m, const float* src, float* dst, size_t count, bool normalize) noexcept {
+    // inverse transpose of the upper 3x3 part: the cofactor matrix divided by the determinant
+    auto M = [m](int c, int r) { return m[4 * c + r]; };
+    float cof[9] = {
+        M(1, 1) * M(2, 2) - M(2, 1) * M(1, 2), M(2, 0) * M(1, 2) - M(1, 0) * M(2, 2), M(1, 0) * M(2, 1) - M(2, 0) * M(1, 1),
+        M(2, 1) * M(0, 2) - M(0, 1) * M(2, 2), M(0, 0) * M(2, 2) - M(2, 0) * M(0, 2), M(2, 0) * M(0, 1) - M(0, 0) * M(2, 1),
+        M(0, 1) * M(1, 2) - M(1, 1) * M(0, 2), M(1, 0) * M(0, 2) - M(0, 0) * M(1, 2), M(0, 0) * M(1, 1) - M(1, 0) * M(0, 1)
+    };
+    // cof[0..2] are the cofactors of the first column's elements
+    float det = M(0, 0) * cof[0] + M(0, 1) * cof[1] + M(0, 2) * cof[2];
+    // a singular matrix has no inverse; its cofactors still map normals to the normal of the plane it
+    // flattens the geometry into
+    float scale = (det != 0.0f) ? 1.0f / det : 1.0f;
+    float k[12];
+    for (int i = 0; i < 9; ++i)
+        k[i] = cof[i] * scale;
+    k[9] = k[10] = k[11] = 0.0f;
+    Kernels().transform(k, src, dst, count, normalize);
+}
+
+// =================================================================================================
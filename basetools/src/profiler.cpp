@@ -0,0 +1,280 @@
+
+#include <new>
+#include <algorithm>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "profiler.h"
+
+// =================================================================================================
+// Each recording thread owns a ring of events. The thread advances head after writing an event,
+// Collect() advances tail after copying events out, so the recording side never waits for a lock.
+// Rings are registered (under the lock) on a thread's first event and live until the process ends,
+// as do the profiler's state, so threads may still record during static destruction.
+
+class ProfilerState {
+public:
+    struct ThreadRing {
+        alignas(64) std::atomic<uint64_t>   head{ 0 };
+        uint64_t                            cachedTail{ 0 };    // recording thread's view of tail
+        alignas(64) std::atomic<uint64_t>   tail{ 0 };
+        uint32_t                            id;
+        std::string                         name;               // guarded by the lock
+        std::vector<Profiler::Event>        captured;           // guarded by the lock
+        Profiler::Event                     events[Profiler::ringCapacity];
+
+        explicit ThreadRing(uint32_t id) noexcept
+            : id(id)
+        { }
+    };
+
+    std::mutex                              lock;
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+    size_t                                  capturedCount{ 0 };
+    std::atomic<uint64_t>                   droppedCount{ 0 };
+    // time stamp calibration: ticks and wall clock when recording was enabled
+    uint64_t                                startTicks{ 0 };
+    std::chrono::steady_clock::time_point   startTime;
+    std::string                             exitTrace;
+
+    inline static thread_local ThreadRing* threadRing{ nullptr };
+    inline static thread_local char threadName[64]{};   // applied when the ring is registered
+
+    static ProfilerState& Instance(void) {
+        static ProfilerState* state = new ProfilerState();
+        return *state;
+    }
+
+    // the calling thread's ring; registers it on first use. nullptr if it can't be allocated.
+    ThreadRing* Ring(void) noexcept {
+        if (threadRing)
+            return threadRing;
+        try {
+            std::lock_guard<std::mutex> guard(lock);
+            rings.push_back(std::make_unique<ThreadRing>(uint32_t(rings.size() + 1)));
+            threadRing = rings.back().get();
+            threadRing->name = threadName;
+        }
+        catch (...) {
+            return nullptr;
+        }
+        return threadRing;
+    }
+
+    // moves the events of all rings into the capture. Requires the lock.
+    void Drain(bool discard) {
+        for (auto& ring : rings) {
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            if (not discard) {
+                uint64_t n = std::min(head - tail, uint64_t(Profiler::captureCapacity - capturedCount));
+                for (uint64_t i = tail; i < tail + n; ++i)
+                    ring->captured.push_back(ring->events[i & (Profiler::ringCapacity - 1)]);
+                capturedCount += size_t(n);
+                droppedCount.fetch_add(head - tail - n, std::memory_order_relaxed);
+            }
+            ring->tail.store(head, std::memory_order_release);
+        }
+    }
+
+    bool Write(const char* filename);
+};
+
+// =================================================================================================
+
+void Profiler::Enable(bool enable) {
+    ProfilerState& state = ProfilerState::Instance();
+    std::lock_guard<std::mutex> guard(state.lock);
+    if (not enable) {
+        m_isEnabled.store(false, std::memory_order_relaxed);
+        return;
+    }
+    state.Drain(true);
+    for (auto& ring : state.rings) {
+        ring->captured.clear();
+        ring->captured.shrink_to_fit();
+    }
+    state.capturedCount = 0;
+    state.droppedCount.store(0, std::memory_order_relaxed);
+    state.startTicks = Now();
+    state.startTime = std::chrono::steady_clock::now();
+    m_isEnabled.store(true, std::memory_order_relaxed);
+}
+
+
+void Profiler::Record(EventType type, const char* name, uint64_t start, uint64_t end) noexcept {
+    ProfilerState& state = ProfilerState::Instance();
+    ProfilerState::ThreadRing* ring = state.Ring();
+    if (not ring) {
+        state.droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->cachedTail >= ringCapacity) {
+        ring->cachedTail = ring->tail.load(std::memory_order_acquire);
+        if (head - ring->cachedTail >= ringCapacity) {
+            state.droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    ring->events[head & (ringCapacity - 1)] = Event{ start, end, name, type };
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+
+void Profiler::Plot(const char* name, double value) noexcept {
+    if (IsEnabled()) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        Record(EventType::Plot, name, Now(), bits);
+    }
+}
+
+
+void Profiler::Frame(const char* name) noexcept {
+    if (not IsEnabled())
+        return;
+    Record(EventType::Frame, name ? name : "Frame", Now(), 0);
+    try {
+        Collect();
+    }
+    catch (...) {
+    }
+}
+
+
+void Profiler::SetThreadName(const char* name) {
+    // threads which never record don't get a ring
+    snprintf(ProfilerState::threadName, sizeof(ProfilerState::threadName), "%s", name);
+    if (ProfilerState::threadRing) {
+        ProfilerState& state = ProfilerState::Instance();
+        std::lock_guard<std::mutex> guard(state.lock);
+        ProfilerState::threadRing->name = ProfilerState::threadName;
+    }
+}
+
+
+void Profiler::Collect(void) {
+    ProfilerState& state = ProfilerState::Instance();
+    std::lock_guard<std::mutex> guard(state.lock);
+    state.Drain(false);
+}
+
+
+bool Profiler::WriteTrace(const char* filename) {
+    ProfilerState& state = ProfilerState::Instance();
+    std::lock_guard<std::mutex> guard(state.lock);
+    state.Drain(false);
+    return state.Write(filename);
+}
+
+
+void Profiler::SetExitTrace(const char* filename) {
+    ProfilerState& state = ProfilerState::Instance();
+    std::lock_guard<std::mutex> guard(state.lock);
+    state.exitTrace = filename ? filename : "";
+}
+
+
+uint64_t Profiler::DroppedEvents(void) noexcept {
+    return ProfilerState::Instance().droppedCount.load(std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// Chrome trace event format: zones are complete events ("X"), frame marks and messages instant
+// events ("i"), plots counter events ("C"). Time stamps are microseconds since recording started.
+
+static void WriteString(FILE* file, const char* s) {
+    fputc('"', file);
+    for (; *s; ++s) {
+        unsigned char c = static_cast<unsigned char>(*s);
+        if ((c == '"') or (c == '\\'))
+            fprintf(file, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(file, "\\u%04x", c);
+        else
+            fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+
+bool ProfilerState::Write(const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (not file)
+        return false;
+
+    // ticks per microsecond, measured over the recording time
+    uint64_t ticks = Profiler::Now() - startTicks;
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+    double ticksPerUs = ((us > 0.0) and (ticks > 0)) ? double(ticks) / us : 1000.0;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    const char* separator = "";
+    for (auto& ring : rings) {
+        if (not ring->name.empty()) {
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", separator, ring->id);
+            WriteString(file, ring->name.c_str());
+            fprintf(file, "}}");
+            separator = ",\n";
+        }
+        for (const Profiler::Event& e : ring->captured) {
+            fprintf(file, "%s{\"name\":", separator);
+            separator = ",\n";
+            WriteString(file, e.name ? e.name : "");
+            double ts = double(int64_t(e.start - startTicks)) / ticksPerUs;
+            switch (e.type) {
+            case Profiler::EventType::Zone:
+                fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", ts, double(e.end - e.start) / ticksPerUs);
+                break;
+            case Profiler::EventType::Frame:
+                fprintf(file, ",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f", ts);
+                break;
+            case Profiler::EventType::Plot: {
+                double value;
+                std::memcpy(&value, &e.end, sizeof(value));
+                if (not std::isfinite(value))   // not representable in JSON
+                    value = 0.0;
+                fprintf(file, ",\"ph\":\"C\",\"ts\":%.3f,\"args\":{\"value\":%.17g}", ts, value);
+                break;
+            }
+            case Profiler::EventType::Message:
+                fprintf(file, ",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f", ts);
+                break;
+            }
+            fprintf(file, ",\"pid\":1,\"tid\":%u}", ring->id);
+        }
+    }
+    fprintf(file, "\n]}\n");
+    return (fclose(file) == 0);
+}
+
+// =================================================================================================
+// PROFILER_TRACE=<file> records from startup and writes the trace at exit.
+
+static struct ProfilerExitTrace {
+    ProfilerExitTrace() {
+        if (const char* filename = getenv("PROFILER_TRACE"); filename and *filename) {
+            Profiler::SetExitTrace(filename);
+            Profiler::Enable(true);
+        }
+    }
+
+    ~ProfilerExitTrace() {
+        ProfilerState& state = ProfilerState::Instance();
+        std::string filename;
+        {
+            std::lock_guard<std::mutex> guard(state.lock);
+            filename = state.exitTrace;
+        }
+        if (not filename.empty())
+            Profiler::WriteTrace(filename.c_str());
+    }
+} profilerExitTrace;
+
+// =================================================================================================
@@ -0,0 +1,191 @@
+
+#include <iterator>
+#include <algorithm>
+#include "simd.h"
+#include "jobsystem.h"
+#include "random.hpp"   // last: it defines the macro random
+
+#if SIMD_X86
+#   include <immintrin.h>
+#endif
+
+// =================================================================================================
+// Batch block generation. The SIMD versions compute one block per vector lane (the four counter
+// words of all lanes in four registers) and transpose the results back to block order.
+
+using BlocksKernel = void (*)(const uint32_t key[2], uint64_t block, uint64_t stream, uint32_t* values, size_t blockCount) noexcept;
+
+static void BlocksScalar(const uint32_t key[2], uint64_t block, uint64_t stream, uint32_t* values, size_t blockCount) noexcept {
+    for (size_t i = 0; i < blockCount; ++i, values += RandomStream::blockSize)
+        RandomStream::Block(key, block + i, stream, values);
+}
+
+#if SIMD_X86
+
+// high 32 bits of the products a * m per lane; lo receives the low 32 bits
+SIMD_TARGET_SSE4
+static inline __m128i MulHiLo(__m128i a, __m128i m, __m128i& lo) noexcept {
+    lo = _mm_mullo_epi32(a, m);
+    __m128i even = _mm_mul_epu32(a, m);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+    return _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC);
+}
+
+
+SIMD_TARGET_SSE4
+static void BlocksSSE4(const uint32_t key[2], uint64_t block, uint64_t stream, uint32_t* values, size_t blockCount) noexcept {
+    const __m128i m0 = _mm_set1_epi32(int(RandomStream::multiplier0));
+    const __m128i m1 = _mm_set1_epi32(int(RandomStream::multiplier1));
+    size_t n = blockCount & ~size_t(3);
+    for (size_t i = 0; i < n; i += 4, block += 4, values += 4 * RandomStream::blockSize) {
+        __m128i c0 = _mm_setr_epi32(int(uint32_t(block)), int(uint32_t(block + 1)), int(uint32_t(block + 2)), int(uint32_t(block + 3)));
+        __m128i c1 = _mm_setr_epi32(int(uint32_t(block >> 32)), int(uint32_t((block + 1) >> 32)), int(uint32_t((block + 2) >> 32)), int(uint32_t((block + 3) >> 32)));
+        __m128i c2 = _mm_set1_epi32(int(uint32_t(stream)));
+        __m128i c3 = _mm_set1_epi32(int(uint32_t(stream >> 32)));
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int r = 0; r < 10; ++r) {
+            if (r) {
+                k0 += RandomStream::weyl0;
+                k1 += RandomStream::weyl1;
+            }
+            __m128i lo0, lo1;
+            __m128i hi0 = MulHiLo(c0, m0, lo0);
+            __m128i hi1 = MulHiLo(c2, m1, lo1);
+            c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(int(k0)));
+            c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(int(k1)));
+            c1 = lo1;
+            c3 = lo0;
+        }
+        __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+        __m128i t1 = _mm_unpacklo_epi32(c2, c3);
+        __m128i t2 = _mm_unpackhi_epi32(c0, c1);
+        __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+        __m128i* p = reinterpret_cast<__m128i*>(values);
+        _mm_storeu_si128(p, _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128(p + 1, _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128(p + 2, _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128(p + 3, _mm_unpackhi_epi64(t2, t3));
+    }
+    BlocksScalar(key, block, stream, values, blockCount - n);
+}
+
+
+SIMD_TARGET_AVX2
+static inline __m256i MulHiLo(__m256i a, __m256i m, __m256i& lo) noexcept {
+    lo = _mm256_mullo_epi32(a, m);
+    __m256i even = _mm256_mul_epu32(a, m);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+
+SIMD_TARGET_AVX2
+static void BlocksAVX2(const uint32_t key[2], uint64_t block, uint64_t stream, uint32_t* values, size_t blockCount) noexcept {
+    const __m256i m0 = _mm256_set1_epi32(int(RandomStream::multiplier0));
+    const __m256i m1 = _mm256_set1_epi32(int(RandomStream::multiplier1));
+    size_t n = blockCount & ~size_t(7);
+    for (size_t i = 0; i < n; i += 8, block += 8, values += 8 * RandomStream::blockSize) {
+        alignas(32) uint32_t lo[8], hi[8];
+        for (int l = 0; l < 8; ++l) {
+            lo[l] = uint32_t(block + l);
+            hi[l] = uint32_t((block + l) >> 32);
+        }
+        __m256i c0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lo));
+        __m256i c1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(hi));
+        __m256i c2 = _mm256_set1_epi32(int(uint32_t(stream)));
+        __m256i c3 = _mm256_set1_epi32(int(uint32_t(stream >> 32)));
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int r = 0; r < 10; ++r) {
+            if (r) {
+                k0 += RandomStream::weyl0;
+                k1 += RandomStream::weyl1;
+            }
+            __m256i lo0, lo1;
+            __m256i hi0 = MulHiLo(c0, m0, lo0);
+            __m256i hi1 = MulHiLo(c2, m1, lo1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(int(k0)));
+            c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(int(k1)));
+            c1 = lo1;
+            c3 = lo0;
+        }
+        // the unpacks work per 128 bit half: b04 holds blocks 0 and 4, b15 blocks 1 and 5 etc.
+        __m256i t0 = _mm256_unpacklo_epi32(c0, c1);
+        __m256i t1 = _mm256_unpacklo_epi32(c2, c3);
+        __m256i t2 = _mm256_unpackhi_epi32(c0, c1);
+        __m256i t3 = _mm256_unpackhi_epi32(c2, c3);
+        __m256i b04 = _mm256_unpacklo_epi64(t0, t1);
+        __m256i b15 = _mm256_unpackhi_epi64(t0, t1);
+        __m256i b26 = _mm256_unpacklo_epi64(t2, t3);
+        __m256i b37 = _mm256_unpackhi_epi64(t2, t3);
+        __m256i* p = reinterpret_cast<__m256i*>(values);
+        _mm256_storeu_si256(p, _mm256_permute2x128_si256(b04, b15, 0x20));
+        _mm256_storeu_si256(p + 1, _mm256_permute2x128_si256(b26, b37, 0x20));
+        _mm256_storeu_si256(p + 2, _mm256_permute2x128_si256(b04, b15, 0x31));
+        _mm256_storeu_si256(p + 3, _mm256_permute2x128_si256(b26, b37, 0x31));
+    }
+    BlocksSSE4(key, block, stream, values, blockCount - n);
+}
+
+#endif //SIMD_X86
+
+// =================================================================================================
+
+static BlocksKernel SelectBlocksKernel(void) noexcept {
+#if SIMD_X86
+    switch (Simd::SupportedLevel()) {
+    case Simd::Level::AVX2:
+        return BlocksAVX2;
+    case Simd::Level::SSE4:
+        return BlocksSSE4;
+    default:
+        break;
+    }
+#endif
+    return BlocksScalar;
+}
+
+
+void RandomStream::Blocks(const uint32_t key[2], uint64_t block, uint64_t stream, uint32_t* values, size_t blockCount) noexcept {
+    static const BlocksKernel kernel = SelectBlocksKernel();
+    kernel(key, block, stream, values, blockCount);
+}
+
+
+void RandomStream::Fill(std::span<uint32_t> values) noexcept {
+    uint32_t* p = values.data();
+    size_t n = values.size();
+    // use up buffered values first so batches continue the sequence seamlessly
+    for (; n and m_buffered; --n)
+        *p++ = Next32();
+    size_t blockCount = n / blockSize;
+    Blocks(m_key, m_block, m_stream, p, blockCount);
+    m_block += blockCount;
+    p += blockCount * blockSize;
+    for (n -= blockCount * blockSize; n; --n)
+        *p++ = Next32();
+}
+
+
+void RandomStream::Fill(std::span<float> values, float scale) noexcept {
+    uint32_t raw[256];
+    for (size_t i = 0; i < values.size(); ) {
+        size_t n = std::min(values.size() - i, std::size(raw));
+        Fill(std::span<uint32_t>(raw, n));
+        for (size_t j = 0; j < n; ++j)
+            values[i + j] = ToFloat(raw[j]) * scale;
+        i += n;
+    }
+}
+
+// =================================================================================================
+
+uint64_t Random::ThreadStreamId(void) noexcept {
+    int32_t i = JobSystem::ThreadIndex();
+    if (i >= 0)
+        return uint64_t(i);
+    // other threads keep their id across reseeds, so their sequences are reproducible, too
+    static thread_local uint64_t foreignId = foreignStreams + foreignStreamCount.fetch_add(1, std::memory_order_relaxed);
+    return foreignId;
+}
+
+// =================================================================================================
@@ -0,0 +1,57 @@
+
+#include "simd.h"
+
+#if SIMD_X86 and defined(_MSC_VER) and not defined(__clang__)
+#   include <intrin.h>
+#endif
+
+// =================================================================================================
+
+static Simd::Level DetectLevel(void) noexcept {
+#if SIMD_X86
+#   if defined(_MSC_VER) and not defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool sse4 = (info[2] & (1 << 19)) != 0;
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osAvx = ((info[2] & (1 << 27)) != 0) and ((info[2] & (1 << 28)) != 0) and ((_xgetbv(0) & 6) == 6);
+    bool avx2 = false;
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+    if (avx2 and fma and osAvx)
+        return Simd::Level::AVX2;
+#   else
+    __builtin_cpu_init();
+    bool sse4 = __builtin_cpu_supports("sse4.1");
+    if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma"))
+        return Simd::Level::AVX2;
+#   endif
+    if (sse4)
+        return Simd::Level::SSE4;
+#endif
+    return Simd::Level::Scalar;
+}
+
+
+Simd::Level Simd::SupportedLevel(void) noexcept {
+    static const Level supportedLevel = DetectLevel();
+    return supportedLevel;
+}
+
+
+const char* Simd::LevelName(Level level) noexcept {
+    switch (level) {
+    case Level::AVX2:
+        return "AVX2";
+    case Level::SSE4:
+        return "SSE4.1";
+    default:
+        return "scalar";
+    }
+}
+
+// =================================================================================================
@@ -0,0 +1,400 @@
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include "sizeclassallocator.h"
+
+// =================================================================================================
+// Block layout: [BlockHeader][user data][guard (SIZE_CLASS_DEBUG only)]
+// The header keeps the size class and the requested size, so Free() needs no lookup. Free blocks are
+// linked through their first bytes.
+
+namespace {
+
+    constexpr uint32_t blockMagic = 0x5A11C0DE;
+    constexpr uint32_t freeMagic = 0xF5EEB10C;
+    constexpr uint32_t largeClass = 0xFFFFFFFF;
+
+#if SIZE_CLASS_DEBUG
+    constexpr size_t guardSize = 16;
+    constexpr uint8_t guardByte = 0xFD;
+    constexpr uint8_t freedByte = 0xDD;
+#else
+    constexpr size_t guardSize = 0;
+#endif
+
+    struct alignas(16) BlockHeader {
+#if SIZE_CLASS_DEBUG
+        BlockHeader*    prev;       // list of live blocks
+        BlockHeader*    next;
+#endif
+        uint64_t        size;       // requested size
+        uint32_t        sizeClass;
+        uint32_t        magic;
+
+        inline uint8_t* Data(void) noexcept {
+            return reinterpret_cast<uint8_t*>(this + 1);
+        }
+    };
+
+    struct FreeBlock {
+        FreeBlock*  next;
+    };
+
+    inline BlockHeader* HeaderOf(const void* p) noexcept {
+        return reinterpret_cast<BlockHeader*>(const_cast<void*>(p)) - 1;
+    }
+
+    constexpr size_t ClassBlockSize(int32_t sizeClass) noexcept {
+        return sizeof(BlockHeader) + SizeClassAllocator::ClassSize(sizeClass) + guardSize;
+    }
+
+    // number of blocks moved between a thread cache and the central list at once
+    constexpr int32_t BatchSize(int32_t sizeClass) noexcept {
+        return std::clamp(int32_t(16 * 1024 / ClassBlockSize(sizeClass)), 4, 64);
+    }
+
+    //-----------------------------------------------------------------------------
+
+    struct alignas(64) CentralList {
+        std::mutex  lock;
+        FreeBlock*  blocks{ nullptr };
+    };
+
+    struct alignas(64) ClassCounters {
+        std::atomic<uint64_t>   allocations{ 0 };
+        std::atomic<uint64_t>   releases{ 0 };
+    };
+
+    struct AllocatorState {
+        CentralList             centralLists[SizeClassAllocator::classCount];
+        ClassCounters           counters[SizeClassAllocator::classCount];
+        std::atomic<size_t>     liveBytes{ 0 };
+        std::atomic<size_t>     peakBytes{ 0 };
+        std::atomic<size_t>     systemBytes{ 0 };
+        std::atomic<uint64_t>   largeAllocations{ 0 };
+        std::atomic<uint64_t>   largeReleases{ 0 };
+#if SIZE_CLASS_DEBUG
+        std::mutex              liveLock;
+        BlockHeader*            liveBlocks{ nullptr };
+#endif
+    };
+
+    // The state is constructed on first use in static storage and never destroyed, so blocks can be
+    // freed during static destruction.
+    AllocatorState& State(void) noexcept {
+        alignas(AllocatorState) static unsigned char storage[sizeof(AllocatorState)];
+        static AllocatorState* state = new (storage) AllocatorState();
+        return *state;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    inline void AddLiveBytes(AllocatorState& state, size_t size) noexcept {
+        size_t live = state.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        size_t peak = state.peakBytes.load(std::memory_order_relaxed);
+        while ((live > peak) and not state.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            ;
+    }
+
+    // link the blocks of a new chunk into a free list
+    FreeBlock* CarveChunk(AllocatorState& state, int32_t sizeClass) noexcept {
+        size_t blockSize = ClassBlockSize(sizeClass);
+        size_t blockCount = SizeClassAllocator::chunkSize / blockSize;
+        uint8_t* chunk = static_cast<uint8_t*>(malloc(blockSize * blockCount));
+        if (not chunk)
+            return nullptr;
+        state.systemBytes.fetch_add(blockSize * blockCount, std::memory_order_relaxed);
+        FreeBlock* head = nullptr;
+        for (size_t i = blockCount; i; ) {
+            FreeBlock* b = reinterpret_cast<FreeBlock*>(chunk + --i * blockSize);
+            b->next = head;
+            head = b;
+        }
+        return head;
+    }
+
+    // take up to count blocks from the central list of sizeClass
+    FreeBlock* PopBatch(AllocatorState& state, int32_t sizeClass, int32_t& count) noexcept {
+        CentralList& central = state.centralLists[sizeClass];
+        std::lock_guard<std::mutex> lock(central.lock);
+        if (not central.blocks and not (central.blocks = CarveChunk(state, sizeClass))) {
+            count = 0;
+            return nullptr;
+        }
+        FreeBlock* head = central.blocks;
+        FreeBlock* tail = head;
+        int32_t n = 1;
+        for (; (n < count) and tail->next; ++n)
+            tail = tail->next;
+        central.blocks = tail->next;
+        tail->next = nullptr;
+        count = n;
+        return head;
+    }
+
+    void PushBatch(AllocatorState& state, int32_t sizeClass, FreeBlock* head, FreeBlock* tail) noexcept {
+        CentralList& central = state.centralLists[sizeClass];
+        std::lock_guard<std::mutex> lock(central.lock);
+        tail->next = central.blocks;
+        central.blocks = head;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Per thread free lists. Returned to the central lists when the thread terminates; blocks freed
+    // by a thread after that (from other thread_local destructors) go to the central lists directly.
+
+    struct ThreadCache {
+        struct FreeList {
+            FreeBlock*  head{ nullptr };
+            int32_t     count{ 0 };
+        };
+
+        FreeList    lists[SizeClassAllocator::classCount];
+
+        constexpr ThreadCache() noexcept = default;
+
+        ~ThreadCache();
+
+        FreeBlock* Pop(AllocatorState& state, int32_t sizeClass) noexcept {
+            FreeList& list = lists[sizeClass];
+            if (not list.head) {
+                list.count = BatchSize(sizeClass);
+                if (not (list.head = PopBatch(state, sizeClass, list.count)))
+                    return nullptr;
+            }
+            FreeBlock* b = list.head;
+            list.head = b->next;
+            --list.count;
+            return b;
+        }
+
+        void Push(AllocatorState& state, int32_t sizeClass, FreeBlock* b) noexcept {
+            FreeList& list = lists[sizeClass];
+            b->next = list.head;
+            list.head = b;
+            int32_t batchSize = BatchSize(sizeClass);
+            if (++list.count > 2 * batchSize) { // return the surplus to the other threads
+                FreeBlock* tail = list.head;
+                for (int32_t i = 1; i < batchSize; ++i)
+                    tail = tail->next;
+                FreeBlock* head = list.head;
+                list.head = tail->next;
+                list.count -= batchSize;
+                PushBatch(state, sizeClass, head, tail);
+            }
+        }
+
+        void Flush(AllocatorState& state) noexcept {
+            for (int32_t i = 0; i < SizeClassAllocator::classCount; ++i) {
+                FreeList& list = lists[i];
+                if (list.head) {
+                    FreeBlock* tail = list.head;
+                    while (tail->next)
+                        tail = tail->next;
+                    PushBatch(state, i, list.head, tail);
+                    list.head = nullptr;
+                    list.count = 0;
+                }
+            }
+        }
+    };
+
+    thread_local bool threadCacheDestroyed = false;
+
+    thread_local ThreadCache threadCache;
+
+    ThreadCache::~ThreadCache() {
+        threadCacheDestroyed = true;
+        Flush(State());
+    }
+
+    //-----------------------------------------------------------------------------
+
+#if SIZE_CLASS_DEBUG
+
+    inline size_t Capacity(const BlockHeader* h) noexcept {
+        return (h->sizeClass == largeClass) ? size_t(h->size) : SizeClassAllocator::ClassSize(int32_t(h->sizeClass));
+    }
+
+    // all bytes between the requested size and the end of the block are guard bytes
+    bool GuardIsIntact(BlockHeader* h) noexcept {
+        const uint8_t* guard = h->Data() + h->size;
+        for (size_t i = 0, l = Capacity(h) - size_t(h->size) + guardSize; i < l; ++i) {
+            if (guard[i] != guardByte)
+                return false;
+        }
+        return true;
+    }
+
+    void LinkLiveBlock(AllocatorState& state, BlockHeader* h) noexcept {
+        memset(h->Data() + h->size, guardByte, Capacity(h) - size_t(h->size) + guardSize);
+        std::lock_guard<std::mutex> lock(state.liveLock);
+        h->prev = nullptr;
+        h->next = state.liveBlocks;
+        if (state.liveBlocks)
+            state.liveBlocks->prev = h;
+        state.liveBlocks = h;
+    }
+
+    void UnlinkLiveBlock(AllocatorState& state, BlockHeader* h) noexcept {
+        if (not GuardIsIntact(h))
+            fprintf(stderr, "SizeClassAllocator: buffer overrun behind block %p (%zu bytes)\n", static_cast<void*>(h->Data()), size_t(h->size));
+        {
+            std::lock_guard<std::mutex> lock(state.liveLock);
+            if (h->prev)
+                h->prev->next = h->next;
+            else
+                state.liveBlocks = h->next;
+            if (h->next)
+                h->next->prev = h->prev;
+        }
+        memset(h->Data(), freedByte, size_t(h->size));
+    }
+
+#endif
+}
+
+// =================================================================================================
+
+void* SizeClassAllocator::Allocate(size_t size) noexcept {
+    AllocatorState& state = State();
+    BlockHeader* h;
+    if (size > maxClassSize) {
+        if (not (h = static_cast<BlockHeader*>(malloc(sizeof(BlockHeader) + size + guardSize))))
+            return nullptr;
+        h->sizeClass = largeClass;
+        state.largeAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        int32_t sizeClass = SizeClass(size);
+        FreeBlock* b;
+        if (not threadCacheDestroyed)
+            b = threadCache.Pop(state, sizeClass);
+        else {
+            int32_t count = 1;
+            b = PopBatch(state, sizeClass, count);
+        }
+        if (not b)
+            return nullptr;
+        h = reinterpret_cast<BlockHeader*>(b);
+        h->sizeClass = uint32_t(sizeClass);
+        state.counters[sizeClass].allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    h->size = size;
+    h->magic = blockMagic;
+    AddLiveBytes(state, size);
+#if SIZE_CLASS_DEBUG
+    LinkLiveBlock(state, h);
+#endif
+    return h->Data();
+}
+
+
+void SizeClassAllocator::Free(void* p) noexcept {
+    if (not p)
+        return;
+    BlockHeader* h = HeaderOf(p);
+    if (h->magic != blockMagic) {
+        fprintf(stderr, "SizeClassAllocator: %s %p\n", (h->magic == freeMagic) ? "double free of block" : "free of unknown block", p);
+        return;
+    }
+    AllocatorState& state = State();
+#if SIZE_CLASS_DEBUG
+    UnlinkLiveBlock(state, h);
+#endif
+    h->magic = freeMagic;
+    state.liveBytes.fetch_sub(size_t(h->size), std::memory_order_relaxed);
+    if (h->sizeClass == largeClass) {
+        state.largeReleases.fetch_add(1, std::memory_order_relaxed);
+        free(h);
+        return;
+    }
+    int32_t sizeClass = int32_t(h->sizeClass);
+    state.counters[sizeClass].releases.fetch_add(1, std::memory_order_relaxed);
+    FreeBlock* b = reinterpret_cast<FreeBlock*>(h);
+    if (not threadCacheDestroyed)
+        threadCache.Push(state, sizeClass, b);
+    else
+        PushBatch(state, sizeClass, b, b);
+}
+
+
+size_t SizeClassAllocator::BlockSize(const void* p) noexcept {
+    const BlockHeader* h = HeaderOf(p);
+    return (h->sizeClass == largeClass) ? size_t(h->size) : ClassSize(int32_t(h->sizeClass));
+}
+
+
+SizeClassAllocator::Stats SizeClassAllocator::GetStats(void) noexcept {
+    AllocatorState& state = State();
+    Stats stats;
+    stats.liveBytes = state.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = state.peakBytes.load(std::memory_order_relaxed);
+    stats.systemBytes = state.systemBytes.load(std::memory_order_relaxed);
+    stats.largeAllocations = state.largeAllocations.load(std::memory_order_relaxed);
+    stats.largeReleases = state.largeReleases.load(std::memory_order_relaxed);
+    for (int32_t i = 0; i < classCount; ++i) {
+        stats.classes[i].blockSize = ClassSize(i);
+        stats.classes[i].allocations = state.counters[i].allocations.load(std::memory_order_relaxed);
+        stats.classes[i].releases = state.counters[i].releases.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+
+void SizeClassAllocator::PrintStats(FILE* stream) noexcept {
+    Stats stats = GetStats();
+    fprintf(stream, "SizeClassAllocator: %zu bytes live, %zu peak, %zu from system, %llu/%llu large allocations/releases\n",
+            stats.liveBytes, stats.peakBytes, stats.systemBytes,
+            (unsigned long long) stats.largeAllocations, (unsigned long long) stats.largeReleases);
+    for (const ClassStats& c : stats.classes) {
+        if (c.allocations)
+            fprintf(stream, "  %6zu bytes: %llu allocations, %llu live\n",
+                    c.blockSize, (unsigned long long) c.allocations, (unsigned long long) (c.allocations - c.releases));
+    }
+}
+
+
+int32_t SizeClassAllocator::CheckIntegrity(FILE* stream) noexcept {
+    int32_t corrupted = 0;
+#if SIZE_CLASS_DEBUG
+    AllocatorState& state = State();
+    std::lock_guard<std::mutex> lock(state.liveLock);
+    for (BlockHeader* h = state.liveBlocks; h; h = h->next) {
+        if ((h->magic != blockMagic) or not GuardIsIntact(h)) {
+            fprintf(stream, "SizeClassAllocator: block %p (%zu bytes) is corrupted\n", static_cast<void*>(h->Data()), size_t(h->size));
+            ++corrupted;
+        }
+    }
+#else
+    (void) stream;
+#endif
+    return corrupted;
+}
+
+
+int32_t SizeClassAllocator::ReportLeaks(FILE* stream) noexcept {
+    int32_t leaks = 0;
+#if SIZE_CLASS_DEBUG
+    AllocatorState& state = State();
+    std::lock_guard<std::mutex> lock(state.liveLock);
+    size_t bytes = 0;
+    for (BlockHeader* h = state.liveBlocks; h; h = h->next) {
+        if (leaks < 100)
+            fprintf(stream, "SizeClassAllocator: live block %p (%zu bytes)\n", static_cast<void*>(h->Data()), size_t(h->size));
+        ++leaks;
+        bytes += size_t(h->size);
+    }
+    if (leaks)
+        fprintf(stream, "SizeClassAllocator: %d live blocks, %zu bytes\n", leaks, bytes);
+#else
+    (void) stream;
+#endif
+    return leaks;
+}
+
+// =================================================================================================
@@ -0,0 +1,203 @@
+
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include "smallarray.hpp"
+
+// =================================================================================================
+// Allocation tests of SmallArray (make test). Counts the heap allocations through the global
+// operator new, so the inline storage, the spill to the heap and exception safety can be checked.
+
+static int allocations = 0;
+static int deallocations = 0;
+static int failures = 0;
+
+void* operator new(size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    if (p) {
+        ++deallocations;
+        std::free(p);
+    }
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        ++failures; \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+    }
+
+
+// counts its live instances; the copy numbered throwAt throws
+struct Item {
+    static inline int live = 0;
+    static inline int copies = 0;
+    static inline int throwAt = -1;
+
+    int value;
+
+    Item(int v = 0)
+        : value(v)
+    {
+        ++live;
+    }
+
+    Item(const Item& other)
+        : value(other.value)
+    {
+        if (copies++ == throwAt)
+            throw std::runtime_error("copy");
+        ++live;
+    }
+
+    Item& operator=(const Item& other) = default;
+
+    ~Item() {
+        --live;
+    }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+static void TestInline(void) {
+    int a0 = allocations;
+    {
+        SmallArray<int, 8> a;
+        for (int i = 0; i < 8; ++i)
+            a.Append(i);
+        CHECK(a.IsInline());
+        CHECK(allocations == a0);
+        a.Resize(4);
+        a.Resize(8, 7);
+        SmallArray<int, 8> b(a);
+        SmallArray<int, 8> c{ 1, 2, 3 };
+        c = b;
+        SmallArray<int, 8> d(std::move(c));
+        CHECK(allocations == a0);
+        CHECK((d.Length() == 8) and (d[7] == 7));
+    }
+    CHECK(allocations == a0);
+}
+
+
+static void TestSpill(void) {
+    int a0 = allocations, d0 = deallocations;
+    {
+        SmallArray<int, 8> a;
+        for (int i = 0; i < 9; ++i)
+            a.Append(i);
+        CHECK(not a.IsInline());
+        CHECK(allocations == a0 + 1);
+        for (int i = 9; i < 16; ++i)   // the buffer doubled to 16
+            a.Append(i);
+        CHECK(allocations == a0 + 1);
+        a.Append(16);
+        CHECK(allocations == a0 + 2);
+        CHECK(deallocations == d0 + 1);
+        a.Clear();  // keeps the buffer
+        a.Append(0);
+        CHECK(allocations == a0 + 2);
+        a.Reset();  // back to the inline storage
+        CHECK(a.IsInline() and (deallocations == d0 + 2));
+        a.Append(0);
+        CHECK(allocations == a0 + 2);
+    }
+    CHECK(allocations - a0 == deallocations - d0);
+}
+
+
+static void TestCopyMove(void) {
+    int a0 = allocations, d0 = deallocations;
+    {
+        SmallArray<int, 4> a{ 1, 2, 3, 4, 5 };
+        CHECK(allocations == a0 + 1);
+        SmallArray<int, 4> b(a);
+        CHECK(allocations == a0 + 2);
+        const int* data = b.Data();
+        SmallArray<int, 4> c(std::move(b));     // takes the buffer over
+        CHECK((allocations == a0 + 2) and (c.Data() == data) and b.IsInline() and b.IsEmpty());
+        SmallArray<int, 4> d;
+        d = std::move(c);
+        CHECK((allocations == a0 + 2) and (d.Data() == data));
+        CHECK((d.Length() == 5) and (d[4] == 5));
+    }
+    CHECK(allocations - a0 == deallocations - d0);
+}
+
+
+static void TestThrowingCopy(void) {
+    int a0 = allocations, d0 = deallocations;
+    {
+        SmallArray<Item, 2> a;
+        for (int i = 0; i < 5; ++i)
+            a.Append(i);
+        int live = Item::live;
+        int allocated = allocations - deallocations;
+        // copy constructor: the third item throws; the two copied ones and the buffer are released
+        Item::copies = 0;
+        Item::throwAt = 2;
+        bool hasThrown = false;
+        try {
+            SmallArray<Item, 2> b(a);
+        }
+        catch (const std::runtime_error&) {
+            hasThrown = true;
+        }
+        CHECK(hasThrown);
+        CHECK(Item::live == live);
+        CHECK(allocations - deallocations == allocated);
+        // initializer list constructor
+        Item::copies = 0;
+        hasThrown = false;
+        try {
+            SmallArray<Item, 2> c{ Item(1), Item(2), Item(3), Item(4) };
+        }
+        catch (const std::runtime_error&) {
+            hasThrown = true;
+        }
+        CHECK(hasThrown);
+        CHECK(Item::live == live);
+        CHECK(allocations - deallocations == allocated);
+        // copy assignment keeps the target's buffer and leaves it empty
+        SmallArray<Item, 2> d;
+        d.Resize(6);
+        Item::copies = 0;
+        hasThrown = false;
+        try {
+            d = a;
+        }
+        catch (const std::runtime_error&) {
+            hasThrown = true;
+        }
+        CHECK(hasThrown and d.IsEmpty());
+        CHECK(Item::live == live);
+        Item::throwAt = -1;
+    }
+    CHECK(Item::live == 0);
+    CHECK(allocations - a0 == deallocations - d0);
+}
+
+// =================================================================================================
+
+int main() {
+    TestInline();
+    TestSpill();
+    TestCopyMove();
+    TestThrowingCopy();
+    if (failures)
+        fprintf(stderr, "SmallArray: %d checks failed\n", failures);
+    else
+        printf("SmallArray: all checks passed\n");
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "sort.hpp"
+#include "parallelsort.hpp"
+#include "random.hpp"
+#include "clock.h"
+
+// =================================================================================================
+// Sort benchmark (make bench): std::sort, Sorter::Introsort, Sorter::RadixSort and ParallelSorter on
+// random, sorted, reversed and many-duplicates inputs, for int32_t values and for items sorted by a
+// 64 bit key (like render queue entries). Every result is compared with std::sort (values) or
+// std::stable_sort (items; radix sort has to be stable, the others only ordered by key).
+// usage: sortbench [count] [rounds] [worker threads for ParallelSorter]
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        ++failures; \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+    }
+
+
+struct Item {
+    uint64_t    key;
+    uint32_t    index;  // position in the input, to check stability
+};
+
+static inline bool operator<(const Item& i1, const Item& i2) noexcept {
+    return i1.key < i2.key;
+}
+
+enum class Input : int32_t {
+    Random,
+    Sorted,
+    Reversed,
+    Duplicates,     // 16 distinct values
+    Count
+};
+
+static const char* inputNames[int32_t(Input::Count)] = { "random", "sorted", "reversed", "duplicates" };
+
+
+static std::vector<uint64_t> MakeKeys(Input input, int32_t count, RandomStream& rng) {
+    std::vector<uint64_t> keys;
+    keys.resize(size_t(count));
+    for (uint64_t& key : keys)
+        key = (input == Input::Duplicates) ? rng.Bounded(16) : rng.Next64();
+    if (input == Input::Sorted)
+        std::sort(keys.begin(), keys.end());
+    else if (input == Input::Reversed)
+        std::sort(keys.begin(), keys.end(), std::greater<uint64_t>());
+    return keys;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// Runs sort on a fresh copy of input per round and returns the best time in milliseconds; the last
+// round's result is left in output.
+template <typename DATA_T, typename SORT_T>
+static double Measure(const std::vector<DATA_T>& input, std::vector<DATA_T>& output, int rounds, SORT_T sort) {
+    double best = 1e30;
+    for (int r = 0; r < rounds; ++r) {
+        output = input;
+        int64_t t = Clock::Nanos();
+        sort(output.data(), int32_t(output.size()));
+        best = std::min(best, double(Clock::Nanos() - t) * 1e-6);
+    }
+    return best;
+}
+
+
+static void RunValues(Input input, int32_t count, int rounds, RandomStream& rng) {
+    std::vector<int32_t> values;
+    values.reserve(size_t(count));
+    // the upper half of a key keeps the order of the keys; duplicate keys are small, negative ones too
+    for (uint64_t key : MakeKeys(input, count, rng))
+        values.push_back((input == Input::Duplicates) ? int32_t(key) - 8 : int32_t(uint32_t(key >> 32)));
+
+    std::vector<int32_t> expected = values, sorted;
+    std::sort(expected.begin(), expected.end());
+
+    double times[4];
+    times[0] = Measure(values, sorted, rounds, [](int32_t* data, int32_t n) { std::sort(data, data + n); });
+    CHECK(sorted == expected);
+    times[1] = Measure(values, sorted, rounds, [](int32_t* data, int32_t n) { Sorter::Introsort(data, n); });
+    CHECK(sorted == expected);
+    times[2] = Measure(values, sorted, rounds, [](int32_t* data, int32_t n) { Sorter::RadixSort(data, n); });
+    CHECK(sorted == expected);
+    times[3] = Measure(values, sorted, rounds, [](int32_t* data, int32_t n) { ParallelSorter::Sort(data, n); });
+    CHECK(sorted == expected);
+    printf("  %-12s %10.2f %10.2f %10.2f %10.2f\n", inputNames[int32_t(input)], times[0], times[1], times[2], times[3]);
+}
+
+
+static void RunItems(Input input, int32_t count, int rounds, RandomStream& rng) {
+    std::vector<Item> items;
+    items.reserve(size_t(count));
+    for (uint64_t key : MakeKeys(input, count, rng))
+        items.push_back(Item{ key, uint32_t(items.size()) });
+
+    std::vector<Item> expected = items, sorted;
+    std::stable_sort(expected.begin(), expected.end());
+    auto isStable = [&]() {
+        for (size_t i = 0; i < sorted.size(); ++i)
+            if ((sorted[i].key != expected[i].key) or (sorted[i].index != expected[i].index))
+                return false;
+        return true;
+    };
+    auto isOrdered = [&]() {
+        for (size_t i = 0; i < sorted.size(); ++i)
+            if (sorted[i].key != expected[i].key)
+                return false;
+        return true;
+    };
+
+    double times[4];
+    times[0] = Measure(items, sorted, rounds, [](Item* data, int32_t n) { std::stable_sort(data, data + n); });
+    CHECK(isStable());
+    times[1] = Measure(items, sorted, rounds, [](Item* data, int32_t n) { Sorter::Introsort(data, n); });
+    CHECK(isOrdered());
+    times[2] = Measure(items, sorted, rounds, [](Item* data, int32_t n) { Sorter::RadixSort(data, n, [](const Item& item) { return item.key; }); });
+    CHECK(isStable());
+    times[3] = Measure(items, sorted, rounds, [](Item* data, int32_t n) { ParallelSorter::Sort(data, n); });
+    CHECK(isOrdered());
+    printf("  %-12s %10.2f %10.2f %10.2f %10.2f\n", inputNames[int32_t(input)], times[0], times[1], times[2], times[3]);
+}
+
+// =================================================================================================
+
+int main(int argc, char** argv) {
+    int32_t count = (argc > 1) ? int32_t(atoi(argv[1])) : 1000000;
+    int rounds = (argc > 2) ? atoi(argv[2]) : 5;
+    int32_t workerCount = (argc > 3) ? int32_t(atoi(argv[3])) : 3;
+    if ((count < 1) or (rounds < 1) or (workerCount < 0)) {
+        fprintf(stderr, "usage: sortbench [count >= 1] [rounds >= 1] [worker threads >= 0]\n");
+        return EXIT_FAILURE;
+    }
+    if (not jobSystem.Init(workerCount)) {
+        fprintf(stderr, "Sort benchmark: cannot start %d workers\n", workerCount);
+        return EXIT_FAILURE;
+    }
+    RandomStream rng{ uint64_t(count) };
+    printf("%d int32_t values, ms (best of %d rounds), ParallelSorter with %d workers\n", count, rounds, jobSystem.WorkerCount());
+    printf("  %-12s %10s %10s %10s %10s\n", "", "std::sort", "Introsort", "RadixSort", "Parallel");
+    for (int32_t i = 0; i < int32_t(Input::Count); ++i)
+        RunValues(Input(i), count, rounds, rng);
+    printf("%d items with 64 bit keys, ms (best of %d rounds)\n", count, rounds);
+    printf("  %-12s %10s %10s %10s %10s\n", "", "stable_sort", "Introsort", "RadixSort", "Parallel");
+    for (int32_t i = 0; i < int32_t(Input::Count); ++i)
+        RunItems(Input(i), count, rounds, rng);
+    jobSystem.Shutdown();
+    if (failures) {
+        fprintf(stderr, "Sort benchmark: %d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
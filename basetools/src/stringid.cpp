@@ -0,0 +1,155 @@
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <cstdlib>
+#include <shared_mutex>
+#include "stringid.h"
+
+// =================================================================================================
+// The intern table is split into shards selected by the top bits of the hash. Each shard is an open
+// addressing table of entry pointers with linear probing, kept at most half full. Lookups of
+// existing strings only take the shard's read lock; a miss retakes the lock for writing, looks again
+// (another thread may have inserted the string meanwhile) and inserts. Entries are carved from
+// chunks owned by the shard and live until the process ends.
+
+class StringInternTable {
+public:
+    static constexpr int32_t shardBits = 4;
+    static constexpr int32_t shardCount = 1 << shardBits;
+    static constexpr size_t chunkSize = 16 * 1024;
+    static constexpr uint32_t initialCapacity = 64;
+
+private:
+    struct alignas(64) Shard {
+        std::shared_mutex           lock;
+        const StringId::Entry**     slots{ nullptr };
+        uint32_t                    capacity{ 0 };  // power of two
+        uint32_t                    count{ 0 };
+        char*                       chunk{ nullptr };
+        size_t                      chunkFree{ 0 };
+    };
+
+    Shard                   m_shards[shardCount];
+    std::atomic<int32_t>    m_count{ 1 };   // the empty string
+
+public:
+    static StringInternTable& Instance(void) {
+        // never destroyed, so StringIds stay valid during static destruction
+        static StringInternTable* table = new StringInternTable();
+        return *table;
+    }
+
+    const StringId::Entry* Intern(const char* s, size_t length, uint64_t hash) {
+        Shard& shard = m_shards[hash >> (64 - shardBits)];
+        {
+            std::shared_lock<std::shared_mutex> readLock(shard.lock);
+            const StringId::Entry* entry = Find(shard, s, length, hash);
+            if (entry)
+                return entry;
+        }
+        std::unique_lock<std::shared_mutex> writeLock(shard.lock);
+        const StringId::Entry* entry = Find(shard, s, length, hash);
+        if (entry)
+            return entry;
+        if ((shard.count + 1) * 2 > shard.capacity)
+            Grow(shard);
+        entry = NewEntry(shard, s, length, hash);
+        Insert(shard, entry);
+        ++shard.count;
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        return entry;
+    }
+
+    inline int32_t Count(void) const noexcept {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+private:
+    // the low hash bits pick the slot, the high bits have already picked the shard
+    static const StringId::Entry* Find(const Shard& shard, const char* s, size_t length, uint64_t hash) noexcept {
+        if (not shard.capacity)
+            return nullptr;
+        uint32_t mask = shard.capacity - 1;
+        for (uint32_t i = uint32_t(hash) & mask; ; i = (i + 1) & mask) {
+            const StringId::Entry* entry = shard.slots[i];
+            if (not entry)
+                return nullptr;
+            if ((entry->hash == hash) and (entry->length == length) and (memcmp(entry->text, s, length) == 0))
+                return entry;
+        }
+    }
+
+
+    static void Insert(Shard& shard, const StringId::Entry* entry) noexcept {
+        uint32_t mask = shard.capacity - 1;
+        uint32_t i = uint32_t(entry->hash) & mask;
+        while (shard.slots[i])
+            i = (i + 1) & mask;
+        shard.slots[i] = entry;
+    }
+
+
+    static void Grow(Shard& shard) {
+        uint32_t capacity = shard.capacity ? shard.capacity * 2 : initialCapacity;
+        const StringId::Entry** slots = static_cast<const StringId::Entry**>(calloc(capacity, sizeof(StringId::Entry*)));
+        if (not slots)
+            throw std::bad_alloc();
+        const StringId::Entry** oldSlots = shard.slots;
+        uint32_t oldCapacity = shard.capacity;
+        shard.slots = slots;
+        shard.capacity = capacity;
+        for (uint32_t i = 0; i < oldCapacity; ++i)
+            if (oldSlots[i])
+                Insert(shard, oldSlots[i]);
+        free(oldSlots);
+    }
+
+
+    static const StringId::Entry* NewEntry(Shard& shard, const char* s, size_t length, uint64_t hash) {
+        size_t size = (offsetof(StringId::Entry, text) + length + 1 + alignof(StringId::Entry) - 1) & ~(alignof(StringId::Entry) - 1);
+        char* p;
+        if (size > chunkSize / 4) // long strings get a block of their own
+            p = static_cast<char*>(malloc(size));
+        else {
+            if (size > shard.chunkFree) {
+                shard.chunk = static_cast<char*>(malloc(chunkSize));
+                shard.chunkFree = shard.chunk ? chunkSize : 0;
+            }
+            p = shard.chunk;
+            if (p) {
+                shard.chunk += size;
+                shard.chunkFree -= size;
+            }
+        }
+        if (not p)
+            throw std::bad_alloc();
+        StringId::Entry* entry = reinterpret_cast<StringId::Entry*>(p);
+        entry->hash = hash;
+        entry->length = uint32_t(length);
+        memcpy(entry->text, s, length);
+        entry->text[length] = '\0';
+        return entry;
+    }
+};
+
+// =================================================================================================
+
+const StringId::Entry* StringId::EmptyEntry(void) noexcept {
+    static const Entry emptyEntry{ HashText("", 0), 0, { '\0' } };
+    return &emptyEntry;
+}
+
+
+const StringId::Entry* StringId::Intern(const char* s, size_t length) {
+    if (not length)
+        return EmptyEntry();
+    return StringInternTable::Instance().Intern(s, length, HashText(s, length));
+}
+
+
+int32_t StringId::InternedCount(void) noexcept {
+    return StringInternTable::Instance().Count();
+}
+
+// =================================================================================================
@@ -4,6 +4,7 @@
 #include "base_shaderhandler.h"
 #include "commandlist.h"
 #include "dx12context.h"
+#include "framearena.h"
 #include "tracy_wrapper.h"
 
 #pragma warning(push)
@@ -260,6 +261,7 @@ void BaseDisplayHandler::BeginFrame(void) {
     // Advance frame slot, wait fence, drain that slot's deferred resources, reset CBV allocator.
     // Active-shader tracking is invalidated because BeginFrame resets all DX12 command-list state.
     commandListHandler.BeginFrame();
+    frameArena.BeginFrame();
     baseShaderHandler.InvalidateActiveShader();
 }
 
@@ -8,6 +8,7 @@
 #include "shader.h"
 #include "string.hpp"
 #include "dictionary.hpp"
+#include "stringid.h"
 
 // =================================================================================================
 
@@ -201,8 +202,8 @@ class BaseShaderCode
     : public Shader
 {
 protected:
-    Dictionary<String, Shader*>         m_shaders;
-    Dictionary<String, ComputeShader*>  m_computeShaders;
+    StringIdDictionary<Shader*>         m_shaders;
+    StringIdDictionary<ComputeShader*>  m_computeShaders;
 
 public:
     BaseShaderCode();
@@ -210,12 +211,12 @@ public:
 
     void AddShaders(AutoArray<const ShaderSource*>& shaderSource);
 
-    inline Shader* GetShader(String shaderId) {
+    inline Shader* GetShader(StringId shaderId) {
         Shader** shader = m_shaders.Find(shaderId);
         return shader ? *shader : nullptr;
     }
 
-    inline ComputeShader* SetupComputeShader(String shaderId) {
+    inline ComputeShader* SetupComputeShader(StringId shaderId) {
         ComputeShader** shader = m_computeShaders.Find(shaderId);
         return shader ? *shader : nullptr;
     }
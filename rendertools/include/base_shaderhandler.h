@@ -6,6 +6,7 @@
 #include "base_shadercode.h"
 #include "matrix.hpp"
 #include "basesingleton.hpp"
+#include "stringid.h"
 
 // =================================================================================================
 
@@ -20,12 +21,12 @@ class BaseShaderHandler
 public:
     AutoArray<FloatArray*>  m_kernels;
     Shader*                 m_activeShader;
-    String                  m_activeShaderId;
+    StringId                m_activeShaderId;
     Texture                 m_grayNoise;
     BaseShaderCode*         m_shaderCode;
 
     BaseShaderHandler()
-        : m_kernels(16), m_shaderCode(nullptr), m_activeShader(nullptr), m_activeShaderId("")
+        : m_kernels(16), m_shaderCode(nullptr), m_activeShader(nullptr), m_activeShaderId()
     {
         _instance = this;
 #if 0
@@ -57,7 +58,18 @@ public:
 
     Shader* SelectShader(Texture* texture);
 
-    Shader* SetupRenderShader(String shaderId, String depthShaderId = "surfaceShadowShader");
+    // Shader ids are interned strings, so selecting the active shader compares pointers instead of
+    // names. Callers on per-draw paths should pass static StringIds rather than string literals.
+    Shader* SetupRenderShader(StringId shaderId, StringId depthShaderId);
+
+    inline Shader* SetupRenderShader(StringId shaderId) {
+        return SetupRenderShader(shaderId, DefaultDepthShaderId());
+    }
+
+    static inline const StringId& DefaultDepthShaderId(void) {
+        static const StringId depthShaderId("surfaceShadowShader");
+        return depthShaderId;
+    }
 
     void StopShader(bool needLegacyMatrices = false);
 
@@ -65,7 +77,7 @@ public:
     // Must be called after a DX12 BeginFrame() (new command list clears all pipeline state).
     inline void InvalidateActiveShader(void) noexcept {
         m_activeShader = nullptr;
-        m_activeShaderId = "";
+        m_activeShaderId = StringId();
     }
 
     inline bool ShaderIsActive(Shader* shader = nullptr) const noexcept {
@@ -74,11 +86,11 @@ public:
 
     inline Shader* ActiveShader(void) const noexcept { return m_activeShader; }
 
-    inline Shader* GetShader(String shaderId) {
+    inline Shader* GetShader(StringId shaderId) {
         return m_shaderCode->GetShader(shaderId);
     }
 
-    inline ComputeShader* SetupComputeShader(String shaderId) {
+    inline ComputeShader* SetupComputeShader(StringId shaderId) {
         return m_shaderCode->SetupComputeShader(shaderId);
     }
 
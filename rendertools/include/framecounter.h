@@ -2,6 +2,7 @@
 #pragma once
 
 #include "timer.hpp"
+#include "framepacer.h"
 #include "viewport.h"
 #include "colordata.h"
 
@@ -39,7 +40,7 @@ public:
     virtual bool Start(void) {
         if (m_renderStartTime != 0)
             return false;
-        m_renderStartTime = SDL_GetPerformanceCounter();
+        m_renderStartTime = uint64_t(Clock::Nanos());
         m_drawTimer.Start();
         return true;
     }
@@ -67,6 +68,9 @@ public:
     virtual void Update(void) = 0;
 
     virtual float GetFps(void) const = 0;
+
+    // the text Draw() shows
+    virtual void Format(char* text, size_t size) const;
 };
 
 // -------------------------------------------------------------------------------------------------
@@ -82,12 +86,22 @@ private:
     int                                     m_movingFrameIndex{ 0 };
     int                                     m_movingFrameCount{ 0 };
     uint64_t                                m_frequency{ 0 };
+    const FramePacer*                       m_pacer{ nullptr };
 
 public:
     MovingFrameCounter() = default;
 
     virtual ~MovingFrameCounter() = default;
 
+    // the pacer whose wake error statistics are shown with the frame rate; nullptr for none
+    inline void SetPacer(const FramePacer* pacer) noexcept {
+        m_pacer = pacer;
+    }
+
+    inline const FramePacer* Pacer(void) const noexcept {
+        return m_pacer;
+    }
+
     virtual bool Start(void);
 
     virtual void Reset(void);
@@ -95,6 +109,8 @@ public:
     virtual void Update(void);
 
     virtual float GetFps(void) const;
+
+    virtual void Format(char* text, size_t size) const;
 };
 
 // -------------------------------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 #include "string.hpp"
 #include "vector.hpp"
 #include "array.hpp"
+#include "smallarray.hpp"
 #include "matrix.hpp"
 #include "list.hpp"
 #include "avltree.hpp"
@@ -33,6 +34,9 @@ public:
         List<ShapeKeySet>           shapeKeys;  // N sets, each has 3 * triCount deltas
     };
 
+    // direct access to the shape keys of the list, rebuilt per primitive; models rarely have many
+    using ShapeKeyPointers = SmallArray<ShapeKeySet*, 16>;
+
 public:
     bool Load(const String& filename, bool fixModel = false);
 
@@ -136,9 +140,11 @@ private:
 
     void ReserveOutput(const PrimitiveData& in);
 
-    void BuildShapeKeyPointers(AutoArray<ShapeKeySet*>& keyPtrs);
+    void BuildShapeKeyPointers(ShapeKeyPointers& keyPtrs);
+
+    static void TransformPrimitive(PrimitiveData& in, const Matrix4f& worldM);
 
-    bool AppendTriangles(PrimitiveData& in, Matrix4f worldM, AutoArray<ShapeKeySet*>& keyPtrs);
+    bool AppendTriangles(PrimitiveData& in, Matrix4f worldM, ShapeKeyPointers& keyPtrs);
 
     void RecomputeMorphDeltas(ShapeKeySet& sk, const AutoArray<Vector3f>& morphedVertices);
 
@@ -1,6 +1,7 @@
 #pragma once
 #define NOMINMAX
 
+#include <span>
 #include <limits>
 #include <cstring>
 
@@ -267,6 +268,14 @@ public:
         m_offsetBuffers.Clear();
     }
 
+    // Write vertices, normals, texture coordinates and colors directly in gfx data format (see
+    // VertexDataBuffer). Meant for meshes that are rebuilt every frame; must be set while the mesh is empty.
+    // Tangent computation needs the application data lists and is not available in this mode.
+    void SetDirectWrite(bool directWrite);
+
+    // size hint for meshes that are rebuilt with a known vertex count; bufferMask: eMeshBufferBits
+    void Reserve(int32_t vertexCount, uint32_t bufferMask = mbVertex);
+
     inline void AddVertex(const Vector3f& v) {
         m_vertices.Append(v);
         m_vMin.Minimize(v);
@@ -277,6 +286,14 @@ public:
         AddVertex(static_cast<const Vector3f&>(v));
     }
 
+    inline void AddVertices(std::span<const Vector3f> v) {
+        m_vertices.AppendRange(v);
+        for (const auto& p : v) {
+            m_vMin.Minimize(p);
+            m_vMax.Maximize(p);
+        }
+    }
+
     inline void AddTangent(const Vector4f& v) {
         m_tangents.Append(v);
     }
@@ -297,6 +314,10 @@ public:
         m_texCoords[i].Append(tc);
     }
 
+    inline void AddTexCoords(std::span<const TexCoord> tc, int i = 0) {
+        m_texCoords[i].AppendRange(tc);
+    }
+
     inline void AddColor(const RGBAColor& c) {
         m_vertexColors.Append(c);
     }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "vector.hpp"
+#include "soaarray.hpp"
+#include "matrixkernels.h"
 
 // =================================================================================================
 
@@ -108,3 +110,100 @@ public:
 };
 
 // =================================================================================================
+// Movements of many objects, stored column wise so bulk updates run over dense arrays: Refresh()
+// recomputes the lengths and normals of all rows in one vectorized pass. Rows are accessed by field
+// name through Ref (movements[i].velocity), or copied in and out as Movement.
+
+class MovementArray : public SoAArray<Vector3f, Vector3f, float, Vector3f> {
+public:
+    using Base = SoAArray<Vector3f, Vector3f, float, Vector3f>;
+
+    typedef enum {
+        mcVelocity,
+        mcScale,
+        mcLength,
+        mcNormal
+    } eMovementColumns;
+
+    struct Ref {
+        Vector3f&   velocity;
+        Vector3f&   scale;
+        float&      length;
+        Vector3f&   normal;
+
+        inline Ref& operator=(const Movement& m) {
+            velocity = m.velocity;
+            scale = m.scale;
+            length = m.length;
+            normal = m.normal;
+            return *this;
+        }
+
+        inline operator Movement() const {
+            Movement m;
+            m.velocity = velocity;
+            m.scale = scale;
+            m.length = length;
+            m.normal = normal;
+            return m;
+        }
+    };
+
+    struct ConstRef {
+        const Vector3f& velocity;
+        const Vector3f& scale;
+        const float&    length;
+        const Vector3f& normal;
+
+        inline operator Movement() const {
+            Movement m;
+            m.velocity = velocity;
+            m.scale = scale;
+            m.length = length;
+            m.normal = normal;
+            return m;
+        }
+    };
+
+    using Base::Append;
+
+    inline int32_t Append(const Movement& m) {
+        return Base::Append(m.velocity, m.scale, m.length, m.normal);
+    }
+
+    // appends a row with the defaults of Movement() (unit scale, not the base's zero) and returns its index
+    inline int32_t Append(void) {
+        return Append(Movement());
+    }
+
+    // Sets the number of rows. New rows get the defaults of Movement().
+    void Resize(int32_t length) {
+        int32_t first = Length();
+        Base::Resize(length);
+        for (int32_t i = first; i < length; ++i)
+            (*this)[i] = Movement();
+    }
+
+    inline Ref operator[](int32_t i) noexcept {
+        return View<Ref>(i);
+    }
+
+    inline ConstRef operator[](int32_t i) const noexcept {
+        return View<ConstRef>(i);
+    }
+
+    // sets the (scaled) velocity of row i without refreshing it; see Refresh()
+    inline void SetVelocity(int32_t i, const Vector3f& v) noexcept {
+        Get<mcVelocity>(i) = v * Get<mcScale>(i);
+    }
+
+    // Recomputes length and normal of every row from its velocity, like Movement::Refresh() does for one.
+    inline void Refresh(void) noexcept {
+        static_assert(sizeof(Vector3f) == 3 * sizeof(float), "Vector3f must be a packed x, y, z triple");
+        MatrixKernels::Normalize(reinterpret_cast<const float*>(Column<mcVelocity>().data()),
+                                 reinterpret_cast<float*>(Column<mcNormal>().data()),
+                                 Column<mcLength>().data(), size_t(Length()), Conversions::NumericTolerance);
+    }
+};
+
+// =================================================================================================
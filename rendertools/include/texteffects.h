@@ -2,14 +2,15 @@
 
 #include "rendertarget.h"
 #include "colordata.h"
+#include "stringid.h"
 
 // =================================================================================================
 
 class TextEffects {
 public:
     struct AAMethod {
-        String  method = "";
-        int     strength = 0;
+        StringId    method;
+        int         strength = 0;
         inline bool ApplyAA() const { return method.Length() > 0; };
     };
 
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
 #include "vector.hpp"
 #include "array.hpp"
 #include "list.hpp"
@@ -13,6 +16,11 @@
 // Interface classes between python and OpenGL representations of rendering data
 // Supplies iterators, assignment and indexing operatores and transparent data conversion to OpenGL
 // ready format (Setup() method)
+// In direct write mode, appended data is written straight into the gfx data array in its final
+// component layout, skipping the application data list and the conversion in Setup(). This requires
+// the application data type to be a packed array of gfx data values (e.g. Vector3f -> 3 floats) and
+// is meant for meshes that are rebuilt frequently (e.g. text meshes). Use the list path if data has to
+// be inserted or accessed as list.
 
 class BaseVertexDataBuffer {
 public:
@@ -55,16 +63,12 @@ class VertexDataBuffer
     protected:
         SegmentedList<APP_DATA_T>   m_appData;
         AutoArray<GL_DATA_T>     m_gfxData;
+        bool                        m_directWrite{ false };
 
-#pragma warning(push)
-#pragma warning(disable:4100)
         VertexDataBuffer(uint32_t componentCount = 1, size_t listSegmentSize = 1)
-#pragma warning(pop)
             : BaseVertexDataBuffer(componentCount)
         {
-#if USE_SEGMENTED_LISTS
-            m_appData = SegmentedList<APP_DATA_T>(listSegmentSize);
-#endif
+            m_appData.SetSegmentSize(int32_t(listSegmentSize));
         }
 
         VertexDataBuffer& operator=(const VertexDataBuffer& other) {
@@ -100,13 +104,56 @@ public:
         virtual AutoArray<GL_DATA_T>& Setup(void) = 0;
 
 
+        // Copy m_appData segment by segment into m_gfxData if its items are packed arrays of 
+        // COMPONENT_COUNT gfx data values. Returns false if the items have a different layout.
+        template <uint32_t COMPONENT_COUNT>
+        inline bool PackAppData(void) {
+            if constexpr (std::is_trivially_copyable_v<APP_DATA_T> and (sizeof(APP_DATA_T) == COMPONENT_COUNT * sizeof(GL_DATA_T))) {
+                GL_DATA_T* glData = m_gfxData.Resize(m_appData.Length() * COMPONENT_COUNT);
+                m_appData.CopyTo(reinterpret_cast<APP_DATA_T*>(glData));
+                return true;
+            }
+            else
+                return false;
+        }
+
+
         inline void Reset(void) {
             m_appData.Clear();
-            m_gfxData.Reset();
+            if (m_directWrite)
+                m_gfxData.Clear(); // keep the capacity for the next rebuild
+            else
+                m_gfxData.Reset();
             m_isDirty = false;
         }
 
 
+        // Enable or disable direct write mode. Only possible while the buffer holds no application
+        // data and if the application data type is a packed array of m_componentCount gfx values.
+        inline bool SetDirectWrite(bool directWrite) noexcept {
+            if (directWrite) {
+                if constexpr (not std::is_trivially_copyable_v<APP_DATA_T>)
+                    return false;
+                if ((sizeof(APP_DATA_T) != m_componentCount * sizeof(GL_DATA_T)) or HaveAppData())
+                    return false;
+            }
+            m_directWrite = directWrite;
+            return true;
+        }
+
+        inline bool IsDirectWrite(void) const noexcept {
+            return m_directWrite;
+        }
+
+        // size hint for the number of items that will be appended
+        inline void Reserve(int32_t itemCount) {
+            if (m_directWrite)
+                m_gfxData.Reserve(itemCount * int32_t(m_componentCount));
+            else
+                m_appData.Reserve(itemCount);
+        }
+
+
         inline operator void*() {
             return (void*)m_gfxData.data();
         }
@@ -131,17 +178,42 @@ public:
             return m_gfxData.Length() * sizeof(GL_DATA_T);
         }
 
+        // number of items appended, regardless of where they are stored
         inline uint32_t AppDataLength(void) const noexcept {
-            return m_appData.Length();
+            return m_directWrite ? m_gfxData.Length() / m_componentCount : m_appData.Length();
         }
 
-        inline bool Append(APP_DATA_T data) {
+        inline bool Append(const APP_DATA_T& data) {
+            if (m_directWrite)
+                return AppendRange(std::span<const APP_DATA_T>(&data, 1));
             if (not m_appData.Append(data))
                 return false;
             m_isDirty = true;
             return true;
         }
 
+        bool AppendRange(std::span<const APP_DATA_T> data) {
+            if (data.empty())
+                return true;
+            if (m_directWrite) {
+                int32_t l = m_gfxData.Length();
+                GL_DATA_T* glData = m_gfxData.Resize(l + int32_t(data.size() * m_componentCount));
+                if (not glData)
+                    return false;
+                if constexpr (std::is_trivially_copyable_v<APP_DATA_T>)
+                    memcpy(glData + l, data.data(), data.size_bytes());
+            }
+            else {
+                m_appData.Reserve(m_appData.Length() + int32_t(data.size()));
+                for (const auto& d : data) {
+                    if (not m_appData.Append(d))
+                        return false;
+                }
+            }
+            m_isDirty = true;
+            return true;
+        }
+
         inline bool Append(const SegmentedList<APP_DATA_T>& data) {
             m_isDirty = true;
             m_appData += data;
@@ -149,6 +221,8 @@ public:
         }
 
         inline APP_DATA_T& operator[] (const int32_t i) {
+            if (m_directWrite)
+                return *reinterpret_cast<APP_DATA_T*>(m_gfxData.DataPtr(i * int32_t(m_componentCount)));
             return m_appData[i];
         }
 
@@ -169,7 +243,7 @@ public:
         }
 
 		inline bool IsEmpty(void) {
-			return m_appData.IsEmpty();
+			return m_directWrite ? not HaveGfxData() : m_appData.IsEmpty();
 		}
 
         inline void SetComponentCount(uint32_t componentCount) noexcept {
@@ -188,6 +262,7 @@ protected:
             m_gfxData = other.m_gfxData;
 			m_isDirty = other.m_isDirty;
             m_componentCount = other.m_componentCount;
+            m_directWrite = other.m_directWrite;
         }
         return *this;
     }
@@ -199,6 +274,7 @@ protected:
             m_gfxData = std::move(other.m_gfxData);
             m_isDirty = other.m_isDirty;
             m_componentCount = other.m_componentCount;
+            m_directWrite = other.m_directWrite;
             other.m_componentCount = 0;
         }
         return *this;
@@ -231,7 +307,7 @@ class VertexBuffer
 
         // Create a densely packed numpy array from the vertex data
         virtual AutoArray<float>& Setup(void) {
-            if (HaveAppData()) {
+            if (HaveAppData() and not PackAppData<3>()) {
                 m_gfxData.Resize(m_appData.Length() * 3);
                 float* glData = m_gfxData.DataPtr();
                 for (auto& v : m_appData) {
@@ -256,7 +332,7 @@ public:
 
         // Create a densely packed numpy array from the vertex data
         virtual AutoArray<float>& Setup(void) {
-            if (HaveAppData()) {
+            if (HaveAppData() and not PackAppData<2>()) {
                 float* glData = m_gfxData.Resize(m_appData.Length() * 2);
                 for (auto& v : m_appData) {
                     memcpy(glData, v.Data(), v.DataSize());
@@ -281,7 +357,7 @@ public:
 
     // Create a densely packed numpy array from the vertex data
     virtual AutoArray<float>& Setup(void) {
-        if (HaveAppData()) {
+        if (HaveAppData() and not PackAppData<4>()) {
             m_gfxData.Resize(m_appData.Length() * 4);
             float* glData = m_gfxData.DataPtr();
             for (auto& v : m_appData) {
@@ -306,7 +382,7 @@ public:
 
     // Create a densely packed numpy array from the vertex data
     virtual AutoArray<float>& Setup(void) {
-        if (HaveAppData()) {
+        if (HaveAppData() and not PackAppData<4>()) {
             float* glData = m_gfxData.Resize(m_appData.Length() * 4);
             for (auto& v : m_appData) {
                 memcpy(glData, v.Data(), v.DataSize());
@@ -363,9 +439,13 @@ public:
     // Create a densely packed numpy array from the vertex data
     virtual AutoArray<float>& Setup(void) {
         if (HaveAppData()) {
-            float* glData = m_gfxData.Resize(m_appData.Length() * m_componentCount);
-            for (auto& v : m_appData) {
-                *glData++ = v;
+            if (m_componentCount == 1)
+                PackAppData<1>();
+            else {
+                float* glData = m_gfxData.Resize(m_appData.Length() * m_componentCount);
+                for (auto& v : m_appData) {
+                    *glData++ = v;
+                }
             }
         }
         return m_gfxData;
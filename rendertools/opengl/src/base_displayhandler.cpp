@@ -11,6 +11,7 @@
 
 #include "base_displayhandler.h"
 #include "gfxstates.h"
+#include "framearena.h"
 
 // =================================================================================================
 
@@ -176,6 +177,7 @@ void BaseDisplayHandler::EndFrame(void) {
 
 void BaseDisplayHandler::BeginFrame(void) {
     ZoneScoped;
+    frameArena.BeginFrame();
 }
 
 
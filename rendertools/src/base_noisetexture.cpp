@@ -18,6 +18,7 @@
                                    // instance that BaseCloudNoiseTexture::Compute uses to source the
                                    // intermediate RGBA cloud noise.
 #include "conversions.hpp"
+#include "jobsystem.h"
 
 #pragma warning(push)
 #pragma warning(disable:26819)
@@ -372,17 +373,20 @@ void BaseCloudNoiseTexture::ApplyInfiniteWarp(void) {
     std::memcpy(raw.DataPtr(), m_data.DataPtr(), size_t(totalVoxels) * sizeof(float));
 
     const float* src = raw.DataPtr();
-    float* dst = m_data.DataPtr();
+    float* data = m_data.DataPtr();
     const float invSize = 1.0f / float(m_gridSize);
+    const int gridSize = m_gridSize;
 
-    for (int z = 0; z < m_gridSize; ++z) {
+    // z slices are independent: bake them in parallel
+    jobSystem.ParallelFor(0, gridSize, 1, [=](int32_t z) {
+        float* dst = data + size_t(z) * size_t(gridSize) * size_t(gridSize);
         float pz = (float(z) + 0.5f) * invSize;
-        for (int y = 0; y < m_gridSize; ++y) {
+        for (int y = 0; y < gridSize; ++y) {
             float py = (float(y) + 0.5f) * invSize;
-            for (int x = 0; x < m_gridSize; ++x) {
+            for (int x = 0; x < gridSize; ++x) {
                 float px = (float(x) + 0.5f) * invSize;
 
-                float n = TrilinearSampleWrap(src, m_gridSize, px * 0.3f, py * 0.3f, pz * 0.3f);
+                float n = TrilinearSampleWrap(src, gridSize, px * 0.3f, py * 0.3f, pz * 0.3f);
                 float localWarp = WarpStrength * (0.5f + n);
 
                 float wx = px + 0.37f * pz;
@@ -391,10 +395,10 @@ void BaseCloudNoiseTexture::ApplyInfiniteWarp(void) {
                 float warpedY = py;
                 float warpedZ = pz + localWarp * (wz - pz);
 
-                *dst++ = TrilinearSampleWrap(src, m_gridSize, warpedX, warpedY, warpedZ);
+                *dst++ = TrilinearSampleWrap(src, gridSize, warpedX, warpedY, warpedZ);
             }
         }
-    }
+    });
 }
 
 
@@ -411,17 +415,19 @@ void BaseCloudNoiseTexture::ApplyPeriodicWarp(void) {
     std::memcpy(raw.DataPtr(), m_data.DataPtr(), size_t(totalVoxels) * sizeof(float));
 
     const float* src = raw.DataPtr();
-    float* dst = m_data.DataPtr();
+    float* data = m_data.DataPtr();
     const float invSize = 1.0f / float(m_gridSize);
+    const int gridSize = m_gridSize;
 
-    for (int z = 0; z < m_gridSize; ++z) {
+    jobSystem.ParallelFor(0, gridSize, 1, [=](int32_t z) {
+        float* dst = data + size_t(z) * size_t(gridSize) * size_t(gridSize);
         float pz = (float(z) + 0.5f) * invSize;
-        for (int y = 0; y < m_gridSize; ++y) {
+        for (int y = 0; y < gridSize; ++y) {
             float py = (float(y) + 0.5f) * invSize;
-            for (int x = 0; x < m_gridSize; ++x) {
+            for (int x = 0; x < gridSize; ++x) {
                 float px = (float(x) + 0.5f) * invSize;
 
-                float n = TrilinearSampleWrap(src, m_gridSize, px * 0.3f, py * 0.3f, pz * 0.3f);
+                float n = TrilinearSampleWrap(src, gridSize, px * 0.3f, py * 0.3f, pz * 0.3f);
                 float localWarp = WarpStrength * (0.5f + n);
 
                 float wx = px + 0.37f * std::sin(kTwoPi * pz) * kInvTwoPi;
@@ -430,10 +436,10 @@ void BaseCloudNoiseTexture::ApplyPeriodicWarp(void) {
                 float warpedY = py;
                 float warpedZ = pz + localWarp * (wz - pz);
 
-                *dst++ = TrilinearSampleWrap(src, m_gridSize, warpedX, warpedY, warpedZ);
+                *dst++ = TrilinearSampleWrap(src, gridSize, warpedX, warpedY, warpedZ);
             }
         }
-    }
+    });
 }
 
 
@@ -97,7 +97,7 @@ bool BaseQuad::Setup(std::initializer_list<Vector3f> vertices, std::initializer_
         return c.size() == il.size() && std::equal(c.begin(), c.end(), il.begin());
         };
 
-    if (vertices.size() and not equals(m_vertices.AppData().StdList(), vertices)) {
+    if (vertices.size() and not equals(m_vertices.AppData(), vertices)) {
         CoplanarRectangle::Init(vertices);
         m_vertices.AppData() = vertices;
         m_vertices.SetDirty(true);
@@ -105,7 +105,7 @@ bool BaseQuad::Setup(std::initializer_list<Vector3f> vertices, std::initializer_
 
     if (texCoords.size() == 0)
         texCoords = defaultTexCoords[tcRegular];
-    if (not equals(m_texCoords[0].AppData().StdList(), texCoords)) {
+    if (not equals(m_texCoords[0].AppData(), texCoords)) {
         m_texCoords[0].AppData() = texCoords;
         //m_texCoords.Setup();
         m_texCoords[0].SetDirty(true);
@@ -47,21 +47,21 @@ void BaseShaderHandler::ComputeGaussKernels(void) {
 
 
 Shader* BaseShaderHandler::SelectShader(Texture* texture) {
-    String shaderId = "";
-    if (not texture)
-        shaderId = "color";
+    static const StringId colorShaderId("color");
+    static const StringId cubemapShaderId("cubemap");
+    static const StringId textureShaderId("texture");
     // select shader depending on texture type
-    else if (texture->GetTextureType() == TextureType::CubeMap)
-        shaderId = "cubemap";
-    else if (texture->GetTextureType() == TextureType::Texture2D)
-        shaderId = "texture";
-    else
-        return nullptr;
-    return SetupRenderShader(shaderId);
+    if (not texture)
+        return SetupRenderShader(colorShaderId);
+    if (texture->GetTextureType() == TextureType::CubeMap)
+        return SetupRenderShader(cubemapShaderId);
+    if (texture->GetTextureType() == TextureType::Texture2D)
+        return SetupRenderShader(textureShaderId);
+    return nullptr;
 }
 
 
-Shader* BaseShaderHandler::SetupRenderShader(String shaderId, String depthShaderId) {
+Shader* BaseShaderHandler::SetupRenderShader(StringId shaderId, StringId depthShaderId) {
     Shader* shader;
     if (baseRenderer.IsShadowPass())
         shaderId = depthShaderId; // override all shaders with simplest possible shader during depth pass
@@ -78,7 +78,7 @@ Shader* BaseShaderHandler::SetupRenderShader(String shaderId, String depthShader
             return nullptr;
         if (not shader->IsValid()) {
 #ifdef _DEBUG
-            fprintf(stderr, "*** shader'%s' is not available\r\n", (char*)shaderId);
+            fprintf(stderr, "*** shader'%s' is not available\r\n", shaderId.CStr());
 #endif
             return nullptr;
         }
@@ -97,7 +97,7 @@ void BaseShaderHandler::StopShader(bool needLegacyMatrices) {
     if (ShaderIsActive()) {
         m_activeShader->Deactivate();
         m_activeShader = nullptr;
-        m_activeShaderId = "";
+        m_activeShaderId = StringId();
 #if 1
         if (needLegacyMatrices)
             baseRenderer.UpdateLegacyMatrices();
@@ -107,7 +107,8 @@ void BaseShaderHandler::StopShader(bool needLegacyMatrices) {
 
 
 Shader* BaseShaderHandler::LoadLineShader(const RGBAColor& color, const Vector2f& start, const Vector2f& end, float strength, bool antialias) {
-    Shader* shader = SetupRenderShader("lineShader");
+    static const StringId shaderId("lineShader");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         shader->SetVector4f("surfaceColor", color);
         if (not baseRenderer.IsShadowPass()) {
@@ -123,7 +124,8 @@ Shader* BaseShaderHandler::LoadLineShader(const RGBAColor& color, const Vector2f
 
 
 Shader* BaseShaderHandler::LoadRingShader(const RGBAColor& color, const Vector2f& center, float radius, float strength, float startAngle, float endAngle, bool antialias) {
-    Shader* shader = SetupRenderShader("ringShader");
+    static const StringId shaderId("ringShader");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         shader->SetVector4f("surfaceColor", color);
         if (not baseRenderer.IsShadowPass()) {
@@ -141,7 +143,8 @@ Shader* BaseShaderHandler::LoadRingShader(const RGBAColor& color, const Vector2f
 
 
 Shader* BaseShaderHandler::LoadCircleShader(const RGBAColor& color, const Vector2f& center, float radius, float fillLevel, float brightness, bool antialias) {
-    Shader* shader = SetupRenderShader("circleShader");
+    static const StringId shaderId("circleShader");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         shader->SetVector4f("surfaceColor", color);
         if (not baseRenderer.IsShadowPass()) {
@@ -158,7 +161,8 @@ Shader* BaseShaderHandler::LoadCircleShader(const RGBAColor& color, const Vector
 
 
 Shader* BaseShaderHandler::LoadRectangleShader(const RGBAColor& color, const Vector2f& center, float width, float height, float strength, float radius, bool antialias) {
-    Shader* shader = SetupRenderShader("rectangleShader");
+    static const StringId shaderId("rectangleShader");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         shader->SetVector4f("surfaceColor", color);
         if (not baseRenderer.IsShadowPass()) {
@@ -175,7 +179,8 @@ Shader* BaseShaderHandler::LoadRectangleShader(const RGBAColor& color, const Vec
 
 
 Shader* BaseShaderHandler::LoadShadedRectangleShader(const RGBAColor& color, const Vector2f& center, float width, float height, float strength, float radius, float innerAlpha, float outerAlpha, float innerColor, float outerColor, bool antialias) {
-    Shader* shader = SetupRenderShader("shadedRectangleShader");
+    static const StringId shaderId("shadedRectangleShader");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         shader->SetVector4f("surfaceColor", color);
         if (not baseRenderer.IsShadowPass()) {
@@ -196,7 +201,8 @@ Shader* BaseShaderHandler::LoadShadedRectangleShader(const RGBAColor& color, con
 
 
 Shader* BaseShaderHandler::LoadShadedRingShader(const RGBAColor& color, const Vector2f& center, float radius, float strength, float startAngle, float endAngle, float innerAlpha, float outerAlpha, float innerColor, float outerColor, bool antialias) {
-    Shader* shader = SetupRenderShader("shadedRingShader");
+    static const StringId shaderId("shadedRingShader");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         shader->SetVector4f("surfaceColor", color);
         if (not baseRenderer.IsShadowPass()) {
@@ -218,7 +224,8 @@ Shader* BaseShaderHandler::LoadShadedRingShader(const RGBAColor& color, const Ve
 
 
 Shader* BaseShaderHandler::LoadCircleMaskShader(const RGBAColor& color, const RGBAColor& maskColor, const Vector2f& center, float radius, float maskScale, bool antialias) {
-    Shader* shader = SetupRenderShader("circleMaskShader");
+    static const StringId shaderId("circleMaskShader");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         if (baseRenderer.UsesOpenGL())
             shader->SetInt("surface", 0);
@@ -237,7 +244,8 @@ Shader* BaseShaderHandler::LoadCircleMaskShader(const RGBAColor& color, const RG
 
 
 Shader* BaseShaderHandler::LoadPlainColorShader(const RGBAColor& color, bool premultiply) {
-    Shader* shader = SetupRenderShader("plainColor");
+    static const StringId shaderId("plainColor");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         shader->SetVector4f("surfaceColor", premultiply ? color.Premultiplied() : color);
     }
@@ -246,7 +254,8 @@ Shader* BaseShaderHandler::LoadPlainColorShader(const RGBAColor& color, bool pre
 
 
 Shader* BaseShaderHandler::LoadColorMeshShader(bool premultiply) {
-    Shader* shader = SetupRenderShader("colorMesh");
+    static const StringId shaderId("colorMesh");
+    Shader* shader = SetupRenderShader(shaderId);
 #if 0
     if (shader) {
         shader->SetInt("premultiply", premultiply ? 1 : 0);
@@ -257,7 +266,8 @@ Shader* BaseShaderHandler::LoadColorMeshShader(bool premultiply) {
 
 
 Shader* BaseShaderHandler::LoadPlainTextureShader(const RGBAColor& color, bool flipVertically, const Vector2f& tcOffset, const Vector2f& tcScale, bool premultiply) {
-    Shader* shader = SetupRenderShader("plainTexture");
+    static const StringId shaderId("plainTexture");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         shader->SetVector4f("surfaceColor", color);
         if (not baseRenderer.IsShadowPass()) {
@@ -270,7 +280,8 @@ Shader* BaseShaderHandler::LoadPlainTextureShader(const RGBAColor& color, bool f
 
 
 Shader* BaseShaderHandler::LoadBlurTextureShader(const RGBAColor& color, const GaussBlurParams& blur, bool premultiply) {
-    Shader* shader = SetupRenderShader("blurTexture");
+    static const StringId shaderId("blurTexture");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         if (baseRenderer.UsesOpenGL())
             shader->SetInt("surface", 0);
@@ -285,7 +296,8 @@ Shader* BaseShaderHandler::LoadBlurTextureShader(const RGBAColor& color, const G
 
 
 Shader* BaseShaderHandler::LoadGrayscaleShader(float brightness, bool invert, const Vector2f& tcOffset, const Vector2f& tcScale) {
-    Shader* shader = SetupRenderShader("grayScale");
+    static const StringId shaderId("grayScale");
+    Shader* shader = SetupRenderShader(shaderId);
     if (shader) {
         if (baseRenderer.IsShadowPass())
             shader->SetVector4f("surfaceColor", ColorData::White);
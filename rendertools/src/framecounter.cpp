@@ -17,13 +17,18 @@ void BaseFrameCounter::Draw(bool update) {
         m_fps = GetFps();
     if (m_showFps) {
         baseRenderer.SetViewport(m_viewport);
-        char s[20];
-		sprintf(s, "%7.1f fps", m_fps);
+        char s[80];
+        Format(s, sizeof(s));
         textRenderer.SetColor(m_color);
         textRenderer.Render(String(s), TextRenderer::taLeft, true, 0, 0, false);
     }
 }
 
+
+void BaseFrameCounter::Format(char* text, size_t size) const {
+    snprintf(text, size, "%7.1f fps", m_fps);
+}
+
 // -------------------------------------------------------------------------------------------------
 
 float MovingFrameCounter::GetFps(void) const {
@@ -32,10 +37,22 @@ float MovingFrameCounter::GetFps(void) const {
 
 // -------------------------------------------------------------------------------------------------
 
+void MovingFrameCounter::Format(char* text, size_t size) const {
+    if (not m_pacer) {
+        BaseFrameCounter::Format(text, size);
+        return;
+    }
+    // wake error of the frame pacer: mean / 99th percentile
+    FramePacer::Statistics stats = m_pacer->GetStatistics();
+    snprintf(text, size, "%7.1f fps %4.0f/%4.0f us %lld missed", m_fps, stats.meanError, stats.p99Error, (long long)stats.missed);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 bool MovingFrameCounter::Start(void) {
     if (not BaseFrameCounter::Start())
         return false;
-    m_frequency = SDL_GetPerformanceFrequency();
+    m_frequency = uint64_t(Clock::nanosPerSecond);
     return true;
 }
     
@@ -52,7 +69,7 @@ void MovingFrameCounter::Reset(void) {
 // -------------------------------------------------------------------------------------------------
 
 void MovingFrameCounter::Update(void) {
-    uint64_t t = SDL_GetPerformanceCounter();
+    uint64_t t = uint64_t(Clock::Nanos());
     if (m_renderStartTime > 0) {
         uint64_t dt = t - m_renderStartTime;
         if (dt <= m_frequency) {
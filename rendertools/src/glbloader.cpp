@@ -27,34 +27,6 @@
 
 // =================================================================================================
 
-static Vector3f TransformPosition(Matrix4f m, Vector3f p) {
-    Vector4f h(p.x, p.y, p.z, 1.0f);
-    Vector4f r = m * h;
-    return Vector3f(r.x, r.y, r.z);
-}
-
-static Vector3f TransformNormal(Matrix4f m, Vector3f n) {
-    glm::mat3 a = glm::transpose(glm::inverse(glm::mat3(m.m)));
-    glm::vec3 r = a * glm::vec3(n.x, n.y, n.z);
-    Vector3f out(r.x, r.y, r.z);
-    out.Normalize();
-    return out;
-}
-
-static Vector3f TransformDelta(Matrix4f m, Vector3f d) {
-    glm::mat3 a = glm::mat3(m.m);
-    glm::vec3 r = a * glm::vec3(d.x, d.y, d.z);
-    return Vector3f(r.x, r.y, r.z);
-}
-
-static Vector3f TransformNormalDelta(Matrix4f m, Vector3f d) {
-    glm::mat3 a = glm::transpose(glm::inverse(glm::mat3(m.m)));
-    glm::vec3 r = a * glm::vec3(d.x, d.y, d.z);
-    return Vector3f(r.x, r.y, r.z);
-}
-
-// -------------------------------------------------------------------------------------------------
-
 int GLBLoader::CompareVertices(void* context, const Vector3f& v1, const Vector3f& v2) {
     if (v1.X() < v2.X())
         return -1;
@@ -234,7 +206,7 @@ bool GLBLoader::AppendPrimitive(tinygltf::Primitive& prim, Matrix4f worldM) {
 
     ReserveOutput(in);
 
-    AutoArray<ShapeKeySet*> keyPtrs;
+    ShapeKeyPointers keyPtrs;
     BuildShapeKeyPointers(keyPtrs);
 
     if (not AppendTriangles(in, worldM, keyPtrs)) {
@@ -281,12 +253,11 @@ bool GLBLoader::LoadVertices(tinygltf::Primitive& prim, PrimitiveData& in) {
 // -------------------------------------------------------------------------------------------------
 
 void GLBLoader::WeldVertices(PrimitiveData& in) {
-    AVLTree<Vector3f, int32_t> vertexMap;
-    vertexMap.Clear();
+    int32_t vertexCount = in.baseVertices.Length();
+    AVLTree<Vector3f, int32_t> vertexMap(vertexCount);
     vertexMap.SetComparator(CompareVertices);
 
     AutoArray<int32_t> indexMap;
-    int32_t vertexCount = in.baseVertices.Length();
     indexMap.Resize(vertexCount);
 
     for (int32_t i = 0; i < vertexCount; ++i) {
@@ -620,29 +591,40 @@ void GLBLoader::ReserveOutput(const PrimitiveData& in) {
 
 // -------------------------------------------------------------------------------------------------
 
-void GLBLoader::BuildShapeKeyPointers(AutoArray<ShapeKeySet*>& keyPtrs) {
-    int32_t globalKeyCount = m_data.shapeKeys.Length();
-    keyPtrs.Resize(globalKeyCount);
+void GLBLoader::BuildShapeKeyPointers(ShapeKeyPointers& keyPtrs) {
+    keyPtrs.Clear();
+    keyPtrs.Reserve(m_data.shapeKeys.Length());
+    for (auto& sk : m_data.shapeKeys)
+        keyPtrs.Append(&sk);
+}
 
-    int32_t k = 0;
-    for (auto& sk : m_data.shapeKeys) {
-        keyPtrs[k] = &sk;
-        k += 1;
+// -------------------------------------------------------------------------------------------------
+
+// Moves the primitive's vertex data to world space in place. Each source vertex is transformed once
+// with the batch kernels instead of once per triangle corner referencing it.
+
+void GLBLoader::TransformPrimitive(PrimitiveData& in, const Matrix4f& worldM) {
+    TransformPoints(worldM, in.baseVertices.Span(), in.baseVertices.Span());
+    if (in.haveNormals)
+        TransformNormals(worldM, in.baseNormals.Span(), in.baseNormals.Span());
+    for (int32_t k = 0; k < in.targetCount; ++k) {
+        TransformVectors(worldM, in.morphVertices[k].Span(), in.morphVertices[k].Span());
+        TransformNormals(worldM, in.morphNormals[k].Span(), in.morphNormals[k].Span(), false);
     }
 }
 
 // -------------------------------------------------------------------------------------------------
 
-bool GLBLoader::AppendTriangles(PrimitiveData& in, Matrix4f worldM, AutoArray<ShapeKeySet*>& keyPtrs) {
+bool GLBLoader::AppendTriangles(PrimitiveData& in, Matrix4f worldM, ShapeKeyPointers& keyPtrs) {
     int32_t globalKeyCount = keyPtrs.Length();
 
+    TransformPrimitive(in, worldM);
     for (int32_t i = 0, t = 0; t < in.triCount; ++t, i += 3) {
         int32_t indices[3];
         Vector3f p[3];
         for (int32_t j = 0; j < 3; ++j) {
             indices[j] = int32_t(in.indices[i + j]);
             p[j] = in.baseVertices[indices[j]];
-			p[j] = TransformPosition(worldM, p[j]);
             if (m_fixModel) {
                 if (in.isHull and not m_hullVertexMap.Find(p[j]))
                     m_hullVertexMap.Insert(p[j], m_data.vertices.Length());
@@ -651,10 +633,8 @@ bool GLBLoader::AppendTriangles(PrimitiveData& in, Matrix4f worldM, AutoArray<Sh
             m_data.vertices.Append(p[j]);
             m_data.colors.Append(in.baseColor);
 
-            if (in.haveNormals) {
-                Vector3f n = TransformNormal(worldM, in.baseNormals[indices[j]]);
-                m_data.normals.Append(n);
-            }
+            if (in.haveNormals)
+                m_data.normals.Append(in.baseNormals[indices[j]]);
         }
 
         if (not in.haveNormals) {
@@ -668,8 +648,8 @@ bool GLBLoader::AppendTriangles(PrimitiveData& in, Matrix4f worldM, AutoArray<Sh
                 Vector3f d(0.0f, 0.0f, 0.0f);
                 Vector3f dn(0.0f, 0.0f, 0.0f);
                 if (k < in.targetCount) {
-                    d = TransformDelta(worldM, in.morphVertices[k][indices[j]]);
-                    dn = TransformNormalDelta(worldM, in.morphNormals[k][indices[j]]);
+                    d = in.morphVertices[k][indices[j]];
+                    dn = in.morphNormals[k][indices[j]];
                 }
                 keyPtrs[k]->deltas.Append(d);
                 keyPtrs[k]->normalDeltas.Append(dn);
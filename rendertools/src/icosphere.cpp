@@ -99,6 +99,7 @@ void TriangleIcoSphere::SubDivide(SegmentedList<VertexIndices>& faces) {
 #if !(USE_STD || USE_STD_MAP)
     indexLookup.SetComparator(IcoSphere::KeyCmp);
 #endif
+    indexLookup.Reserve(faces.Length() * 3 / 2); // each edge is shared by two faces
     for (auto& f : faces) {
         uint32_t i0 = AddVertexIndices(indexLookup, f[0], f[1]);
         uint32_t i1 = AddVertexIndices(indexLookup, f[1], f[2]);
@@ -228,6 +229,7 @@ void RectangleIcoSphere::SubDivide(SegmentedList<VertexIndices>& faces) {
 #if !(USE_STD || USE_STD_MAP)
     indexLookup.SetComparator(IcoSphere::KeyCmp);
 #endif
+    indexLookup.Reserve(faces.Length() * 2); // each edge is shared by two faces
     for (auto& f : faces) {
         uint32_t f0 = f[0];
         uint32_t f1 = f[1];
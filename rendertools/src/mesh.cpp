@@ -209,6 +209,27 @@ void Mesh::ResetGfxData(void) {
     m_normals.Reset();
 }
 
+void Mesh::SetDirectWrite(bool directWrite) {
+    m_vertices.SetDirectWrite(directWrite);
+    m_normals.SetDirectWrite(directWrite);
+    for (auto& tc : m_texCoords)
+        tc.SetDirectWrite(directWrite);
+    m_vertexColors.SetDirectWrite(directWrite);
+}
+
+void Mesh::Reserve(int32_t vertexCount, uint32_t bufferMask) {
+    if (bufferMask & mbVertex)
+        m_vertices.Reserve(vertexCount);
+    if (bufferMask & mbNormal)
+        m_normals.Reserve(vertexCount);
+    for (int i = 0; i < 3; ++i) {
+        if (bufferMask & (uint32_t(mbTexCoord0) << i))
+            m_texCoords[i].Reserve(vertexCount);
+    }
+    if (bufferMask & mbColor)
+        m_vertexColors.Reserve(vertexCount);
+}
+
 void Mesh::SetupTexture(Texture* texture, String textureFolder, List<String> textureNames, TextureType textureType) {
     if (not textureNames.IsEmpty())
         m_textures += textureHandler.CreateByType(textureFolder, textureNames, textureType, {});
@@ -47,7 +47,8 @@ void PrerenderedItem::RenderBevel(int bevelWidth, const Vector2f& lightDir, floa
         return;
     m_renderTarget.Activate({ .clear = false });
     baseRenderer.Set2DRenderStates();
-    Shader* shader = baseShaderHandler.SetupRenderShader("bevel");
+    static const StringId shaderId("bevel");
+    Shader* shader = baseShaderHandler.SetupRenderShader(shaderId);
     if (shader and not baseRenderer.IsShadowPass()) {
         if (baseRenderer.UsesOpenGL())
             shader->SetInt("surface", 0);
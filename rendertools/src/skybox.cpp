@@ -96,7 +96,8 @@ bool Skybox::Setup(const String& textureFolder, CloudNoiseTexture* noiseTexture,
 
 
 Shader* Skybox::LoadBlackholeShader(Matrix4f& view, Vector3f lightDirection, float brightness, float alpha, int32_t currentTime) {
-	Shader* shader = baseShaderHandler.SetupRenderShader("blackhole");
+	static const StringId shaderId("blackhole");
+	Shader* shader = baseShaderHandler.SetupRenderShader(shaderId);
 	if (shader) {
 		shader->SetMatrix4f("mView", view.AsArray(), false);
 		if (baseRenderer.UsesOpenGL()) {
@@ -129,7 +130,8 @@ Shader* Skybox::LoadBlackholeShader(Matrix4f& view, Vector3f lightDirection, flo
 
 
 Shader* Skybox::LoadShader(Matrix4f& view, Vector3f lightDirection, float brightness, float alpha, int32_t currentTime) {
-	Shader* shader = baseShaderHandler.SetupRenderShader("skybox");
+	static const StringId shaderId("skybox");
+	Shader* shader = baseShaderHandler.SetupRenderShader(shaderId);
 	if (shader) {
 		shader->SetMatrix4f("mView", view.AsArray(), false);
 		StaticArray<String, 3> skyNames = { "sky1", "sky2", "sky3" };
@@ -31,7 +31,8 @@ void TextEffects::AntiAlias(RenderTarget* renderTarget, const AAMethod& aaMethod
         params.shader->SetFloat("offset", 0.0f);
         //params.shader->SetFloat("premultiply", premultiply ? 1.0f : 0.0f);
         params.shader->SetVector2f("texelSize", baseRenderer.TexelSize());
-        if (aaMethod.method != "gaussblur") {
+        static const StringId gaussBlurId("gaussblur");
+        if (aaMethod.method != gaussBlurId) {
             params.destination = renderTarget->NextBuffer(params.source);
             renderTarget->AutoRender(params);
         }
@@ -58,7 +59,8 @@ void TextEffects::AntiAlias(RenderTarget* renderTarget, const AAMethod& aaMethod
 void TextEffects::RenderOutline(RenderTarget* renderTarget, const Decoration& decoration, bool premultiply) {
     if (decoration.HaveOutline()) {
         baseRenderer.Set2DRenderStates();
-        Shader* shader = baseShaderHandler.SetupRenderShader("outline");
+        static const StringId shaderId("outline");
+        Shader* shader = baseShaderHandler.SetupRenderShader(shaderId);
         if (shader and not baseRenderer.IsShadowPass()) {
             if (baseRenderer.UsesOpenGL())
                 shader->SetInt("surface", 0);
@@ -0,0 +1,159 @@
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include "vertexdatabuffers.h"
+#include "clock.h"
+
+// =================================================================================================
+// Text mesh build benchmark (make bench): builds the glyph quads of TextRenderer::RenderTextMesh()
+// for a set of sample strings once through the application data lists (one Append() per vertex and
+// texture coordinate, converted by Setup(); the path used before direct write mode) and once in
+// direct write mode (SetDirectWrite(), Reserve() and one AppendRange() per quad), like the shared
+// mesh of the MeshHandler is rebuilt for every string. The glyph metrics are synthetic, so no font or
+// graphics context is needed. Both paths must produce the same gfx data.
+// usage: textmeshbench [rounds over the sample strings]
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        ++failures; \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+    }
+
+
+static const char* sampleTexts[] = {
+    "0",
+    "FPS 60.0",
+    "Score: 1234567",
+    "Player 3 has left the game",
+    "Press [SPACE] to continue, [ESC] to return to the main menu",
+    "The quick brown fox jumps over the lazy dog. THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG! 0123456789 +-*/=()[]{}<>",
+};
+
+// placement of a glyph in the font atlas
+struct GlyphInfo {
+    float   width;      // glyph width in pixels
+    float   atlasX, atlasY, atlasW, atlasH;
+};
+
+static GlyphInfo glyphInfos[128];
+
+static constexpr float inkTop = 0.125f;    // fractions of the glyph cell height, see FontHandler
+static constexpr float inkHeight = 0.75f;
+
+
+static void CreateGlyphInfos(void) {
+    for (int i = 0; i < 128; ++i) {
+        float w = float(8 + (i * 7) % 9);
+        glyphInfos[i] = GlyphInfo{ w, float(i % 16) / 16.0f, float(i / 16) / 8.0f, w / 256.0f, 1.0f / 8.0f };
+    }
+}
+
+
+struct TextMesh {
+    VertexBuffer    vertices;
+    TexCoordBuffer  texCoords;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+template <bool DIRECT_WRITE>
+static void BuildTextMesh(TextMesh& mesh, const char* text, float x, float y, float scale) {
+    mesh.vertices.Reset();
+    mesh.texCoords.Reset();
+    if constexpr (DIRECT_WRITE) {
+        mesh.vertices.SetDirectWrite(true);
+        mesh.texCoords.SetDirectWrite(true);
+        int32_t vertexCount = int32_t(strlen(text)) * 4;
+        mesh.vertices.Reserve(vertexCount);
+        mesh.texCoords.Reserve(vertexCount);
+    }
+    Vector3f vertices[4];
+    TexCoord texCoords[4];
+    for (const char* c = text; *c; ++c) {
+        const GlyphInfo& info = glyphInfos[*c & 127];
+        float w = info.width * scale;
+        float atlasTop = info.atlasY + inkTop * info.atlasH;
+        float atlasBottom = atlasTop + inkHeight * info.atlasH;
+        float atlasRight = info.atlasX + info.atlasW;
+        vertices[0] = Vector3f{ x, y, 0.0f };
+        vertices[1] = Vector3f{ x + w, y, 0.0f };
+        vertices[2] = Vector3f{ x + w, -y, 0.0f };
+        vertices[3] = Vector3f{ x, -y, 0.0f };
+        texCoords[0] = TexCoord{ info.atlasX, atlasTop };
+        texCoords[1] = TexCoord{ atlasRight, atlasTop };
+        texCoords[2] = TexCoord{ atlasRight, atlasBottom };
+        texCoords[3] = TexCoord{ info.atlasX, atlasBottom };
+        if constexpr (DIRECT_WRITE) {
+            mesh.vertices.AppendRange(vertices);
+            mesh.texCoords.AppendRange(texCoords);
+        }
+        else {
+            for (int i = 0; i < 4; ++i) {
+                mesh.vertices.Append(vertices[i]);
+                mesh.texCoords.Append(texCoords[i]);
+            }
+        }
+        x += w;
+    }
+    // Mesh::UpdateData()
+    mesh.vertices.Setup();
+    mesh.texCoords.Setup();
+}
+
+
+// Returns the best time in nanoseconds for building the meshes of all sample strings once.
+template <bool DIRECT_WRITE>
+static double Measure(TextMesh& mesh, int rounds) {
+    double best = 1e30;
+    for (int r = 0; r < rounds; ++r) {
+        int64_t t = Clock::Nanos();
+        for (const char* text : sampleTexts)
+            BuildTextMesh<DIRECT_WRITE>(mesh, text, -0.5f, 0.05f, 0.002f);
+        best = std::min(best, double(Clock::Nanos() - t));
+    }
+    return best;
+}
+
+
+template <typename DATA_T>
+static bool HaveSameData(AutoArray<DATA_T>& a1, AutoArray<DATA_T>& a2) {
+    return (a1.Length() == a2.Length()) and ((a1.Length() == 0) or (memcmp(a1.DataPtr(), a2.DataPtr(), size_t(a1.Length()) * sizeof(DATA_T)) == 0));
+}
+
+// =================================================================================================
+
+int main(int argc, char** argv) {
+    int rounds = (argc > 1) ? atoi(argv[1]) : 20000;
+    if (rounds < 1) {
+        fprintf(stderr, "usage: textmeshbench [rounds >= 1]\n");
+        return EXIT_FAILURE;
+    }
+    CreateGlyphInfos();
+    TextMesh listMesh, directMesh;
+    int glyphCount = 0;
+    for (const char* text : sampleTexts) {
+        BuildTextMesh<false>(listMesh, text, -0.5f, 0.05f, 0.002f);
+        BuildTextMesh<true>(directMesh, text, -0.5f, 0.05f, 0.002f);
+        int32_t length = int32_t(strlen(text));
+        CHECK(int32_t(listMesh.vertices.GfxData().Length()) == length * 12);
+        CHECK(HaveSameData(listMesh.vertices.GfxData(), directMesh.vertices.GfxData()));
+        CHECK(HaveSameData(listMesh.texCoords.GfxData(), directMesh.texCoords.GfxData()));
+        glyphCount += length;
+    }
+    if (failures) {
+        fprintf(stderr, "Text mesh benchmark: %d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    int stringCount = int(sizeof(sampleTexts) / sizeof(sampleTexts[0]));
+    double listTime = Measure<false>(listMesh, rounds);
+    double directTime = Measure<true>(directMesh, rounds);
+    printf("text mesh build, %d strings with %d glyphs (best of %d rounds)\n", stringCount, glyphCount, rounds);
+    printf("  list path:    %8.1f ns per string, %6.1f ns per glyph\n", listTime / stringCount, listTime / glyphCount);
+    printf("  direct write: %8.1f ns per string, %6.1f ns per glyph (%.2fx)\n", directTime / stringCount, directTime / glyphCount, listTime / directTime);
+    return EXIT_SUCCESS;
+}
@@ -59,21 +59,24 @@ void TextRenderer::RenderTextMesh(String& text, float x, float y, float scale, b
     if (flipVertically)
         y = -y;
 
-    Mesh* mesh = meshHandler.AllocMesh(Mesh::mbIndex | Mesh::mbVertex | Mesh::mbTexCoord0);
+    constexpr uint32_t meshBuffers = Mesh::mbIndex | Mesh::mbVertex | Mesh::mbTexCoord0;
+    Mesh* mesh = meshHandler.AllocMesh(meshBuffers);
+    // the text mesh is rebuilt for every string: write the quads straight into the gfx data arrays
+    mesh->SetDirectWrite(true);
+    mesh->Reserve(text.Length() * 4, meshBuffers);
+    Vector3f vertices[4];
+    TexCoord texCoords[4];
     for (auto glyph : text) {
         FontHandler::GlyphInfo* info = m_font->FindGlyph(String(glyph));
 
         if (info) {
             // create output quad coordinates
             float w = float(info->glyphSize.width) * scale;
-            Vector3f p{ x, y, 0.0f };
-            mesh->AddVertex(p);
-            p.X() += w;
-            mesh->AddVertex(p);
-            p.Y() = -y;
-            mesh->AddVertex(p);
-            p.X() = x;
-            mesh->AddVertex(p);
+            vertices[0] = Vector3f{ x, y, 0.0f };
+            vertices[1] = Vector3f{ x + w, y, 0.0f };
+            vertices[2] = Vector3f{ x + w, -y, 0.0f };
+            vertices[3] = Vector3f{ x, -y, 0.0f };
+            mesh->AddVertices(vertices);
             x += w;
 
             // create input tex coords of the glyph in the atlas; sample only the ink band so the font's
@@ -81,14 +84,12 @@ void TextRenderer::RenderTextMesh(String& text, float x, float y, float scale, b
             // are fractions of the glyph cell height (0 / 1 = full cell = no correction).
             float atlasTop = info->atlasPosition.Y() + m_font->InkTop() * info->atlasSize.Y();
             float atlasBottom = atlasTop + m_font->InkHeight() * info->atlasSize.Y();
-            TexCoord tc{ info->atlasPosition.X(), atlasTop };
-            mesh->AddTexCoord(tc);
-            tc.X() += info->atlasSize.X();
-            mesh->AddTexCoord(tc);
-            tc.Y() = atlasBottom;
-            mesh->AddTexCoord(tc);
-            tc.X() = info->atlasPosition.X();
-            mesh->AddTexCoord(tc);
+            float atlasRight = info->atlasPosition.X() + info->atlasSize.X();
+            texCoords[0] = TexCoord{ info->atlasPosition.X(), atlasTop };
+            texCoords[1] = TexCoord{ atlasRight, atlasTop };
+            texCoords[2] = TexCoord{ atlasRight, atlasBottom };
+            texCoords[3] = TexCoord{ info->atlasPosition.X(), atlasBottom };
+            mesh->AddTexCoords(texCoords);
         }
     }
     mesh->UpdateData(true);
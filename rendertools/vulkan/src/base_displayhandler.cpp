@@ -7,6 +7,7 @@
 #include "descriptor_pool_handler.h"
 #include "cbv_allocator.h"
 #include "resource_handler.h"
+#include "framearena.h"
 #include "tracy_wrapper.h"
 
 #pragma warning(push)
@@ -235,6 +236,7 @@ void BaseDisplayHandler::BeginFrame(void) {
     //gfxStates.CheckError();
     gfxResourceHandler.Cleanup(slot);
     //gfxStates.CheckError();
+    frameArena.BeginFrame();
     commandListHandler.ResetBindings();
     //gfxStates.CheckError();
     baseShaderHandler.InvalidateActiveShader();
@@ -4,6 +4,7 @@
 #include "cbv_allocator.h"
 #include "resource_handler.h"
 #include "gfxstates.h"
+#include "framearena.h"
 
 #include <cstdio>
 #include <cstring>
@@ -624,21 +625,26 @@ void CommandListHandler::ExecuteAll(bool intermediate) noexcept
     if (m_pendingLists.IsEmpty())
         return;
 
-    AutoArray<VkCommandBufferSubmitInfo> cbInfos(m_pendingLists.Length());
+    // per-frame temporary: taken from the frame arena instead of the heap
+    ArenaArray<VkCommandBufferSubmitInfo> cbInfos;
     int n = 0;
-    for (auto l : m_pendingLists) {
-        if (l->IsFlushed())
-            continue;
-        VkCommandBufferSubmitInfo info{};
-        info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-        info.commandBuffer = l->GfxList(true);
-        cbInfos[n++] = info;
+    if (not cbInfos.Resize(m_pendingLists.Length()))
+        fprintf(stderr, "CommandListHandler::ExecuteAll: out of frame arena memory\n");
+    else {
+        for (auto l : m_pendingLists) {
+            if (l->IsFlushed())
+                continue;
+            VkCommandBufferSubmitInfo info{};
+            info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+            info.commandBuffer = l->GfxList(true);
+            cbInfos[n++] = info;
+        }
     }
     if (n > 0) {
         VkSubmitInfo2 submit{};
         submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
         submit.commandBufferInfoCount = uint32_t(n);
-        submit.pCommandBufferInfos = cbInfos.Data();
+        submit.pCommandBufferInfos = cbInfos.DataPtr();
 
         VkSemaphoreSubmitInfo waitInfo{};
         VkSemaphoreSubmitInfo signalInfo{};
@@ -4,6 +4,7 @@
 #include "vkcontext.h"
 #include "image_layout_tracker.h"
 #include "resource_handler.h"
+#include "framearena.h"
 
 #include <algorithm>
 #include <cstdio>
@@ -754,7 +755,9 @@ void RenderTarget::Fill(RGBAColor color)
     if (cb == VK_NULL_HANDLE or m_colorBufferCount == 0)
         return;
 
-    AutoArray<VkClearAttachment> attachments(m_colorBufferCount);
+    ArenaArray<VkClearAttachment> attachments;
+    if (not attachments.Resize(m_colorBufferCount))
+        return;
     int n = 0;
     VkClearValue clearVal = MakeClearColor(color);
     for (int i = 0; i < m_colorBufferCount; ++i) {
@@ -768,7 +771,7 @@ void RenderTarget::Fill(RGBAColor color)
     rect.rect.offset = { 0, 0 };
     rect.rect.extent = { uint32_t(GetWidth(true)), uint32_t(GetHeight(true)) };
     rect.layerCount  = 1;
-    vkCmdClearAttachments(cb, uint32_t(n), attachments.Data(), 1, &rect);
+    vkCmdClearAttachments(cb, uint32_t(n), attachments.DataPtr(), 1, &rect);
 }
 
 
@@ -782,7 +785,9 @@ void RenderTarget::Clear(const RTActivationParams& params)
     if (cb == VK_NULL_HANDLE)
         return;
 
-    AutoArray<VkClearAttachment> atts(m_colorBufferCount + 1);
+    ArenaArray<VkClearAttachment> atts;
+    if (not atts.Resize(m_colorBufferCount + 1))
+        return;
     int n = 0;
     VkClearValue cv = MakeClearColor(m_clearColor);
     if (params.bufferIndex < 0) {
@@ -813,7 +818,7 @@ void RenderTarget::Clear(const RTActivationParams& params)
     rect.rect.offset = { 0, 0 };
     rect.rect.extent = { uint32_t(GetWidth(true)), uint32_t(GetHeight(true)) };
     rect.layerCount  = 1;
-    vkCmdClearAttachments(cb, uint32_t(n), atts.Data(), 1, &rect);
+    vkCmdClearAttachments(cb, uint32_t(n), atts.DataPtr(), 1, &rect);
 }
 
 
@@ -845,7 +850,9 @@ void RenderTarget::ClearColorBuffers(void)
     VkCommandBuffer cb = m_cmdList->GfxList();
     if (cb == VK_NULL_HANDLE or m_colorBufferCount == 0)
         return;
-    AutoArray<VkClearAttachment> atts(m_colorBufferCount);
+    ArenaArray<VkClearAttachment> atts;
+    if (not atts.Resize(m_colorBufferCount))
+        return;
     int n = 0;
     VkClearValue cv = MakeClearColor(m_clearColor);
     for (int i = 0; i < m_colorBufferCount; ++i) {
@@ -859,7 +866,7 @@ void RenderTarget::ClearColorBuffers(void)
     rect.rect.offset = { 0, 0 };
     rect.rect.extent = { uint32_t(GetWidth(true)), uint32_t(GetHeight(true)) };
     rect.layerCount  = 1;
-    vkCmdClearAttachments(cb, uint32_t(n), atts.Data(), 1, &rect);
+    vkCmdClearAttachments(cb, uint32_t(n), atts.DataPtr(), 1, &rect);
 }
 
 